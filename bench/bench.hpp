@@ -0,0 +1,81 @@
+#pragma once
+#include "core/core.hpp"
+
+// minimal benchmark registry: each bench is a function which runs whole case and reports its timings
+#define BENCH( name )                                                    \
+  static void             bench_##name();                                \
+  static bench::Registrar bench_registrar_##name( #name, bench_##name ); \
+  static void             bench_##name()
+
+namespace bench
+{
+  using BenchFunc = void ( * )();
+
+  struct Registrar
+  {
+    Registrar( const char* name, BenchFunc func );
+  };
+
+  struct Options
+  {
+    u32 warmups     = 3;  // runs which are not measured: caches, branch predictors, lazy allocations
+    u32 repetitions = 21; // measured runs, odd so median is one of them
+  };
+
+  const Options& getOptions();
+
+  class Timer
+  {
+    std::chrono::steady_clock::time_point start_ = std::chrono::steady_clock::now();
+
+  public:
+    f64 getMs() const
+    {
+      return std::chrono::duration<f64, std::milli>( std::chrono::steady_clock::now() - start_ ).count();
+    }
+
+    f64 getNs() const
+    {
+      return std::chrono::duration<f64, std::nano>( std::chrono::steady_clock::now() - start_ ).count();
+    }
+  };
+
+  // keeps computation which result is not used otherwise from being optimized away
+  template<typename T>
+  inline void doNotOptimize( const T& value )
+  {
+    asm volatile( "" : : "g"( &value ) : "memory" );
+  }
+
+  void report( const char* caseName, f64 ms );
+  void reportBytes( const char* caseName, u64 bytes );
+
+  // time of one operation in each measured run, reported as median and median absolute deviation. returns median
+  f64 reportSamples( const char* caseName, std::span<const f64> samplesNs );
+
+  // hard limit which request states for a case, run exits with error when median is above it
+  void checkLimit( const char* caseName, f64 medianNs, f64 limitNs );
+
+  // f does `items` operations per call. it is called warmup times, then repetitions times under timer.
+  // median and MAD are barely moved by outliers (preemption, page faults), so runs are comparable.
+  // returns median time of one operation
+  template<typename F>
+  f64 measure( const char* caseName, u64 items, F&& f )
+  {
+    const auto& options = getOptions();
+
+    for( u32 i = 0; i < options.warmups; ++i )
+      f();
+
+    auto samples = std::vector<f64>();
+    samples.reserve( options.repetitions );
+    for( u32 i = 0; i < options.repetitions; ++i )
+    {
+      auto timer = Timer();
+      f();
+      samples.push_back( timer.getNs() / static_cast<f64>( items ) );
+    }
+
+    return reportSamples( caseName, samples );
+  }
+} // namespace bench
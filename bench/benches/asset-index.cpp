@@ -0,0 +1,145 @@
+#include "bench.hpp"
+
+using namespace core;
+
+
+namespace
+{
+  constexpr u32 sChunkCount       = 256;
+  constexpr u32 sAssetsPerChunk   = 64;
+  constexpr u32 sEntityCount      = 20'000;
+  constexpr u32 sLookupIterations = 10;
+
+  struct FakeChunk
+  {
+    StringId                           id;
+    StringIdMap<core::render::Mesh>    meshes;
+    StringIdMap<core::render::Texture> textures;
+  };
+
+  StringId makeId( const char* kind, u32 chunk, u32 asset )
+  {
+    char buffer[64];
+    snprintf( buffer, sizeof( buffer ), "%s-%u-%u", kind, chunk, asset );
+    return StringId( buffer );
+  }
+
+  std::vector<FakeChunk> makeChunks()
+  {
+    auto chunks = std::vector<FakeChunk>( sChunkCount );
+
+    for( u32 c = 0; c < sChunkCount; ++c )
+    {
+      chunks[c].id = makeId( "chunk", c, 0 );
+      for( u32 a = 0; a < sAssetsPerChunk; ++a )
+      {
+        chunks[c].meshes.emplace_unique( makeId( "mesh", c, a ), core::render::Mesh() );
+        chunks[c].textures.emplace_unique( makeId( "texture", c, a ), core::render::Texture() );
+      }
+    }
+
+    return chunks;
+  }
+
+  // same as what findMesh did before asset index: probe every chunk of the scene
+  core::render::Mesh* findMeshLinear( std::vector<FakeChunk>& chunks, StringId id )
+  {
+    for( auto& chunk: chunks )
+      if( auto* mesh = chunk.meshes.try_get( id ) )
+        return mesh;
+    return nullptr;
+  }
+
+  core::render::Texture* findTextureLinear( std::vector<FakeChunk>& chunks, StringId id )
+  {
+    for( auto& chunk: chunks )
+      if( auto* texture = chunk.textures.try_get( id ) )
+        return texture;
+    return nullptr;
+  }
+} // namespace
+
+
+BENCH( asset_index_scene_init )
+{
+  auto chunks = makeChunks();
+
+  data::initializeAssetIndex();
+  for( auto& chunk: chunks )
+  {
+    for( auto& [id, mesh]: chunk.meshes )
+      data::registerMesh( id, chunk.id, &mesh );
+    for( auto& [id, texture]: chunk.textures )
+      data::registerTexture( id, chunk.id, &texture );
+  }
+
+  // entities reference assets spread over all chunks
+  auto entityAssets = std::vector<std::pair<StringId, StringId>>();
+  entityAssets.reserve( sEntityCount );
+  for( u32 i = 0; i < sEntityCount; ++i )
+  {
+    u32 chunk = ( i * 7919u ) % sChunkCount;
+    u32 asset = i % sAssetsPerChunk;
+    entityAssets.emplace_back( makeId( "mesh", chunk, asset ), makeId( "texture", chunk, asset ) );
+  }
+
+  {
+    auto timer = bench::Timer();
+    u64  found = 0;
+
+    for( u32 it = 0; it < sLookupIterations; ++it )
+      for( auto [meshId, textureId]: entityAssets )
+      {
+        found += findMeshLinear( chunks, meshId ) ? 1 : 0;
+        found += findTextureLinear( chunks, textureId ) ? 1 : 0;
+      }
+
+    bench::report( "linear chunk scan lookups (per scene)", timer.getMs() / sLookupIterations );
+    assert( found == 2ull * sEntityCount * sLookupIterations );
+    ( void ) found;
+  }
+
+  {
+    auto timer = bench::Timer();
+    u64  found = 0;
+
+    for( u32 it = 0; it < sLookupIterations; ++it )
+      for( auto [meshId, textureId]: entityAssets )
+      {
+        found += data::findMesh( meshId ).isResident() ? 1 : 0;
+        found += data::findTexture( textureId ).isResident() ? 1 : 0;
+      }
+
+    bench::report( "asset index lookups (per scene)", timer.getMs() / sLookupIterations );
+    assert( found == 2ull * sEntityCount * sLookupIterations );
+    ( void ) found;
+  }
+
+  {
+    auto timer = bench::Timer();
+    auto scene = Scene( StringId( "bench-scene" ) );
+
+    for( u32 i = 0; i < sEntityCount; ++i )
+    {
+      auto* entity = scene.addEntity( makeId( "entity", i, 0 ) );
+
+      entity->addComponent<logic::TransformComponent>();
+
+      auto* material                   = entity->addComponent<logic::MaterialComponent>();
+      material->props.textureDiffuseId = entityAssets[i].second;
+      material->props.blendMode        = render::BlendModeOpaque;
+
+      auto* renderMesh         = entity->addComponent<logic::RenderMeshComponent>();
+      renderMesh->props.meshId = entityAssets[i].first;
+    }
+    bench::report( "instantiate 20k entities", timer.getMs() );
+
+    auto initTimer = bench::Timer();
+    scene.init();
+    bench::report( "init 20k entities", initTimer.getMs() );
+
+    scene.shutdown();
+  }
+
+  data::destroyAssetIndex();
+}
@@ -0,0 +1,109 @@
+#include "bench.hpp"
+#include <latch>
+
+using namespace core;
+
+
+namespace
+{
+  constexpr u32 sFileCount = 500;
+  constexpr u32 sFileSize  = 64 * 1024; // about the size of small render chunk
+  constexpr u32 sRunCount  = 3;
+
+  std::vector<std::string> writeFiles( const stdfs::path& directory )
+  {
+    stdfs::remove_all( directory );
+    stdfs::create_directories( directory );
+
+    auto paths = std::vector<std::string>();
+    auto bytes = std::vector<byte>( sFileSize );
+    for( u32 i = 0; i < sFileCount; ++i )
+    {
+      std::ranges::fill( bytes, static_cast<byte>( i ) );
+      paths.push_back( ( directory / std::to_string( i ) ).string() );
+      auto status = fs::writeFile( paths.back(), bytes );
+      assert( status == StatusOk );
+      ( void ) status;
+    }
+
+    return paths;
+  }
+
+  // what chunk loading did before async io: every read is blocking fread in its own worker task
+  void readBlockingTasks( const std::vector<std::string>& paths )
+  {
+    auto done = std::latch( static_cast<std::ptrdiff_t>( paths.size() ) );
+    for( const auto& path: paths )
+    {
+      system::task::runAsync( [&path, &done]() {
+        auto bytes  = std::vector<byte>();
+        auto status = fs::readFile( path, bytes );
+        assert( status == StatusOk && bytes.size() == sFileSize );
+        ( void ) status;
+        done.count_down();
+      } );
+    }
+    done.wait();
+  }
+
+  void readAsyncBatch( const std::vector<std::string>& paths )
+  {
+    auto buffers  = std::vector<std::vector<byte>>( paths.size(), std::vector<byte>( sFileSize ) );
+    auto requests = std::vector<fs::ReadRequest>();
+    auto done     = std::latch( static_cast<std::ptrdiff_t>( paths.size() ) );
+
+    for( size_t i = 0; i < paths.size(); ++i )
+    {
+      requests.push_back( fs::ReadRequest{
+          .path       = paths[i],
+          .buffer     = buffers[i],
+          .offset     = 0,
+          .onComplete = [&done]( Status status, size_t bytesRead ) {
+            assert( status == StatusOk && bytesRead == sFileSize );
+            ( void ) status;
+            ( void ) bytesRead;
+            done.count_down();
+          },
+      } );
+    }
+
+    fs::submitReads( std::move( requests ) );
+    done.wait();
+  }
+
+  template<typename F>
+  f64 bestOf( F&& f )
+  {
+    f64 best = std::numeric_limits<f64>::max();
+    for( u32 i = 0; i < sRunCount; ++i )
+    {
+      auto timer = bench::Timer();
+      f();
+      best = std::min( best, timer.getMs() );
+    }
+    return best;
+  }
+} // namespace
+
+
+// files are in page cache after they are written, so this measures submission and completion overhead,
+// not disk. cold numbers need caches dropped between runs
+BENCH( async_io )
+{
+  auto status = system::task::init();
+  assert( status == StatusOk );
+  status = fs::initAsyncIo();
+  assert( status == StatusOk );
+  ( void ) status;
+
+  auto directory = stdfs::temp_directory_path() / "core-bench-async-io";
+  auto paths     = writeFiles( directory );
+
+  bench::report( "blocking reads, task per file", bestOf( [&paths]() { readBlockingTasks( paths ); } ) );
+  bench::report( fs::isAsyncIoUring() ? "async reads, io_uring batch" : "async reads, io threads batch",
+                 bestOf( [&paths]() { readAsyncBatch( paths ); } ) );
+
+  fs::destroyAsyncIo();
+  system::task::destroy();
+  stdfs::remove_all( directory );
+}
@@ -0,0 +1,128 @@
+#include "bench.hpp"
+#include <random>
+
+using namespace core;
+
+
+namespace
+{
+  constexpr u32 sMeshCount       = 512;
+  constexpr u32 sVerticesPerMesh = 8 * 1024;
+  constexpr u32 sTextureCount    = 64;
+  constexpr u32 sTextureBytes    = 512 * 1024; // 1024x1024 bc1 first mip
+
+  struct ChunkData
+  {
+    std::vector<data::schema::Mesh>    meshes;
+    std::vector<data::schema::Texture> textures;
+  };
+
+  // looks like real chunk for compressor: smooth vertex data, noisy block compressed texels
+  ChunkData makeChunk()
+  {
+    auto chunk = ChunkData();
+    auto rng   = std::mt19937( 42 );
+
+    for( u32 m = 0; m < sMeshCount; ++m )
+    {
+      auto& mesh = chunk.meshes.emplace_back();
+      mesh.id    = m;
+      for( u32 v = 0; v < sVerticesPerMesh; ++v )
+      {
+        f32 t = static_cast<f32>( v ) * 0.01f;
+        mesh.vertexBuffer.push_back( data::schema::VertexData{
+            .position = { std::sin( t ) * 10.f, std::cos( t ) * 10.f, t },
+            .normal   = { 0.f, 1.f, 0.f },
+            .uv       = { t, 1.f - t },
+        } );
+        mesh.indexBuffer.push_back( v );
+      }
+    }
+
+    for( u32 t = 0; t < sTextureCount; ++t )
+    {
+      auto& texture = chunk.textures.emplace_back();
+      texture.id    = t;
+      texture.width = texture.height = 1024;
+      texture.mipLevels = texture.arraySize = 1;
+
+      auto& mip         = texture.data.emplace_back();
+      mip.memPitch      = 2048;
+      mip.memSlicePitch = sTextureBytes;
+      mip.mem.resize( sTextureBytes );
+      for( size_t i = 0; i < mip.mem.size(); ++i )
+        mip.mem[i] = static_cast<byte>( ( i % 8 < 4 ) ? ( i / 4096 ) : rng() );
+    }
+
+    return chunk;
+  }
+
+  std::string getOutputPath()
+  {
+    return ( stdfs::temp_directory_path() / "core-bench-chunk.chunk" ).string();
+  }
+
+  // what scene-tool did before streaming writer: whole chunk in memory, one shot compression
+  void writeOneShot( const ChunkData& chunk, int level )
+  {
+    auto timer  = bench::Timer();
+    auto buffer = msgpack::sbuffer();
+    auto packer = msgpack::packer<msgpack::sbuffer>( buffer );
+    packer.pack_array( 2 );
+    packer.pack( chunk.meshes );
+    packer.pack( chunk.textures );
+
+    auto source = std::span( reinterpret_cast<const byte*>( buffer.data() ), buffer.size() );
+    auto status = fs::writeFileCompressed( getOutputPath(), source, level );
+    assert( status == StatusOk );
+    ( void ) status;
+
+    char name[64];
+    snprintf( name, sizeof( name ), "one shot, level %d", level );
+    bench::report( name, timer.getMs() );
+
+    // packed chunk and ZSTD_compressBound sized output (slightly more than source), zstd context is not counted
+    snprintf( name, sizeof( name ), "one shot, level %d, buffers", level );
+    bench::reportBytes( name, buffer.size() * 2 + buffer.size() / 256 );
+  }
+
+  void writeStreaming( const ChunkData& chunk, int meshLevel, int textureLevel, u32 workerCount )
+  {
+    auto timer       = bench::Timer();
+    u64  memoryBytes = 0;
+    {
+      auto writer = fs::CompressedFileWriter( getOutputPath().c_str(), meshLevel, workerCount );
+      auto packer = msgpack::packer<fs::CompressedFileWriter>( writer );
+      packer.pack_array( 2 );
+      packer.pack( chunk.meshes );
+      writer.setCompressionLevel( textureLevel );
+      packer.pack( chunk.textures );
+      auto status = writer.finish();
+      assert( status == StatusOk );
+      ( void ) status;
+      memoryBytes = writer.getMemoryBytes();
+    }
+
+    char name[64];
+    snprintf( name, sizeof( name ), "stream, levels %d/%d, %u workers", meshLevel, textureLevel, workerCount );
+    bench::report( name, timer.getMs() );
+    snprintf( name, sizeof( name ), "stream, levels %d/%d, %u workers, memory", meshLevel, textureLevel, workerCount );
+    bench::reportBytes( name, memoryBytes );
+  }
+} // namespace
+
+
+BENCH( chunk_write )
+{
+  auto chunk   = makeChunk();
+  u32  workers = std::thread::hardware_concurrency();
+
+  writeOneShot( chunk, 3 );
+  writeOneShot( chunk, 12 );
+  writeStreaming( chunk, 3, 3, 1 );
+  writeStreaming( chunk, 3, 3, workers );
+  writeStreaming( chunk, 3, 12, 1 );
+  writeStreaming( chunk, 3, 12, workers );
+
+  stdfs::remove( getOutputPath() );
+}
@@ -0,0 +1,324 @@
+#include "bench.hpp"
+#include "core/system/profiler.hpp"
+#include <latch>
+#include <random>
+#include <zstd.h>
+
+using namespace core;
+
+
+namespace
+{
+  constexpr u32 sKeyCount       = 4096;
+  constexpr u32 sQueueProducers = 4;
+  constexpr u32 sQueueItems     = 50'000; // per producer
+  constexpr u32 sChurnCount     = 100'000;
+  constexpr u32 sFileSize       = 4 * 1024 * 1024;
+
+  // fixed seed and sizes, so every run measures the same work
+  std::mt19937 makeRng()
+  {
+    return std::mt19937( 42 );
+  }
+
+  std::vector<std::string> makeNames( const char* kind, u32 count )
+  {
+    auto names = std::vector<std::string>();
+    for( u32 i = 0; i < count; ++i )
+    {
+      char buffer[64];
+      snprintf( buffer, sizeof( buffer ), "maps/mall-real/%s-%u", kind, i );
+      names.emplace_back( buffer );
+    }
+    return names;
+  }
+
+  // smaller version of what scene-tool writes: smooth vertex data, noisy block compressed texels
+  data::schema::Chunk makeChunk()
+  {
+    auto chunk = data::schema::Chunk();
+    auto rng   = makeRng();
+
+    for( u32 m = 0; m < 64; ++m )
+    {
+      auto& mesh = chunk.meshes.emplace_back();
+      mesh.id    = m;
+      for( u32 v = 0; v < 2048; ++v )
+      {
+        f32 t = static_cast<f32>( v ) * 0.01f;
+        mesh.vertexBuffer.push_back( data::schema::VertexData{
+            .position = { std::sin( t ) * 10.f, std::cos( t ) * 10.f, t },
+            .normal   = { 0.f, 1.f, 0.f },
+            .uv       = { t, 1.f - t },
+        } );
+        mesh.indexBuffer.push_back( v );
+      }
+    }
+
+    for( u32 t = 0; t < 8; ++t )
+    {
+      auto& texture = chunk.textures.emplace_back();
+      texture.id    = t;
+      texture.width = texture.height = 512;
+      texture.mipLevels = texture.arraySize = 1;
+
+      auto& mip         = texture.data.emplace_back();
+      mip.memPitch      = 1024;
+      mip.memSlicePitch = 128 * 1024;
+      mip.mem.resize( mip.memSlicePitch );
+      for( size_t i = 0; i < mip.mem.size(); ++i )
+        mip.mem[i] = static_cast<byte>( ( i % 8 < 4 ) ? ( i / 4096 ) : rng() );
+    }
+
+    return chunk;
+  }
+} // namespace
+
+
+BENCH( string_id )
+{
+  auto names = makeNames( "object", sKeyCount );
+
+  bench::measure( "hash", names.size(), [&names]() {
+    for( const auto& name: names )
+      bench::doNotOptimize( StringId( name ) );
+  } );
+
+  auto map = StringIdMap<u32>();
+  for( u32 i = 0; i < sKeyCount; ++i )
+    map.emplace_unique( StringId( names[i] ), i );
+
+  // lookups come in order unrelated to insertion, as entities of scene ask for assets
+  auto hits = std::vector<StringId>( map.size() );
+  for( u32 i = 0; i < sKeyCount; ++i )
+    hits[i] = StringId( names[( i * 7919u ) % sKeyCount] );
+
+  auto misses = std::vector<StringId>();
+  for( const auto& name: makeNames( "missing", sKeyCount ) )
+    misses.emplace_back( name );
+
+  bench::measure( "map lookup, hit", hits.size(), [&map, &hits]() {
+    for( StringId id: hits )
+      bench::doNotOptimize( map.try_get( id ) );
+  } );
+
+  bench::measure( "map lookup, miss", misses.size(), [&map, &misses]() {
+    for( StringId id: misses )
+      bench::doNotOptimize( map.try_get( id ) );
+  } );
+}
+
+
+BENCH( static_vector )
+{
+  constexpr u32 sCapacity = 64;
+
+  bench::measure( "push_back, iterate, pop_back", sCapacity, []() {
+    auto vector = StaticVector<u64, sCapacity>();
+    for( u32 i = 0; i < sCapacity; ++i )
+      vector.push_back( i );
+    bench::doNotOptimize( vector );
+
+    u64 sum = 0;
+    for( u64 value: vector )
+      sum += value;
+    while( !vector.empty() )
+      sum += vector.pop_back();
+    bench::doNotOptimize( sum );
+  } );
+}
+
+
+// all producers push at once while one consumer drains, like async loads reporting to main thread
+BENCH( message_queue )
+{
+  constexpr u32 sTotal = sQueueProducers * sQueueItems;
+
+  bench::measure( "push/pop, 4 producers, 1 consumer", sTotal, []() {
+    auto queue = system::MessageQueue<u64>();
+    auto start = std::latch( sQueueProducers + 1 );
+
+    auto producers = std::vector<std::thread>();
+    for( u32 p = 0; p < sQueueProducers; ++p )
+    {
+      producers.emplace_back( [&queue, &start]() {
+        start.arrive_and_wait();
+        for( u32 i = 0; i < sQueueItems; ++i )
+          queue.push( i );
+      } );
+    }
+
+    start.arrive_and_wait();
+    for( u32 popped = 0; popped < sTotal; )
+    {
+      if( auto value = queue.tryPop() )
+      {
+        bench::doNotOptimize( *value );
+        popped++;
+      }
+    }
+
+    for( auto& producer: producers )
+      producer.join();
+  } );
+}
+
+
+BENCH( ref_collection )
+{
+  auto mainRef = data::RefMain();
+  auto ref     = data::RefCounter( &mainRef );
+
+  bench::measure( "RefCounter copy, move, destroy", sChurnCount, [&ref]() {
+    for( u32 i = 0; i < sChurnCount; ++i )
+    {
+      auto copy  = ref;
+      auto moved = std::move( copy );
+      bench::doNotOptimize( moved );
+    }
+  } );
+
+  // every frame: all chunks are still referenced, nothing is removed
+  auto collection = data::SimpleRefCollection<u64>();
+  auto refs       = std::vector<data::RefCounter>();
+  for( u32 i = 0; i < sKeyCount; ++i )
+    refs.push_back( collection.add( i ) );
+
+  bench::measure( "cleanup, all referenced", sKeyCount, [&collection]() {
+    collection.cleanup();
+  } );
+
+  // scene change: half of chunks lost their references
+  bench::measure( "add, then cleanup half", sKeyCount, []() {
+    auto churn     = data::SimpleRefCollection<u64>();
+    auto churnRefs = std::vector<data::RefCounter>();
+    churnRefs.reserve( sKeyCount / 2 );
+    for( u32 i = 0; i < sKeyCount; ++i )
+    {
+      auto itemRef = churn.add( i );
+      if( i % 2 )
+        churnRefs.push_back( std::move( itemRef ) );
+    }
+    churn.cleanup();
+    bench::doNotOptimize( churn );
+  } );
+}
+
+
+// file stays in page cache after first read, so this is copy out of cache, not disk
+BENCH( chunk_read )
+{
+  auto chunk  = makeChunk();
+  auto packed = msgpack::sbuffer();
+  msgpack::pack( packed, chunk );
+
+  auto source  = std::span( reinterpret_cast<const byte*>( packed.data() ), packed.size() );
+  auto encoded = std::vector<byte>();
+  auto status  = fs::compress( source, encoded, 3 );
+  assert( status == StatusOk );
+
+  auto path  = ( stdfs::temp_directory_path() / "core-bench-primitives.bin" ).string();
+  auto bytes = std::vector<byte>( sFileSize );
+  std::ranges::generate( bytes, [rng = makeRng()]() mutable { return static_cast<byte>( rng() ); } );
+  status = fs::writeFile( path, bytes );
+  assert( status == StatusOk );
+  ( void ) status;
+
+  bench::measure( "fs::readFile, 4 MiB", 1, [&path]() {
+    auto out = std::vector<byte>();
+    auto s   = fs::readFile( path, out );
+    assert( s == StatusOk && out.size() == sFileSize );
+    ( void ) s;
+    bench::doNotOptimize( out );
+  } );
+
+  // same call as loader does for single frame of known size
+  auto context = std::unique_ptr<ZSTD_DCtx, decltype( &ZSTD_freeDCtx )>( ZSTD_createDCtx(), &ZSTD_freeDCtx );
+  auto decoded = std::vector<byte>( packed.size() );
+  bench::measure( "zstd decompress, chunk", 1, [&context, &decoded, &encoded]() {
+    size_t size = ZSTD_decompressDCtx( context.get(), decoded.data(), decoded.size(), encoded.data(), encoded.size() );
+    assert( !ZSTD_isError( size ) && size == decoded.size() );
+    ( void ) size;
+    bench::doNotOptimize( decoded );
+  } );
+
+  bench::measure( "msgpack decode, chunk", 1, [source]() {
+    auto obj       = msgpack::object();
+    auto objHandle = msgpack::object_handle();
+    auto s         = fs::decodeMsgpack( source, obj, objHandle );
+    assert( s == StatusOk );
+    ( void ) s;
+
+    auto decodedChunk = data::schema::Chunk();
+    obj.convert( decodedChunk );
+    bench::doNotOptimize( decodedChunk );
+  } );
+
+  bench::reportBytes( "chunk, msgpack", packed.size() );
+  bench::reportBytes( "chunk, compressed", encoded.size() );
+  stdfs::remove( path );
+}
+
+
+BENCH( math )
+{
+  auto rng    = makeRng();
+  auto coords = std::uniform_real_distribution<f32>( -10.f, 10.f );
+  auto scene  = Scene( "bench"_sid );
+
+  auto transforms = std::vector<logic::TransformComponent*>();
+  for( u32 i = 0; i < sKeyCount; ++i )
+  {
+    auto* transform           = scene.addEntity( StringId( i ) )->addComponent<logic::TransformComponent>();
+    transform->props.position = Vec3( coords( rng ), coords( rng ), coords( rng ) );
+    transform->props.rotation = glm::angleAxis( coords( rng ), glm::normalize( Vec3( coords( rng ), 1.f, coords( rng ) ) ) );
+    transform->props.scale    = Vec3( 1.f + std::abs( coords( rng ) ) );
+    transforms.push_back( transform );
+  }
+
+  bench::measure( "TransformComponent::getWorldTransform", transforms.size(), [&transforms]() {
+    for( const auto* transform: transforms )
+      bench::doNotOptimize( transform->getWorldTransform() );
+  } );
+
+  // portal sized box, points around it, about third of them outside
+  auto box = math::BoundingBox{
+      .center = Vec3( -5.f, -5.f, -5.f ),
+      .bx     = Vec3( 10.f, 0.f, 0.f ),
+      .by     = Vec3( 0.f, 10.f, 0.f ),
+      .bz     = Vec3( 0.f, 0.f, 12.f ),
+  };
+  auto points = std::vector<Vec3>();
+  for( u32 i = 0; i < sKeyCount; ++i )
+    points.emplace_back( coords( rng ) * 0.6f, coords( rng ) * 0.6f, coords( rng ) * 0.6f );
+
+  bench::measure( "BoundingBox::isInside", points.size(), [&box, &points]() {
+    u32 inside = 0;
+    for( Vec3 point: points )
+      inside += box.isInside( point ) ? 1 : 0;
+    bench::doNotOptimize( inside );
+  } );
+}
+
+
+// empty scope: two timestamps and one store into thread ring. ring wraps, frame end never collects it
+BENCH( profiler_scope )
+{
+#if mCoreProfilerEnabled
+  constexpr u32 sScopeCount   = 10'000;
+  constexpr f64 sScopeLimitNs = 50.0; // cost of one scope which stays invisible in frame time
+
+  if( system::profiler::init() != StatusOk )
+    return;
+
+  f64 scopeNs = bench::measure( "mCoreProfileScope, empty", sScopeCount, []() {
+    for( u32 i = 0; i < sScopeCount; ++i )
+    {
+      mCoreProfileScope( "bench" );
+    }
+  } );
+  bench::checkLimit( "mCoreProfileScope, empty", scopeNs, sScopeLimitNs );
+
+  system::profiler::destroy();
+#endif
+}
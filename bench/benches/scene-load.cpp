@@ -0,0 +1,157 @@
+#include "bench.hpp"
+
+#ifdef _WIN32
+#  include <psapi.h>
+#else
+#  include <malloc.h>
+#endif
+
+using namespace core;
+
+
+namespace
+{
+  constexpr u32 sEntityCount = 50'000;
+
+  // heap of the process, to see how much scene description holds while scene is loading
+  u64 getHeapBytes()
+  {
+#ifdef _WIN32
+    auto counters = PROCESS_MEMORY_COUNTERS_EX{};
+    GetProcessMemoryInfo( GetCurrentProcess(), reinterpret_cast<PROCESS_MEMORY_COUNTERS*>( &counters ), sizeof( counters ) );
+    return counters.PrivateUsage;
+#else
+    return mallinfo2().uordblks;
+#endif
+  }
+
+  // what scene-tool makes for every mesh object
+  data::ShSceneInfo makeScene()
+  {
+    auto scene = data::ShSceneInfo();
+    scene.objects.reserve( sEntityCount );
+
+    for( u32 i = 0; i < sEntityCount; ++i )
+    {
+      char name[64];
+      snprintf( name, sizeof( name ), "object-%u", i );
+
+      auto& object = scene.objects.emplace_back();
+      object.id    = StringId( name ).getHash();
+      object.components.push_back( data::makeShComponent<logic::TransformComponent>( {
+          .position = Vec3( static_cast<f32>( i ), 0, 0 ),
+      } ) );
+      object.components.push_back( data::makeShComponent<logic::MaterialComponent>( {
+          .textureDiffuseId = StringId( name ),
+          .blendMode        = render::BlendMode(),
+      } ) );
+      object.components.push_back( data::makeShComponent<logic::RenderMeshComponent>( {
+          .meshId = StringId( name ),
+      } ) );
+    }
+
+    return scene;
+  }
+
+  // same as component fabrics registered in logic
+  Component* instantiate( StringHash type, Entity* entity )
+  {
+    if( type == logic::TransformComponent::getComponentId() )
+      return new logic::TransformComponent( entity );
+    if( type == logic::MaterialComponent::getComponentId() )
+      return new logic::MaterialComponent( entity );
+    assert( type == logic::RenderMeshComponent::getComponentId() );
+    return new logic::RenderMeshComponent( entity );
+  }
+
+  Status loadJson( const std::string& path )
+  {
+    auto timer      = bench::Timer();
+    u64  heapBefore = getHeapBytes();
+    auto sceneInfo  = data::ShSceneInfo();
+    mCoreCheckStatus( data::readJsonFile( path, sceneInfo ) );
+    u64 descriptionBytes = getHeapBytes() - heapBefore;
+    bench::report( "json, read", timer.getMs() );
+
+    auto scene = Scene( "bench"_sid );
+    timer      = bench::Timer();
+    for( const auto& object: sceneInfo.objects )
+    {
+      auto* entity = scene.addEntity( object.id );
+      for( const auto& component: object.components )
+      {
+        auto* instance = instantiate( component.type, entity );
+        instance->deserialize( component.data );
+        entity->addComponent( component.type, instance );
+      }
+    }
+    bench::report( "json, instantiate", timer.getMs() );
+    bench::reportBytes( "json, description memory", descriptionBytes );
+    return StatusOk;
+  }
+
+  Status loadBinary( const std::string& path )
+  {
+    auto timer      = bench::Timer();
+    u64  heapBefore = getHeapBytes();
+    auto binary     = data::ShBinaryScene();
+    mCoreCheckStatus( binary.open( path ) );
+    u64 descriptionBytes = getHeapBytes() - heapBefore;
+    bench::report( "binary, open", timer.getMs() );
+
+    auto scene = Scene( "bench"_sid );
+    timer      = bench::Timer();
+
+    auto entities = std::vector<Entity*>();
+    entities.reserve( binary.getEntities().size() );
+    for( StringHash id: binary.getEntities() )
+      entities.push_back( scene.addEntity( id ) );
+
+    for( const auto& block: binary.getComponentBlocks() )
+    {
+      auto blockEntities = binary.getBlockEntities( block );
+      for( u32 i = 0; i < block.count; ++i )
+      {
+        auto* entity   = entities[blockEntities[i]];
+        auto* instance = instantiate( block.type, entity );
+        instance->deserializeBinary( binary.getBlockProps( block, i ) );
+        entity->addComponent( block.type, instance );
+      }
+    }
+    bench::report( "binary, instantiate", timer.getMs() );
+    bench::reportBytes( "binary, description memory", descriptionBytes );
+    return StatusOk;
+  }
+
+  Status writeScene( const data::ShSceneInfo& sceneInfo, const std::string& jsonPath, const std::string& binPath )
+  {
+    auto binary = std::vector<byte>();
+    mCoreCheckStatus( data::writeJsonFile( jsonPath, sceneInfo ) );
+    mCoreCheckStatus( data::toBinary( sceneInfo, binary ) );
+    mCoreCheckStatus( fs::writeFile( binPath, binary ) );
+
+    bench::reportBytes( "json, file", stdfs::file_size( jsonPath ) );
+    bench::reportBytes( "binary, file", binary.size() );
+    return StatusOk;
+  }
+} // namespace
+
+
+BENCH( scene_load )
+{
+  auto sceneInfo = makeScene();
+  auto jsonPath  = ( stdfs::temp_directory_path() / "core-bench.scene.json" ).string();
+  auto binPath   = ( stdfs::temp_directory_path() / "core-bench.scene.bin" ).string();
+
+  // timings of work which failed would be meaningless, so bench stops at first error
+  auto status = writeScene( sceneInfo, jsonPath, binPath );
+  if( status == StatusOk )
+    status = loadJson( jsonPath );
+  if( status == StatusOk )
+    status = loadBinary( binPath );
+  if( status != StatusOk )
+    printf( "  scene load failed: %s\n", core::getErrorDetails() );
+
+  stdfs::remove( jsonPath );
+  stdfs::remove( binPath );
+}
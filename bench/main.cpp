@@ -0,0 +1,279 @@
+#include "bench.hpp"
+
+using namespace core;
+using namespace bench;
+
+
+namespace
+{
+  struct BenchInfo
+  {
+    const char* name;
+    BenchFunc   func;
+  };
+
+  struct Result
+  {
+    std::string bench;
+    std::string name;
+    const char* unit    = "ns";
+    f64         median  = 0;
+    f64         mad     = 0;
+    u32         samples = 1; // single shot results (report, reportBytes) are not compared against baseline
+  };
+
+  struct RunOptions
+  {
+    const char* filter   = nullptr; // run only benches which names contain it
+    const char* json     = nullptr; // results are written here
+    const char* baseline = nullptr; // results of previous run to compare with
+  };
+
+  // regression is change above noise of both runs and above this fraction of baseline
+  constexpr f64 sMinChange = 0.05;
+  constexpr f64 sMadFactor = 3.0;
+
+  Options             sOptions;
+  std::vector<Result> sResults;
+  const char*         sCurrentBench  = "";
+  u32                 sLimitsExceeded = 0;
+
+  std::vector<BenchInfo>& getBenches()
+  {
+    static auto benches = std::vector<BenchInfo>();
+    return benches;
+  }
+
+  f64 getMedian( std::vector<f64> values )
+  {
+    auto middle = values.begin() + static_cast<ptrdiff_t>( values.size() / 2 );
+    std::ranges::nth_element( values, middle );
+    if( values.size() % 2 )
+      return *middle;
+    return ( *middle + *std::max_element( values.begin(), middle ) ) / 2;
+  }
+
+  // picks unit which keeps value readable, results in json are always in ns
+  void printNs( const char* caseName, f64 median, f64 mad )
+  {
+    if( median >= 1e6 )
+      printf( "  %-40s %10.3f ms  +- %.3f\n", caseName, median / 1e6, mad / 1e6 );
+    else if( median >= 1e3 )
+      printf( "  %-40s %10.3f us  +- %.3f\n", caseName, median / 1e3, mad / 1e3 );
+    else
+      printf( "  %-40s %10.3f ns  +- %.3f\n", caseName, median, mad );
+  }
+
+  std::string getResultKey( const std::string& bench, const std::string& name )
+  {
+    return bench + "/" + name;
+  }
+
+  Status writeResults( const char* path )
+  {
+    auto results = Json::array();
+    for( const auto& result: sResults )
+    {
+      results.push_back( Json{
+          { "bench", result.bench },
+          { "case", result.name },
+          { "unit", result.unit },
+          { "median", result.median },
+          { "mad", result.mad },
+          { "samples", result.samples },
+      } );
+    }
+
+    auto json = Json{
+        { "warmups", sOptions.warmups },
+        { "repetitions", sOptions.repetitions },
+        { "results", std::move( results ) },
+    };
+    return fs::writeFileJson( path, json );
+  }
+
+  // prints change of every measured case against baseline, counts regressions
+  Status compareResults( const char* path, u32& regressions )
+  {
+    auto json = Json();
+    mCoreCheckStatus( fs::readFileJson( path, json ) );
+
+    auto baseline = std::unordered_map<std::string, Result>();
+    try
+    {
+      for( const auto& item: json.at( "results" ) )
+      {
+        auto result = Result{
+            .bench   = item.at( "bench" ).get<std::string>(),
+            .name    = item.at( "case" ).get<std::string>(),
+            .unit    = "",
+            .median  = item.at( "median" ).get<f64>(),
+            .mad     = item.at( "mad" ).get<f64>(),
+            .samples = item.at( "samples" ).get<u32>(),
+        };
+        baseline.emplace( getResultKey( result.bench, result.name ), std::move( result ) );
+      }
+    }
+    catch( const std::exception& ex )
+    {
+      core::setErrorDetails( "%s is not bench results: %s", path, ex.what() );
+      return StatusBadFile;
+    }
+
+    printf( "\ncompared with %s\n", path );
+    regressions = 0;
+    for( const auto& result: sResults )
+    {
+      auto it = baseline.find( getResultKey( result.bench, result.name ) );
+      if( result.samples < 2 || it == baseline.end() || it->second.samples < 2 || it->second.median <= 0 )
+        continue;
+
+      const auto& base      = it->second;
+      f64         change    = result.median - base.median;
+      f64         threshold = std::max( sMadFactor * ( result.mad + base.mad ), sMinChange * base.median );
+
+      const char* verdict = "";
+      if( change > threshold )
+      {
+        verdict = "  REGRESSION";
+        regressions++;
+      }
+      else if( -change > threshold )
+        verdict = "  improvement";
+
+      printf( "  %-24s %-40s %+7.1f%%%s\n", result.bench.c_str(), result.name.c_str(), 100.0 * change / base.median, verdict );
+    }
+
+    return StatusOk;
+  }
+
+  bool parseOptions( int argc, char** argv, RunOptions& options )
+  {
+    for( int i = 1; i < argc; ++i )
+    {
+      auto arg     = std::string_view( argv[i] );
+      bool hasNext = i + 1 < argc;
+
+      if( arg == "-json" && hasNext )
+        options.json = argv[++i];
+      else if( arg == "-baseline" && hasNext )
+        options.baseline = argv[++i];
+      else if( arg == "-warmups" && hasNext )
+        sOptions.warmups = static_cast<u32>( std::strtoul( argv[++i], nullptr, 10 ) );
+      else if( arg == "-repetitions" && hasNext )
+        sOptions.repetitions = std::max( 1u, static_cast<u32>( std::strtoul( argv[++i], nullptr, 10 ) ) );
+      else if( !arg.starts_with( "-" ) && !options.filter )
+        options.filter = argv[i];
+      else
+      {
+        printf( "unknown option: %s\n", argv[i] );
+        printf( "usage: core-bench [filter] [-json results.json] [-baseline results.json]\n"
+                "                  [-warmups count] [-repetitions count]\n" );
+        return false;
+      }
+    }
+    return true;
+  }
+} // namespace
+
+
+Registrar::Registrar( const char* name, BenchFunc func )
+{
+  getBenches().push_back( BenchInfo{ .name = name, .func = func } );
+}
+
+const Options& bench::getOptions()
+{
+  return sOptions;
+}
+
+void bench::report( const char* caseName, f64 ms )
+{
+  printf( "  %-40s %10.3f ms\n", caseName, ms );
+  sResults.push_back( Result{ .bench = sCurrentBench, .name = caseName, .unit = "ms", .median = ms } );
+}
+
+void bench::reportBytes( const char* caseName, u64 bytes )
+{
+  f64 mib = static_cast<f64>( bytes ) / ( 1024.0 * 1024.0 );
+  printf( "  %-40s %10.3f MiB\n", caseName, mib );
+  sResults.push_back( Result{ .bench = sCurrentBench, .name = caseName, .unit = "MiB", .median = mib } );
+}
+
+f64 bench::reportSamples( const char* caseName, std::span<const f64> samplesNs )
+{
+  auto samples    = std::vector<f64>( samplesNs.begin(), samplesNs.end() );
+  f64  median     = getMedian( samples );
+  auto deviations = std::vector<f64>();
+  for( f64 sample: samples )
+    deviations.push_back( std::abs( sample - median ) );
+  f64 mad = getMedian( std::move( deviations ) );
+
+  printNs( caseName, median, mad );
+  sResults.push_back( Result{
+      .bench   = sCurrentBench,
+      .name    = caseName,
+      .unit    = "ns",
+      .median  = median,
+      .mad     = mad,
+      .samples = static_cast<u32>( samples.size() ),
+  } );
+  return median;
+}
+
+void bench::checkLimit( const char* caseName, f64 medianNs, f64 limitNs )
+{
+  bool exceeded = medianNs >= limitNs;
+  printf( "  %-40s limit %.1f ns: %s\n", caseName, limitNs, exceeded ? "EXCEEDED" : "ok" );
+  sLimitsExceeded += exceeded ? 1 : 0;
+}
+
+
+int main( int argc, char** argv )
+{
+  auto options = RunOptions();
+  if( !parseOptions( argc, argv, options ) )
+    return 1;
+
+  for( const auto& bench: getBenches() )
+  {
+    if( options.filter && !std::string_view( bench.name ).contains( options.filter ) )
+      continue;
+
+    printf( "%s\n", bench.name );
+    sCurrentBench = bench.name;
+    bench.func();
+  }
+
+  if( options.json )
+  {
+    if( auto s = writeResults( options.json ); s != StatusOk )
+    {
+      printf( "can't write %s: %s\n", options.json, core::getErrorDetails() );
+      return 1;
+    }
+  }
+
+  if( options.baseline )
+  {
+    u32 regressions = 0;
+    if( auto s = compareResults( options.baseline, regressions ); s != StatusOk )
+    {
+      printf( "can't compare with %s: %s\n", options.baseline, core::getErrorDetails() );
+      return 1;
+    }
+    if( regressions )
+    {
+      printf( mFmtU32 " regressions\n", regressions );
+      return 2;
+    }
+  }
+
+  if( sLimitsExceeded )
+  {
+    printf( mFmtU32 " limits exceeded\n", sLimitsExceeded );
+    return 3;
+  }
+
+  return 0;
+}
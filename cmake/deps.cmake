@@ -16,12 +16,16 @@ option(MSGPACK_USE_BOOST "" OFF)
 option(MSGPACK_BUILD_DOCS "" OFF)
 add_subdirectory(${VY_ROOT}/deps/msgpack-c msgpack-c)
 
-add_subdirectory(${VY_ROOT}/deps/nvtt nvtt)
+# used by scene-tool only
+if(WIN32)
+  add_subdirectory(${VY_ROOT}/deps/nvtt nvtt)
 
-add_subdirectory(${VY_ROOT}/deps/DirectXTex DirectXTex)
-target_compile_options(DirectXTex PRIVATE -Wno-unsafe-buffer-usage)
+  add_subdirectory(${VY_ROOT}/deps/DirectXTex DirectXTex)
+  target_compile_options(DirectXTex PRIVATE -Wno-unsafe-buffer-usage)
+endif()
 
 add_subdirectory(${VY_ROOT}/deps/function2)
 add_subdirectory(${VY_ROOT}/deps/continuable)
 
 add_subdirectory(${VY_ROOT}/deps/zstd)
+target_compile_definitions(zstd PRIVATE ZSTD_MULTITHREAD)
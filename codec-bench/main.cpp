@@ -0,0 +1,430 @@
+#include "core/core.hpp"
+#include "core/data/schema.hpp"
+#include <zstd.h>
+
+using namespace core;
+
+
+namespace
+{
+  // exported data split by blob class. each class of a file is compressed as one frame,
+  // same as scene-tool writes chunk sections
+  enum BlobClass
+  {
+    BlobClassVertex,
+    BlobClassIndex,
+    BlobClassTexture,
+    BlobClassJson,
+    BlobClassCount,
+  };
+
+  constexpr const char* sBlobClassNames[BlobClassCount] = { "vertex", "index", "texture-mips", "json" };
+  constexpr u32         sRuns                           = 3; // best of, first run also warms page cache
+  constexpr int         sLongDistanceWindowLog          = 27; // default decoder limit, no special flags to read
+
+  using Clock = std::chrono::steady_clock;
+
+  struct Codec
+  {
+    std::string name;
+    int         level                = 0;
+    bool        longDistanceMatching = false;
+  };
+
+  struct ClassResult
+  {
+    u64 sourceBytes     = 0;
+    u64 compressedBytes = 0;
+    f64 compressMs      = 0;
+    f64 decompressMs    = 0;
+  };
+
+  // whole files through game loader calls: read, decompress and decode, without gpu upload
+  struct LoadResult
+  {
+    u64 fileBytes = 0;
+    f64 chunksMs  = 0;
+    f64 scenesMs  = 0;
+  };
+
+  struct CodecResult
+  {
+    Codec       codec;
+    ClassResult classes[BlobClassCount];
+    LoadResult  load;
+  };
+
+  struct FileBlobs
+  {
+    std::vector<byte> content; // decompressed file, as loader sees it
+    std::vector<byte> classes[BlobClassCount];
+    bool              isScene = false;
+  };
+
+  struct ZstdContexts
+  {
+    ZSTD_CCtx* compress   = ZSTD_createCCtx();
+    ZSTD_DCtx* decompress = ZSTD_createDCtx();
+
+    ZstdContexts()                                 = default;
+    ZstdContexts( const ZstdContexts& )            = delete;
+    ZstdContexts& operator=( const ZstdContexts& ) = delete;
+
+    ~ZstdContexts()
+    {
+      ZSTD_freeCCtx( compress );
+      ZSTD_freeDCtx( decompress );
+    }
+  };
+
+
+  f64 getMs( Clock::time_point start )
+  {
+    return std::chrono::duration<f64, std::milli>( Clock::now() - start ).count();
+  }
+
+  f64 getMiBs( u64 bytes, f64 ms )
+  {
+    return ms > 0 ? static_cast<f64>( bytes ) / ( 1024.0 * 1024.0 ) / ( ms / 1000.0 ) : 0;
+  }
+
+  // there is no lz4 in deps, zstd negative levels are its speed class and read through same decoder
+  std::vector<Codec> makeCodecs()
+  {
+    auto codecs = std::vector<Codec>();
+
+    for( int level: { -5, -1 } )
+      codecs.push_back( Codec{ .name = "zstd-fast-" + std::to_string( -level ), .level = level } );
+
+    for( int level = 1; level <= 19; ++level )
+      codecs.push_back( Codec{ .name = "zstd-" + std::to_string( level ), .level = level } );
+
+    for( int level: { 3, 12, 19 } )
+      codecs.push_back( Codec{ .name = "zstd-" + std::to_string( level ) + "-ldm", .level = level, .longDistanceMatching = true } );
+
+    return codecs;
+  }
+
+  template<typename T>
+  void appendBytes( std::vector<byte>& output, const std::vector<T>& source )
+  {
+    auto bytes = reinterpret_cast<const byte*>( source.data() );
+    output.insert( output.end(), bytes, bytes + source.size() * sizeof( T ) );
+  }
+
+  std::vector<stdfs::path> findDataFiles( const stdfs::path& directory )
+  {
+    auto files = std::vector<stdfs::path>();
+
+    for( auto it = stdfs::recursive_directory_iterator( directory ); it != stdfs::recursive_directory_iterator(); ++it )
+    {
+      auto name = it->path().filename().string();
+      if( name.starts_with( "." ) )
+      {
+        it.disable_recursion_pending();
+        continue;
+      }
+
+      if( it->is_regular_file() && ( name.ends_with( ".chunk" ) || name.ends_with( ".scene.json" ) || name.ends_with( ".scene.json.zst" ) ) )
+        files.push_back( it->path() );
+    }
+
+    std::ranges::sort( files );
+    return files;
+  }
+
+
+  Status readChunkBlobs( const stdfs::path& path, FileBlobs& out )
+  {
+    auto handle = msgpack::object_handle();
+    auto object = msgpack::object();
+    mCoreCheckStatus( fs::readFileMsgpackCompressed( path.string(), object, handle ) );
+
+    auto chunk = data::schema::Chunk();
+    try
+    {
+      object.convert( chunk );
+    }
+    catch( const std::exception& ex )
+    {
+      core::setErrorDetails( "can't decode render chunk %s: %s", path.string().c_str(), ex.what() );
+      return StatusSystemError;
+    }
+
+    auto buffer = msgpack::sbuffer();
+    msgpack::pack( buffer, chunk );
+    auto content = reinterpret_cast<const byte*>( buffer.data() );
+    out.content.assign( content, content + buffer.size() );
+
+    for( const auto& mesh: chunk.meshes )
+    {
+      appendBytes( out.classes[BlobClassVertex], mesh.vertexBuffer );
+      appendBytes( out.classes[BlobClassIndex], mesh.indexBuffer );
+    }
+    for( const auto& texture: chunk.textures )
+      for( const auto& mip: texture.data )
+        appendBytes( out.classes[BlobClassTexture], mip.mem );
+
+    return StatusOk;
+  }
+
+  Status readSceneBlobs( const stdfs::path& path, FileBlobs& out )
+  {
+    auto json = Json();
+    mCoreCheckStatus( fs::readFileJson( path.string(), json ) );
+
+    // same formatting as fs::writeFileJson
+    auto text = json.dump( 2 );
+    out.content.assign( reinterpret_cast<const byte*>( text.data() ), reinterpret_cast<const byte*>( text.data() ) + text.size() );
+    out.classes[BlobClassJson] = out.content;
+    out.isScene                = true;
+
+    return StatusOk;
+  }
+
+
+  Status compress( ZSTD_CCtx* context, const Codec& codec, std::span<const byte> source, std::vector<byte>& output )
+  {
+    ZSTD_CCtx_reset( context, ZSTD_reset_session_and_parameters );
+    ZSTD_CCtx_setParameter( context, ZSTD_c_compressionLevel, codec.level );
+    if( codec.longDistanceMatching )
+    {
+      ZSTD_CCtx_setParameter( context, ZSTD_c_enableLongDistanceMatching, 1 );
+      ZSTD_CCtx_setParameter( context, ZSTD_c_windowLog, sLongDistanceWindowLog );
+    }
+
+    output.resize( ZSTD_compressBound( source.size() ) );
+    size_t size = ZSTD_compress2( context, output.data(), output.size(), source.data(), source.size() );
+    if( ZSTD_isError( size ) )
+    {
+      core::setErrorDetails( "%s: compression failed: %s", codec.name.c_str(), ZSTD_getErrorName( size ) );
+      return StatusSystemError;
+    }
+
+    output.resize( size );
+    return StatusOk;
+  }
+
+  Status measureClass( ZstdContexts& contexts, const Codec& codec, std::span<const byte> source, ClassResult& result )
+  {
+    if( source.empty() )
+      return StatusOk;
+
+    auto compressed = std::vector<byte>();
+    auto start      = Clock::now();
+    mCoreCheckStatus( compress( contexts.compress, codec, source, compressed ) );
+    result.compressMs += getMs( start );
+
+    auto decompressed = std::vector<byte>( source.size() );
+    f64  bestMs       = std::numeric_limits<f64>::max();
+    for( u32 run = 0; run < sRuns; ++run )
+    {
+      start       = Clock::now();
+      size_t size = ZSTD_decompressDCtx( contexts.decompress, decompressed.data(), decompressed.size(),
+                                         compressed.data(), compressed.size() );
+      bestMs      = std::min( bestMs, getMs( start ) );
+
+      if( ZSTD_isError( size ) || size != source.size() )
+      {
+        core::setErrorDetails( "%s: decompression failed", codec.name.c_str() );
+        return StatusSystemError;
+      }
+    }
+
+    result.decompressMs += bestMs;
+    result.sourceBytes += source.size();
+    result.compressedBytes += compressed.size();
+    return StatusOk;
+  }
+
+  Status loadFile( const std::string& path, bool isScene )
+  {
+    if( isScene )
+    {
+      auto scene = data::ShSceneInfo();
+      return data::readJsonFile( path, scene );
+    }
+
+    auto handle = msgpack::object_handle();
+    auto object = msgpack::object();
+    mCoreCheckStatus( fs::readFileMsgpackCompressed( path, object, handle ) );
+
+    try
+    {
+      auto chunk = data::schema::Chunk();
+      object.convert( chunk );
+    }
+    catch( const std::exception& ex )
+    {
+      core::setErrorDetails( "can't decode render chunk: %s", ex.what() );
+      return StatusSystemError;
+    }
+
+    return StatusOk;
+  }
+
+  // file is written as one frame, loaders detect compression by extension
+  Status measureLoad( ZstdContexts& contexts, const Codec& codec, const FileBlobs& blobs, LoadResult& result )
+  {
+    auto compressed = std::vector<byte>();
+    mCoreCheckStatus( compress( contexts.compress, codec, blobs.content, compressed ) );
+
+    auto path = ( stdfs::temp_directory_path() / ( blobs.isScene ? "codec-bench.scene.json.zst" : "codec-bench.chunk" ) ).string();
+    mCoreCheckStatus( fs::writeFile( path, compressed ) );
+
+    f64 bestMs = std::numeric_limits<f64>::max();
+    for( u32 run = 0; run < sRuns; ++run )
+    {
+      auto start = Clock::now();
+      mCoreCheckStatus( loadFile( path, blobs.isScene ) );
+      bestMs = std::min( bestMs, getMs( start ) );
+    }
+
+    result.fileBytes += compressed.size();
+    ( blobs.isScene ? result.scenesMs : result.chunksMs ) += bestMs;
+    stdfs::remove( path );
+    return StatusOk;
+  }
+
+
+  void printResults( const std::vector<CodecResult>& results )
+  {
+    for( u32 c = 0; c < BlobClassCount; ++c )
+    {
+      if( results.empty() || results[0].classes[c].sourceBytes == 0 )
+        continue;
+
+      printf( "%s: %.3f MiB\n", sBlobClassNames[c], static_cast<f64>( results[0].classes[c].sourceBytes ) / ( 1024.0 * 1024.0 ) );
+      printf( "  %-16s %8s %14s %14s\n", "codec", "ratio", "comp MiB/s", "decomp MiB/s" );
+      for( const auto& result: results )
+      {
+        const auto& r = result.classes[c];
+        printf( "  %-16s %8.3f %14.1f %14.1f\n", result.codec.name.c_str(),
+                static_cast<f64>( r.sourceBytes ) / static_cast<f64>( r.compressedBytes ),
+                getMiBs( r.sourceBytes, r.compressMs ), getMiBs( r.sourceBytes, r.decompressMs ) );
+      }
+    }
+
+    printf( "load through game loader (page cache is warm):\n" );
+    printf( "  %-16s %12s %12s %12s\n", "codec", "files MiB", "chunks ms", "scenes ms" );
+    for( const auto& result: results )
+      printf( "  %-16s %12.3f %12.3f %12.3f\n", result.codec.name.c_str(),
+              static_cast<f64>( result.load.fileBytes ) / ( 1024.0 * 1024.0 ), result.load.chunksMs, result.load.scenesMs );
+  }
+
+  // for tracking results over time, keys are stable
+  Json makeResultsJson( const std::vector<CodecResult>& results )
+  {
+    auto json = Json::array();
+
+    for( const auto& result: results )
+    {
+      auto classes = Json::object();
+      for( u32 c = 0; c < BlobClassCount; ++c )
+      {
+        const auto& r = result.classes[c];
+        if( r.sourceBytes == 0 )
+          continue;
+
+        classes[sBlobClassNames[c]] = {
+            { "sourceBytes", r.sourceBytes },
+            { "compressedBytes", r.compressedBytes },
+            { "compressMs", r.compressMs },
+            { "decompressMs", r.decompressMs },
+        };
+      }
+
+      json.push_back( {
+          { "codec", result.codec.name },
+          { "level", result.codec.level },
+          { "longDistanceMatching", result.codec.longDistanceMatching },
+          { "classes", std::move( classes ) },
+          { "load", { { "fileBytes", result.load.fileBytes }, { "chunksMs", result.load.chunksMs }, { "scenesMs", result.load.scenesMs } } },
+      } );
+    }
+
+    return json;
+  }
+
+
+  Status runCodecBench( const char* jsonOutputPath )
+  {
+    auto files = findDataFiles( data::getDataPath( "" ) );
+    if( files.empty() )
+    {
+      core::setErrorDetails( "no render chunks or scenes in data directory" );
+      return StatusNotFound;
+    }
+
+    auto contexts = ZstdContexts();
+    auto results  = std::vector<CodecResult>();
+    for( auto& codec: makeCodecs() )
+      results.push_back( CodecResult{ .codec = std::move( codec ) } );
+
+    // one file in memory at a time, exports are too big to hold all of them
+    for( size_t i = 0; i < files.size(); ++i )
+    {
+      printf( "[" mFmtSize "/" mFmtSize "] %s\n", i + 1, files.size(), files[i].string().c_str() );
+
+      auto blobs = FileBlobs();
+      auto status = files[i].string().ends_with( ".chunk" ) ? readChunkBlobs( files[i], blobs )
+                                                            : readSceneBlobs( files[i], blobs );
+      mCoreCheckStatus( status );
+
+      for( auto& result: results )
+      {
+        for( u32 c = 0; c < BlobClassCount; ++c )
+          mCoreCheckStatus( measureClass( contexts, result.codec, blobs.classes[c], result.classes[c] ) );
+        mCoreCheckStatus( measureLoad( contexts, result.codec, blobs, result.load ) );
+      }
+    }
+
+    printResults( results );
+
+    if( jsonOutputPath )
+      mCoreCheckStatus( fs::writeFileJson( jsonOutputPath, makeResultsJson( results ) ) );
+
+    return StatusOk;
+  }
+} // namespace
+
+
+int main( int argc, char** argv )
+try
+{
+  printf( "codec bench started\n" );
+
+  core::commonInit();
+
+  if( auto s = core::data::initialize(); s != StatusOk )
+  {
+    printf( "data initialize failed: %s\n", core::getErrorDetails() );
+    return 1;
+  }
+
+  const char* jsonOutputPath = nullptr;
+  if( argc == 3 && argv[1] == std::string_view( "-json" ) )
+    jsonOutputPath = argv[2];
+  else if( argc != 1 )
+  {
+    printf( "usage: codec-bench.exe [-json path-to-results]\n" );
+    return 1;
+  }
+
+  auto status = runCodecBench( jsonOutputPath );
+  core::data::destroy();
+
+  if( status != StatusOk )
+  {
+    printf( "codec bench failed: %s\n", core::getErrorDetails() );
+    return 1;
+  }
+
+  printf( "codec bench ended\n" );
+  return 0;
+}
+catch( std::exception& ex )
+{
+  printf( "codec bench ended with exception: %s\n", ex.what() );
+  return 1;
+}
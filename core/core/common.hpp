@@ -5,9 +5,17 @@
 #define CONTINUABLE_WITH_NO_EXCEPTIONS
 #define CONTINUABLE_WITH_CUSTOM_ERROR_TYPE Status
 #define MSGPACK_NO_BOOST
+#define BS_THREAD_POOL_ENABLE_PRIORITY
 
-#pragma warning( push )
-#pragma warning( disable : 4702 )
+// set by cmake option VY_HEADLESS: no window, null render backend
+#ifndef mCoreHeadless
+#  define mCoreHeadless 0
+#endif
+
+#ifdef _WIN32
+#  pragma warning( push )
+#  pragma warning( disable : 4702 )
+#endif
 #include "core/deps/hash_table8.hpp"
 #include "core/deps/BS_thread_pool.hpp"
 #include <msgpack.hpp>
@@ -15,10 +23,12 @@
 #include <SDL.h>
 #include <glm/glm.hpp>
 #include <glm/ext.hpp>
-#include <D3D11.h>
-#include <windows.h>
-#include <wrl.h>
-#pragma warning( pop )
+#ifdef _WIN32
+#  include <D3D11.h>
+#  include <windows.h>
+#  include <wrl.h>
+#  pragma warning( pop )
+#endif
 
 #include <memory>
 #include <algorithm>
@@ -33,6 +43,8 @@
 #include <mutex>
 #include <future>
 #include <queue>
+#include <deque>
+#include <bit>
 #include <stack>
 #include <variant>
 #include <chrono>
@@ -133,6 +145,10 @@ using Quat = glm::fquat;
 using Json = nlohmann::json;
 
 
+#define mCoreConcatImpl( a, b ) a##b
+#define mCoreConcat( a, b )     mCoreConcatImpl( a, b )
+
+
 #define mCoreEnumExpandMembers( EnumClass, MemberName ) EnumClass##_##MemberName,
 
 #define mCoreEnumExpandToString( EnumClass, MemberName ) \
@@ -177,6 +193,7 @@ enum Status
   StatusBadFile,
   StatusBufferOverflow,
   StatusNotFound,
+  StatusCancelled, // load was cancelled by requester, not an error
 };
 
 // requires Status to be defined before
@@ -1,12 +1,19 @@
 #include "core/core.hpp"
 #include "core/utils.hpp"
-#include <SDL_syswm.h>
-#include <dwmapi.h>
+
+#if !mCoreHeadless
+#  include <SDL_syswm.h>
+#  include <dwmapi.h>
+#endif
 
 using namespace core;
 
 namespace
 {
+#if mCoreHeadless
+  // events only: loop still polls them, there is just nobody to send input
+  constexpr const Uint32 sSDLInitSubsystems = SDL_INIT_EVENTS;
+#else
   constexpr const Uint32 sSDLInitSubsystems = SDL_INIT_AUDIO |
                                               SDL_INIT_VIDEO |
                                               SDL_INIT_JOYSTICK |
@@ -14,16 +21,21 @@ namespace
                                               SDL_INIT_EVENTS;
 
   constexpr const char* sWindowName = "sh3";
+#endif
 
   struct StaticData
   {
     SDL_Window*       window = nullptr;
     system::DeltaTime deltaTime;
+    system::Stopwatch startup; // since initialize started
+    f32               timeToFirstFrameMs  = 0.f;
+    bool              firstFramePresented = false;
   };
 
   StaticData* sData = nullptr;
 
 
+#if !mCoreHeadless
   Status enableDarkMode()
   {
     auto sysWmInfo = SDL_SysWMinfo{};
@@ -42,6 +54,7 @@ namespace
 
     return StatusOk;
   }
+#endif
 
 
   Status initSDL()
@@ -53,6 +66,10 @@ namespace
       return StatusSystemError;
     }
 
+#if mCoreHeadless
+    mCoreLog( "SDL2 initialized without window\n" );
+    return StatusOk;
+#else
     int windowPosX  = SDL_WINDOWPOS_CENTERED;
     int windowPosY  = SDL_WINDOWPOS_CENTERED;
     int windowSizeX = 1920;
@@ -76,6 +93,7 @@ namespace
 
     mCoreLog( "SDL2 initialized\n" );
     return StatusOk;
+#endif
   }
 
 
@@ -93,6 +111,10 @@ namespace
 
   Status initRender()
   {
+#if mCoreHeadless
+    mCoreMemoryScope( Render );
+    mCoreCheckStatus( render::initialize() );
+#else
     auto sysWmInfo = SDL_SysWMinfo{};
     SDL_VERSION( &sysWmInfo.version );
     if( !SDL_GetWindowWMInfo( sData->window, &sysWmInfo ) )
@@ -102,11 +124,13 @@ namespace
       return StatusSystemError;
     }
 
+    mCoreMemoryScope( Render );
     if( auto s = render::initialize( sysWmInfo.info.win.window ); s != StatusOk )
     {
       mCoreLogError( "data initialize failed\n" );
       return s;
     }
+#endif
 
     mCoreLog( "render initialized\n" );
     return StatusOk;
@@ -114,16 +138,36 @@ namespace
 } // namespace
 
 
-Status core::initialize()
+Status core::initialize( InitOptions options )
 {
   commonInit();
   sData = new StaticData();
+  mCoreCheckStatus( system::memory::init() );
+  mCoreCheckStatus( system::profiler::init() );
+  mCoreCheckStatus( system::frame::init() );
   mCoreCheckStatus( system::task::init() );
-  mCoreCheckStatus( initSDL() );
-  mCoreCheckStatus( initData() );
-  mCoreCheckStatus( initRender() );
-  mCoreCheckStatus( input::init() );
-  mCoreCheckStatus( logic::init() );
+  mCoreCheckStatus( render::initRenderThread() );
+
+  // window and device stay on main thread, data is read on worker meanwhile
+  auto graph = system::InitGraph();
+  graph.add( "window", {}, system::InitThreadMain, initSDL );
+  graph.add( "data", {}, system::InitThreadAny, initData );
+  graph.add( "input", {}, system::InitThreadAny, input::init );
+  graph.add( "logic", {}, system::InitThreadAny, logic::init );
+  if( options.onDataReady )
+  {
+    // added before render, so it runs first once data is there
+    graph.add( "data ready", { "data", "logic" }, system::InitThreadMain, [&options]() {
+      options.onDataReady();
+      return StatusOk;
+    } );
+  }
+  graph.add( "render", { "window", "data" }, system::InitThreadMain, initRender );
+
+  auto status = graph.run();
+  graph.logReport();
+  mCoreCheckStatus( status );
+
   mCoreLog( "core initialize succeeded\n" );
   return StatusOk;
 }
@@ -146,6 +190,9 @@ void core::destroy()
   }
 
   system::task::destroy();
+  system::frame::destroy();
+  system::profiler::destroy();
+  system::memory::destroy();
 
   // static data shutdown
   delete sData;
@@ -158,7 +205,10 @@ LoopStatus core::loopStepBegin()
 {
   sData->deltaTime.onLoopStart();
 
-  data::update();
+  {
+    mCoreProfileScope( "data::update" );
+    data::update();
+  }
   input::preUpdate();
 
   SDL_Event event;
@@ -169,10 +219,23 @@ LoopStatus core::loopStepBegin()
 
     input::handle( event );
   }
+  input::replayFrameBegin( sData->deltaTime );
 
   system::task::update();
   logic::update();
-  render::update();
+  {
+    mCoreMemoryScope( Render );
+    render::update();
+  }
+
+  if( input::isKeyMod( input::KeyModCtrl ) && input::isKeyDown( input::KeyP ) )
+  {
+    if( auto s = system::profiler::exportChromeTrace( "profile.json" ); s != StatusOk )
+      mCoreLogError( "error export profile: %d\n", static_cast<int>( s ) );
+    else
+      mCoreLog( "profile of last frames is written to profile.json\n" );
+    system::profiler::logFrameSummary();
+  }
 
   return LoopStatusContinue;
 }
@@ -180,8 +243,24 @@ LoopStatus core::loopStepBegin()
 
 void core::loopStepEnd()
 {
-  render::present();
+  {
+    mCoreProfileScope( "render::present" );
+    mCoreMemoryScope( Render );
+    render::present();
+  }
   sData->deltaTime.onLoopEnd();
+  if( !sData->firstFramePresented )
+  {
+    sData->firstFramePresented = true;
+    sData->timeToFirstFrameMs  = sData->startup.getMsF();
+    mCoreLog( "first frame presented %.1fms after initialize started\n", static_cast<f64>( sData->timeToFirstFrameMs ) );
+  }
+  system::frame::frameEnd();
+  system::profiler::frameEnd();
+
+  // steady frame: nothing is loaded, so scene runs on memory it already has
+  const auto& loadStats = data::getLoadSchedulerStats();
+  system::memory::frameEnd( !logic::isLoading() && loadStats.queued == 0 && loadStats.inFlight == 0 );
 }
 
 
@@ -189,3 +268,9 @@ const system::DeltaTime& core::loopGetDeltaTime()
 {
   return sData->deltaTime;
 }
+
+
+f32 core::getTimeToFirstFrameMs()
+{
+  return sData->timeToFirstFrameMs;
+}
@@ -4,10 +4,13 @@
 #include "core/fs/fs.hpp"
 #include "core/system/system.hpp"
 #include "core/render/render.hpp"
+#include "core/render/render-thread.hpp"
 #include "core/input/input.hpp"
+#include "core/input/replay.hpp"
 #include "core/math/math.hpp"
 #include "core/logic/logic.hpp"
 #include "core/utils.hpp"
+#include "core/hash.hpp"
 
 namespace core
 {
@@ -17,10 +20,19 @@ namespace core
     LoopStatusQuitRequested,
   };
 
-  Status initialize();
+  struct InitOptions
+  {
+    // runs on main thread as soon as data and logic are initialized, while render device is still created.
+    // first scene load starts here, so its files are read during rest of startup
+    std::move_only_function<void()> onDataReady;
+  };
+
+  // independent stages run at the same time, timing of every stage is logged
+  Status initialize( InitOptions options = {} );
   void   destroy();
 
   LoopStatus               loopStepBegin();
   void                     loopStepEnd();
   const system::DeltaTime& loopGetDeltaTime();
+  f32                      getTimeToFirstFrameMs(); // 0 until first frame is presented
 } // namespace core
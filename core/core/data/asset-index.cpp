@@ -0,0 +1,115 @@
+#include "core/data/asset-index.hpp"
+#include "core/core.hpp"
+#include <shared_mutex>
+
+using namespace core;
+using namespace core::data;
+
+
+namespace
+{
+  template<typename TAsset>
+  struct AssetSlots
+  {
+    std::shared_mutex               mutex; // lookups of scene builders share it, new slots take it exclusively
+    std::deque<AssetSlot<TAsset>>   slots; // deque does not move elements on growth
+    StringIdMap<AssetSlot<TAsset>*> index;
+
+    AssetSlot<TAsset>* find( StringId id )
+    {
+      auto   lock = std::shared_lock( mutex );
+      auto** slot = index.try_get( id );
+      return slot ? *slot : nullptr;
+    }
+
+    AssetSlot<TAsset>* getOrAdd( StringId id )
+    {
+      if( auto* slot = find( id ) )
+        return slot;
+
+      auto lock = std::unique_lock( mutex );
+      if( auto** slot = index.try_get( id ) )
+        return *slot;
+
+      auto* slot = &slots.emplace_back();
+      slot->id   = id;
+      index.emplace_unique( id, slot );
+      return slot;
+    }
+
+    using Provider = typename AssetSlot<TAsset>::Provider;
+
+    void add( StringId id, StringId chunkId, TAsset* asset )
+    {
+      auto* slot = getOrAdd( id );
+      std::erase_if( slot->providers, [chunkId]( const Provider& p ) { return p.chunkId == chunkId; } );
+      if( !slot->providers.empty() )
+        mCoreLogDebug( "asset " mFmtStringHash " from chunk " mFmtStringHash " replaces one from chunk " mFmtStringHash "\n",
+                       id.getHash(), chunkId.getHash(), slot->providers.back().chunkId.getHash() );
+
+      slot->providers.push_back( Provider{ .chunkId = chunkId, .asset = asset } );
+      slot->asset.store( asset, std::memory_order_release );
+    }
+
+    void remove( StringId id, StringId chunkId )
+    {
+      auto* slot = find( id );
+      if( !slot || !std::erase_if( slot->providers, [chunkId]( const Provider& p ) { return p.chunkId == chunkId; } ) )
+        return;
+
+      // other chunk may still have the same asset, it provides it from now on
+      auto* asset = slot->providers.empty() ? nullptr : slot->providers.back().asset;
+      slot->asset.store( asset, std::memory_order_release );
+    }
+  };
+
+  struct StaticData
+  {
+    AssetSlots<core::render::Mesh>    meshes;
+    AssetSlots<core::render::Texture> textures;
+  };
+
+  StaticData* sData = nullptr;
+} // namespace
+
+
+Status data::initializeAssetIndex()
+{
+  sData = new StaticData();
+  return StatusOk;
+}
+
+void data::destroyAssetIndex()
+{
+  delete sData;
+}
+
+MeshHandle data::findMesh( StringId id )
+{
+  return MeshHandle( sData->meshes.getOrAdd( id ) );
+}
+
+TextureHandle data::findTexture( StringId id )
+{
+  return TextureHandle( sData->textures.getOrAdd( id ) );
+}
+
+void data::registerMesh( StringId id, StringId chunkId, core::render::Mesh* mesh )
+{
+  sData->meshes.add( id, chunkId, mesh );
+}
+
+void data::registerTexture( StringId id, StringId chunkId, core::render::Texture* texture )
+{
+  sData->textures.add( id, chunkId, texture );
+}
+
+void data::unregisterMesh( StringId id, StringId chunkId )
+{
+  sData->meshes.remove( id, chunkId );
+}
+
+void data::unregisterTexture( StringId id, StringId chunkId )
+{
+  sData->textures.remove( id, chunkId );
+}
@@ -0,0 +1,58 @@
+#pragma once
+#include "core/common.hpp"
+#include "core/render/data.hpp"
+#include <atomic>
+
+namespace core::data
+{
+  // slots are never removed from index, so handles to them stay valid for the whole run.
+  // asset pointer is set when render chunk with asset finishes loading and reset when last chunk with it is evicted.
+  // scenes are built on workers, so slots are looked up there while main thread registers chunks
+  template<typename TAsset>
+  struct AssetSlot
+  {
+    struct Provider
+    {
+      StringId chunkId;
+      TAsset*  asset;
+    };
+
+    StringId              id;
+    std::vector<Provider> providers; // resident chunks with asset, last registered provides it. main thread only
+    std::atomic<TAsset*>  asset = nullptr;
+  };
+
+  template<typename TAsset>
+  class AssetHandle
+  {
+    const AssetSlot<TAsset>* slot_ = nullptr;
+
+  public:
+    AssetHandle() = default;
+    explicit AssetHandle( const AssetSlot<TAsset>* slot )
+        : slot_( slot )
+    {}
+
+    bool     isValid() const { return slot_; }
+    bool     isResident() const { return get(); }
+    TAsset*  get() const { return slot_ ? slot_->asset.load( std::memory_order_acquire ) : nullptr; }
+    StringId getId() const { return slot_ ? slot_->id : StringId(); }
+  };
+
+  using MeshHandle    = AssetHandle<core::render::Mesh>;
+  using TextureHandle = AssetHandle<core::render::Texture>;
+
+  Status initializeAssetIndex();
+  void   destroyAssetIndex();
+
+  // slot is created on first request, so handle can be taken before asset is loaded. any thread
+  MeshHandle    findMesh( StringId id );
+  TextureHandle findTexture( StringId id );
+
+  void registerMesh( StringId id, StringId chunkId, core::render::Mesh* mesh );
+  void registerTexture( StringId id, StringId chunkId, core::render::Texture* texture );
+
+  // asset falls back to another resident chunk which has it, if there is one
+  void unregisterMesh( StringId id, StringId chunkId );
+  void unregisterTexture( StringId id, StringId chunkId );
+} // namespace core::data
@@ -3,7 +3,7 @@
 #include "core/render/data.hpp"
 #include "core/system/message-queue.hpp"
 #include "core/system/time.hpp"
-#include "core/fs/file.hpp"
+#include "core/fs/fs.hpp"
 #include "core/core.hpp"
 
 using namespace core;
@@ -13,8 +13,10 @@ namespace
 {
   struct StaticData
   {
-    stdfs::path              dataDirectory;
-    StringIdMap<std::string> idsToFiles;
+    stdfs::path       dataDirectory;
+    Manifest          manifest;
+    bool              devMode = false;
+    RenderChunkBudget renderChunkBudget;
   };
 
   StaticData* sData = nullptr;
@@ -37,6 +39,31 @@ namespace
     object.at( "gameData" ).get_to( gameData );
     sData->dataDirectory = projectConfigPath.parent_path() / gameData;
 
+    // optional: data directory may be used without manifest
+    if( auto it = object.find( "devMode" ); it != object.end() )
+      sData->devMode = it->get<bool>();
+
+    // optional: render chunk cache budget in megabytes
+    if( auto it = object.find( "renderChunkCpuBudgetMb" ); it != object.end() )
+      sData->renderChunkBudget.cpuBytes = it->get<u64>() << 20;
+    if( auto it = object.find( "renderChunkGpuBudgetMb" ); it != object.end() )
+      sData->renderChunkBudget.gpuBytes = it->get<u64>() << 20;
+
+    // optional: heap budgets in megabytes by memory tag, like { "Data": 512 }
+    if( auto it = object.find( "memoryBudgetsMb" ); it != object.end() )
+    {
+      for( const auto& [name, budget]: it->items() )
+      {
+        auto tag = system::memory::MemoryTag();
+        if( !system::memory::fromString( name, tag ) )
+        {
+          core::setErrorDetails( "unknown memory tag '%s' in project config", name.c_str() );
+          return StatusBadFile;
+        }
+        system::memory::setBudget( tag, budget.get<u64>() << 20 );
+      }
+    }
+
     auto entryInfo = fs::EntryInfo();
     if( auto status = fs::getEntryInfo( sData->dataDirectory, entryInfo );
         status != StatusOk || entryInfo.type != fs::FsEntryTypeDirectory )
@@ -49,63 +76,28 @@ namespace
   }
 
 
-  // is this FS related?
-  Status makeIdsToFiles()
+  // cold start does not depend on size of data directory: manifest is only mapped.
+  // without manifest directory is walked, which is allowed in dev mode only
+  Status initializeManifest()
   {
-    auto ec = std::error_code();
-    auto it = stdfs::recursive_directory_iterator( sData->dataDirectory, ec );
-    if( ec )
+    auto manifestPath = getDataPath( sManifestName );
+    if( stdfs::exists( manifestPath ) )
     {
-      core::setErrorDetails( "makeIdsToFiles: recursive directory iterator: %s", ec.message().c_str() );
-      return StatusSystemError;
+      mCoreCheckStatus( sData->manifest.open( manifestPath ) );
+      mCoreLog( "data manifest: " mFmtSize " files\n", sData->manifest.getEntryCount() );
+      return StatusOk;
     }
 
-    do {
-      if( it->path().filename().string().starts_with( "." ) )
-      {
-        it.disable_recursion_pending();
-      }
-      else
-      {
-        bool isRegularFile = it->is_regular_file( ec );
-        if( ec )
-        {
-          core::setErrorDetails( "makeIdsToFiles: is regular file: %s", ec.message().c_str() );
-          return StatusSystemError;
-        }
-
-        if( isRegularFile )
-        {
-          auto relative = stdfs::relative( it->path(), sData->dataDirectory, ec );
-          if( ec )
-          {
-            core::setErrorDetails( "makeIdsToFiles: relative: %s", ec.message().c_str() );
-            return StatusSystemError;
-          }
-
-          auto path = relative.string();
-          std::ranges::replace( path, '\\', '/' );
-          auto id = StringId( path );
-          mCoreLog( "makeIdsToFiles: " mFmtStringHash " -> %s\n", id.getHash(), path.c_str() );
-
-          if( sData->idsToFiles.contains( id ) )
-          {
-            core::setErrorDetails( "makeIdsToFiles: already contains same id: %s (" mFmtStringHash ")", path.c_str(), id.getHash() );
-            return StatusSystemError;
-          }
-
-          sData->idsToFiles.emplace_unique( id, std::move( path ) );
-        }
-      }
-
-      it.increment( ec );
-      if( ec )
-      {
-        core::setErrorDetails( "makeIdsToFiles: increment directory iterator: %s", ec.message().c_str() );
-        return StatusSystemError;
-      }
-    } while( it != stdfs::recursive_directory_iterator() );
+    if( !sData->devMode )
+    {
+      core::setErrorDetails( "data manifest is not found, run scene-tool or enable devMode in project config" );
+      return StatusNotFound;
+    }
 
+    auto stopwatch = system::Stopwatch();
+    mCoreCheckStatus( sData->manifest.build( sData->dataDirectory ) );
+    mCoreLog( "no data manifest, data directory walked: " mFmtSize " files in " mFmtU64 "ms\n",
+              sData->manifest.getEntryCount(), stopwatch.getMs() );
     return StatusOk;
   }
 } // namespace
@@ -113,29 +105,59 @@ namespace
 
 Status data::initialize()
 {
+  mCoreMemoryScope( Data );
   sData = new StaticData();
+  mCoreCheckStatus( fs::initAsyncIo() );
   mCoreCheckStatus( parseProjectConfig() );
-  mCoreCheckStatus( makeIdsToFiles() );
+  mCoreCheckStatus( initializeManifest() );
+
+  if( auto packPath = getDataPath( sPackName ); stdfs::exists( packPath ) )
+    mCoreCheckStatus( fs::mountPack( packPath.c_str(), sData->dataDirectory ) );
+
+  if( auto dictionariesPath = getDataPath( sCompressionDictionariesName ); stdfs::exists( dictionariesPath ) )
+    mCoreCheckStatus( fs::loadDictionaries( dictionariesPath ) );
+
+  mCoreCheckStatus( initializeAssetIndex() );
+  mCoreCheckStatus( initializeLoadScheduler() );
   mCoreCheckStatus( initializeRenderChunk() );
+  setRenderChunkBudget( sData->renderChunkBudget );
   return StatusOk;
 }
 
 void data::destroy()
 {
+  // reads in flight complete into render chunks, their decoding goes to workers
+  fs::destroyAsyncIo();
+  system::task::wait();
   destroyRenderChunk();
+  destroyLoadScheduler();
+  destroyAssetIndex();
+  fs::unloadDictionaries();
+  fs::unmountPack();
   delete sData;
 }
 
 void data::update()
 {
+  mCoreMemoryScope( Data );
+  // chunk priorities follow their requesters, so they are updated before queue is sorted
   updateRenderChunk();
+  updateLoadScheduler();
+}
+
+bool data::hasDataPath( StringId id )
+{
+  return sData->manifest.find( id );
 }
 
 std::string data::getDataPath( StringId id )
 {
-  assert( sData->idsToFiles.contains( id ) );
-  auto relativePath = sData->idsToFiles.get_or_return_default( id );
-  return ( sData->dataDirectory / relativePath ).string();
+  auto* entry = sData->manifest.find( id );
+  assert( entry );
+  if( !entry )
+    return sData->dataDirectory.string();
+
+  return ( sData->dataDirectory / sData->manifest.getPath( *entry ) ).string();
 }
 
 std::string data::getDataPath( const stdfs::path& resourceName )
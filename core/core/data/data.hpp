@@ -1,10 +1,20 @@
 #pragma once
 #include "core/common.hpp"
+#include "core/data/asset-index.hpp"
+#include "core/data/load-scheduler.hpp"
+#include "core/data/manifest.hpp"
 #include "core/data/render-chunk.hpp"
 #include "core/data/serialization.hpp"
 
 namespace core::data
 {
+  // zstd dictionaries trained by scene-tool, optional. starts with dot, so it is not an asset
+  inline constexpr const char* sCompressionDictionariesName = ".zstd-dictionaries";
+
+  // all assets in one file, written by scene-tool with -pack. without it assets are read as loose files
+  inline constexpr const char* sPackName = ".data.pack";
+
+  bool               hasDataPath( StringId id );
   std::string        getDataPath( StringId id );
   std::string        getDataPath( const stdfs::path& resourceName );
   inline std::string getDataPath( const char* resourceName ) { return getDataPath( stdfs::path( resourceName ) ); }
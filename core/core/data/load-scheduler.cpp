@@ -0,0 +1,160 @@
+#include "core/data/load-scheduler.hpp"
+#include "core/core.hpp"
+
+using namespace core;
+using namespace core::data;
+
+
+namespace
+{
+  constexpr u32 sDefaultQueueDepth = 8;
+
+  struct StaticData
+  {
+    std::vector<LoadJob> queue; // sorted by priority on update, in order of scheduling inside one class
+    u32                  queueDepth = sDefaultQueueDepth;
+    LoadSchedulerStats   stats;
+    std::atomic<u64>     wastedBytes = 0; // added from worker threads
+  };
+
+  StaticData* sData = nullptr;
+
+
+  void dispatchLoad( LoadJob& job )
+  {
+    // job may finish right in start, so it is counted before
+    sData->stats.inFlight++;
+    job.start();
+  }
+
+  void updateQueueStats()
+  {
+    sData->stats.queued    = static_cast<u32>( sData->queue.size() );
+    sData->stats.maxQueued = std::max( sData->stats.maxQueued, sData->stats.queued );
+  }
+} // namespace
+
+
+LoadToken::LoadToken( LoadPriority priority )
+    : data_( std::make_shared<LoadTokenData>() )
+{
+  data_->priority = priority;
+}
+
+system::task::TaskPriority LoadToken::getTaskPriority() const
+{
+  return getPriority() == LoadPriority_Prefetch ? system::task::TaskPriorityLow : system::task::TaskPriorityNormal;
+}
+
+
+Status data::initializeLoadScheduler()
+{
+  sData = new StaticData();
+  return StatusOk;
+}
+
+void data::destroyLoadScheduler()
+{
+  delete sData;
+}
+
+void data::updateLoadScheduler()
+{
+  // jobs are moved out of queue before callbacks, which may schedule new loads
+  auto cancelled = system::FrameVector<LoadJob>();
+  auto ready     = system::FrameVector<LoadJob>();
+
+  // nobody waits for cancelled jobs, they don't take place in queue
+  auto it = std::ranges::stable_partition( sData->queue, []( const LoadJob& job ) { return !job.token.isCancelled(); } ).begin();
+  std::ranges::move( it, sData->queue.end(), std::back_inserter( cancelled ) );
+  sData->queue.erase( it, sData->queue.end() );
+
+  // requesters change priorities at any moment, so order is evaluated each frame
+  std::ranges::stable_sort( sData->queue, std::less{}, []( const LoadJob& job ) { return job.token.getPriority(); } );
+
+  it = sData->queue.begin();
+  for( ; it != sData->queue.end(); ++it )
+  {
+    if( sData->stats.inFlight + ready.size() >= sData->queueDepth && it->token.getPriority() != LoadPriority_Blocking )
+      break;
+    ready.push_back( std::move( *it ) );
+  }
+  sData->queue.erase( sData->queue.begin(), it );
+  updateQueueStats();
+
+  for( auto& job: cancelled )
+  {
+    sData->stats.classes[job.token.getPriority()].cancelled++;
+    job.onCancel();
+  }
+
+  for( auto& job: ready )
+    dispatchLoad( job );
+}
+
+void data::scheduleLoad( LoadJob job )
+{
+  if( job.token.getPriority() == LoadPriority_Blocking )
+  {
+    dispatchLoad( job );
+    return;
+  }
+
+  sData->queue.push_back( std::move( job ) );
+  updateQueueStats();
+}
+
+void data::finishLoad( const LoadToken& token, Status status )
+{
+  assert( sData->stats.inFlight > 0 );
+  sData->stats.inFlight--;
+
+  auto& stats = sData->stats.classes[token.getPriority()];
+  if( status == StatusCancelled )
+  {
+    stats.cancelled++;
+  }
+  else if( status != StatusOk )
+  {
+    stats.failed++;
+  }
+  else
+  {
+    f32 latencyMs = token.getLatencyMs();
+    stats.completed++;
+    stats.totalLatencyMs += latencyMs;
+    stats.maxLatencyMs = std::max( stats.maxLatencyMs, latencyMs );
+  }
+}
+
+void data::addLoadWastedBytes( u64 bytes )
+{
+  sData->wastedBytes.fetch_add( bytes, std::memory_order_relaxed );
+}
+
+void data::setLoadQueueDepth( u32 depth )
+{
+  mCoreLog( "load queue depth: " mFmtU32 "\n", depth );
+  sData->queueDepth = std::max( depth, 1u );
+}
+
+const LoadSchedulerStats& data::getLoadSchedulerStats()
+{
+  sData->stats.wastedBytes = sData->wastedBytes.load( std::memory_order_relaxed );
+  return sData->stats;
+}
+
+void data::logLoadSchedulerStats()
+{
+  const auto& stats = getLoadSchedulerStats();
+  mCoreLog( "load scheduler: queued " mFmtU32 " (max " mFmtU32 "), in flight " mFmtU32 ", wasted " mFmtU64 " bytes\n",
+            stats.queued, stats.maxQueued, stats.inFlight, stats.wastedBytes );
+
+  for( u32 i = 0; i < sLoadPriorityCount; ++i )
+  {
+    const auto& s = stats.classes[i];
+    mCoreLog( "  %-11s completed " mFmtU64 ", cancelled " mFmtU64 ", failed " mFmtU64 ", latency avg %.1fms max %.1fms\n",
+              toString( static_cast<LoadPriority>( i ) ), s.completed, s.cancelled, s.failed,
+              s.getAverageLatencyMs(), static_cast<f64>( s.maxLatencyMs ) );
+  }
+}
@@ -0,0 +1,87 @@
+#pragma once
+#include "core/common.hpp"
+#include "core/system/task.hpp"
+#include "core/system/time.hpp"
+
+namespace core::data
+{
+#define xLoadPriorityEnum( X )   \
+  X( LoadPriority, Blocking )    \
+  X( LoadPriority, VisibleSoon ) \
+  X( LoadPriority, Prefetch )
+
+  // in order of importance: blocking is needed for current frame (loading screen is shown),
+  // visible soon is behind nearby portal, prefetch is a guess
+  mCoreDeclareEnum( LoadPriority, xLoadPriorityEnum );
+
+  inline constexpr u32 sLoadPriorityCount = LoadPriority_Prefetch + 1;
+
+
+  // shared by requester and all stages of load. requester cancels or changes priority at any moment,
+  // stages check it between steps (read, decode, upload) and drop what they have as soon as it is cancelled
+  class LoadToken
+  {
+    struct LoadTokenData
+    {
+      std::atomic<bool>         cancelled = false;
+      std::atomic<LoadPriority> priority;
+      system::Stopwatch         requested; // for latency of whole load
+    };
+
+    std::shared_ptr<LoadTokenData> data_;
+
+  public:
+    explicit LoadToken( LoadPriority priority = LoadPriority_Blocking );
+
+    void         cancel() { data_->cancelled = true; }
+    bool         isCancelled() const { return data_->cancelled; }
+    void         setPriority( LoadPriority priority ) { data_->priority = priority; }
+    LoadPriority getPriority() const { return data_->priority; }
+    f32          getLatencyMs() const { return data_->requested.getMsF(); }
+
+    system::task::TaskPriority getTaskPriority() const;
+
+    bool operator==( const LoadToken& other ) const { return data_ == other.data_; }
+  };
+
+
+  struct LoadClassStats
+  {
+    u64 completed      = 0;
+    u64 cancelled      = 0;
+    u64 failed         = 0;
+    f64 totalLatencyMs = 0; // of completed
+    f32 maxLatencyMs   = 0;
+
+    f64 getAverageLatencyMs() const { return completed ? totalLatencyMs / static_cast<f64>( completed ) : 0.0; }
+  };
+
+  struct LoadSchedulerStats
+  {
+    LoadClassStats classes[sLoadPriorityCount]; // by priority load had when it finished
+    u32            queued      = 0;             // waiting for dispatch
+    u32            inFlight    = 0;
+    u32            maxQueued   = 0;
+    u64            wastedBytes = 0; // read, decoded or uploaded by loads which were cancelled afterwards
+  };
+
+  struct LoadJob
+  {
+    LoadToken                       token;
+    std::move_only_function<void()> start;    // on main thread, job must call finishLoad when it is done
+    std::move_only_function<void()> onCancel; // on main thread, instead of start when job is cancelled in queue
+  };
+
+  Status initializeLoadScheduler();
+  void   destroyLoadScheduler();
+  void   updateLoadScheduler(); // drops cancelled jobs, dispatches queued ones by their current priority
+
+  // blocking jobs are dispatched right away, others wait while queue depth is reached
+  void scheduleLoad( LoadJob job );
+  void finishLoad( const LoadToken& token, Status status );
+  void addLoadWastedBytes( u64 bytes ); // thread safe
+
+  void                      setLoadQueueDepth( u32 depth );
+  const LoadSchedulerStats& getLoadSchedulerStats();
+  void                      logLoadSchedulerStats();
+} // namespace core::data
@@ -0,0 +1,189 @@
+#include "core/data/manifest.hpp"
+
+using namespace core;
+using namespace core::data;
+
+
+namespace
+{
+  struct WalkEntry
+  {
+    StringId    id;
+    std::string path;
+    u64         size;
+    u64         contentHash;
+  };
+
+  Status walkDirectory( const stdfs::path& directory, const ManifestFileHasher& hashFile, std::vector<WalkEntry>& out )
+  {
+    auto ec = std::error_code();
+    auto it = stdfs::recursive_directory_iterator( directory, ec );
+    if( ec )
+    {
+      core::setErrorDetails( "buildManifest: recursive directory iterator: %s", ec.message().c_str() );
+      return StatusSystemError;
+    }
+
+    // iterator turns into end on error, it is checked after loop
+    for( ; it != stdfs::recursive_directory_iterator(); it.increment( ec ) )
+    {
+      if( it->path().filename().string().starts_with( "." ) )
+      {
+        it.disable_recursion_pending();
+        continue;
+      }
+
+      bool isRegularFile = it->is_regular_file( ec );
+      if( ec )
+      {
+        core::setErrorDetails( "buildManifest: is regular file: %s", ec.message().c_str() );
+        return StatusSystemError;
+      }
+      if( !isRegularFile )
+        continue;
+
+      auto relative = stdfs::relative( it->path(), directory, ec );
+      if( ec )
+      {
+        core::setErrorDetails( "buildManifest: relative: %s", ec.message().c_str() );
+        return StatusSystemError;
+      }
+
+      u64 size = it->file_size( ec );
+      if( ec )
+      {
+        core::setErrorDetails( "buildManifest: file size: %s", ec.message().c_str() );
+        return StatusSystemError;
+      }
+
+      auto path = relative.string();
+      std::ranges::replace( path, '\\', '/' );
+      out.push_back( WalkEntry{
+          .id          = StringId( path ),
+          .path        = std::move( path ),
+          .size        = size,
+          .contentHash = hashFile ? hashFile( it->path() ) : 0,
+      } );
+    }
+
+    if( ec )
+    {
+      core::setErrorDetails( "buildManifest: increment directory iterator: %s", ec.message().c_str() );
+      return StatusSystemError;
+    }
+
+    return StatusOk;
+  }
+} // namespace
+
+
+Status data::buildManifest( const stdfs::path& directory, std::vector<byte>& output, const ManifestFileHasher& hashFile )
+{
+  auto walkEntries = std::vector<WalkEntry>();
+  mCoreCheckStatus( walkDirectory( directory, hashFile, walkEntries ) );
+
+  std::ranges::sort( walkEntries, {}, &WalkEntry::id );
+  for( size_t i = 1; i < walkEntries.size(); ++i )
+  {
+    if( walkEntries[i].id == walkEntries[i - 1].id )
+    {
+      core::setErrorDetails( "buildManifest: '%s' and '%s' have the same id (" mFmtStringHash ")",
+                             walkEntries[i - 1].path.c_str(), walkEntries[i].path.c_str(), walkEntries[i].id.getHash() );
+      return StatusSystemError;
+    }
+  }
+
+  auto header = ManifestHeader{
+      .magic      = ManifestHeader::sMagic,
+      .version    = ManifestHeader::sVersion,
+      .entryCount = static_cast<u32>( walkEntries.size() ),
+      .reserved   = 0,
+  };
+
+  auto entries = std::vector<ManifestEntry>();
+  auto paths   = std::string();
+  entries.reserve( walkEntries.size() );
+
+  for( const auto& walkEntry: walkEntries )
+  {
+    entries.push_back( ManifestEntry{
+        .id          = walkEntry.id.getHash(),
+        .pathOffset  = static_cast<u32>( paths.size() ),
+        .pathSize    = static_cast<u32>( walkEntry.path.size() ),
+        .size        = walkEntry.size,
+        .contentHash = walkEntry.contentHash,
+    } );
+    paths += walkEntry.path;
+  }
+
+  auto append = [&output]( const void* source, size_t size ) {
+    auto bytes = static_cast<const byte*>( source );
+    output.insert( output.end(), bytes, bytes + size );
+  };
+
+  output.clear();
+  append( &header, sizeof( header ) );
+  append( entries.data(), entries.size() * sizeof( ManifestEntry ) );
+  append( paths.data(), paths.size() );
+  return StatusOk;
+}
+
+
+Status Manifest::attach( std::span<const byte> bytes, const char* name )
+{
+  auto header = ManifestHeader();
+  if( bytes.size() < sizeof( header ) )
+  {
+    core::setErrorDetails( "manifest '%s' is truncated", name );
+    return StatusBadFile;
+  }
+
+  memcpy( &header, bytes.data(), sizeof( header ) );
+  if( header.magic != ManifestHeader::sMagic || header.version != ManifestHeader::sVersion )
+  {
+    core::setErrorDetails( "manifest '%s' has unknown format or version", name );
+    return StatusBadFile;
+  }
+
+  u64 pathsOffset = sizeof( header ) + u64( header.entryCount ) * sizeof( ManifestEntry );
+  if( pathsOffset > bytes.size() )
+  {
+    core::setErrorDetails( "manifest '%s' is truncated", name );
+    return StatusBadFile;
+  }
+
+  entries_ = { reinterpret_cast<const ManifestEntry*>( bytes.data() + sizeof( header ) ), header.entryCount };
+  paths_   = { reinterpret_cast<const char*>( bytes.data() + pathsOffset ), bytes.size() - pathsOffset };
+
+  // paths are pooled in order of entries, so the last one ends pool
+  if( !entries_.empty() && u64( entries_.back().pathOffset ) + entries_.back().pathSize > paths_.size() )
+  {
+    core::setErrorDetails( "manifest '%s' is truncated", name );
+    return StatusBadFile;
+  }
+
+  return StatusOk;
+}
+
+Status Manifest::open( const std::string& path )
+{
+  file_ = fs::MappedFile( path.c_str() );
+  if( !file_.isOpen() )
+    return StatusNotFound;
+
+  return attach( file_.getBytes(), path.c_str() );
+}
+
+Status Manifest::build( const stdfs::path& directory )
+{
+  mCoreCheckStatus( buildManifest( directory, built_ ) );
+  return attach( built_, "built in memory" );
+}
+
+const ManifestEntry* Manifest::find( StringId id ) const
+{
+  auto it = std::ranges::lower_bound( entries_, id.getHash(), {}, &ManifestEntry::id );
+  if( it == entries_.end() || it->id != id.getHash() )
+    return nullptr;
+  return &*it;
+}
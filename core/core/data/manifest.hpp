@@ -0,0 +1,60 @@
+#pragma once
+#include "core/common.hpp"
+#include "core/fs/file.hpp"
+
+namespace core::data
+{
+  // index of data directory, written by scene-tool. starts with dot, so it is not an asset
+  inline constexpr const char* sManifestName = ".manifest";
+
+  // manifest layout: header, entries sorted by id, pool of paths (relative to data directory, '/' separated)
+  struct ManifestHeader
+  {
+    static constexpr u32 sMagic   = 0x464D4853; // SHMF
+    static constexpr u32 sVersion = 1;
+
+    u32 magic;
+    u32 version;
+    u32 entryCount;
+    u32 reserved;
+  };
+
+  struct ManifestEntry
+  {
+    StringHash id; // of path
+    u32        pathOffset;
+    u32        pathSize;
+    u64        size;
+    u64        contentHash; // 0 if it was not asked for
+  };
+
+  static_assert( sizeof( ManifestHeader ) % alignof( ManifestEntry ) == 0 );
+  static_assert( sizeof( ManifestEntry ) == 32 );
+
+  using ManifestFileHasher = std::function<u64( const stdfs::path& path )>;
+
+  // walks directory, files and directories starting with dot are skipped
+  Status buildManifest( const stdfs::path& directory, std::vector<byte>& output, const ManifestFileHasher& hashFile = {} );
+
+
+  // lookups are binary searches over mapped file, nothing is parsed on open
+  class Manifest
+  {
+    fs::MappedFile                 file_;
+    std::vector<byte>              built_; // when manifest is built in memory instead of mapped
+    std::span<const ManifestEntry> entries_;
+    std::string_view               paths_;
+
+    Status attach( std::span<const byte> bytes, const char* name );
+
+  public:
+    Status open( const std::string& path );
+    Status build( const stdfs::path& directory );
+
+    const ManifestEntry* find( StringId id ) const;
+    std::string_view     getPath( const ManifestEntry& entry ) const { return paths_.substr( entry.pathOffset, entry.pathSize ); }
+    size_t               getEntryCount() const { return entries_.size(); }
+
+    std::span<const ManifestEntry> getEntries() const { return entries_; }
+  };
+} // namespace core::data
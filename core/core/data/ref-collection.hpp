@@ -96,6 +96,7 @@ namespace core::data
     Iterator      end() { return Iterator( collection_.end() ); }
     ConstIterator cbegin() { return ConstIterator( collection_.begin() ); }
     ConstIterator cend() { return ConstIterator( collection_.end() ); }
+    TItem&        back() { return collection_.back().item; }
 
     RefCounter add( TItem item )
     {
@@ -110,13 +111,21 @@ namespace core::data
       return RefCounter( &origin.mainRef );
     }
 
-    void cleanup( std::function<void( TItem& )> onRemove )
+    u32 getRefCount( const TItem& item ) const
+    {
+      const auto& origin = reinterpret_cast<const RefOrigin&>( item );
+      return origin.mainRef.count;
+    }
+
+    // removes only items without references for which predicate returns true
+    void cleanupIf( std::function<bool( TItem& )> predicate, std::function<void( TItem& )> onRemove )
     {
       for( auto it = collection_.begin(); it != collection_.end(); )
       {
         auto cur = it++;
         if( cur != collection_.end() &&
-            cur->mainRef.count == 0 )
+            cur->mainRef.count == 0 &&
+            predicate( cur->item ) )
         {
           onRemove( cur->item );
           collection_.erase( cur );
@@ -124,6 +133,11 @@ namespace core::data
       }
     }
 
+    void cleanup( std::function<void( TItem& )> onRemove )
+    {
+      cleanupIf( []( auto& ) { return true; }, std::move( onRemove ) );
+    }
+
     void cleanup()
     {
       cleanup( []( auto& ) {} );
@@ -1,5 +1,6 @@
 #include "core/data/render-chunk.hpp"
 #include "core/data/ref-collection.hpp"
+#include "core/data/asset-index.hpp"
 #include "core/render/data.hpp"
 #include "core/core.hpp"
 
@@ -25,6 +26,17 @@ namespace core::data
   {
     StringId id;
     bool     loading;
+    Status   loadStatus = StatusOk;
+    bool     registered = false; // assets are in asset index, only chunk which completed load puts them there
+
+    // load is cancelled when all requesters are cancelled, priority is the highest of them
+    LoadToken              load;
+    std::vector<LoadToken> requesters;
+
+    // residency
+    u64 cpuBytes     = 0;
+    u64 gpuBytes     = 0;
+    u64 releasedTick = 0; // when last reference was released, 0 while in use
 
     std::list<std::move_only_function<void( Status )>> loadCallbacks;
 
@@ -38,151 +50,407 @@ namespace
   struct StaticData
   {
     SimpleRefCollection<RenderChunkData> renderChunks;
+    StringIdMap<RenderChunkData*>        renderChunksIndex; // list items don't move, so pointers are stable
+    RenderChunkBudget                    budget;
+    RenderChunkStats                     stats;
+    RenderChunkReader                    reader;
+    u64                                  releaseTick = 0;
   };
 
   StaticData* sData = nullptr;
 
 
-  cti::continuable<data::schema::Chunk> readChunkAsync( StringId id )
+  std::expected<data::schema::Chunk, Status> decodeChunk( std::span<const byte> encoded )
   {
-    return system::task::ctiAsync( [id]() -> std::expected<data::schema::Chunk, Status> {
-      auto path      = data::getDataPath( id );
-      auto objHandle = msgpack::object_handle();
-      auto obj       = msgpack::object();
+    mCoreProfileScope( "decode chunk" );
+    mCoreMemoryScope( Data );
+    auto objHandle = msgpack::object_handle();
+    auto obj       = msgpack::object();
 
-      if( auto s = fs::readFileMsgpackCompressed( path.c_str(), obj, objHandle ); s != StatusOk )
-        return std::unexpected( s );
+    if( auto s = fs::decodeMsgpackCompressed( encoded, obj, objHandle ); s != StatusOk )
+      return std::unexpected( s );
 
-      try
-      {
-        auto chunkImport = data::schema::Chunk();
-        obj.convert( chunkImport );
-        return { std::move( chunkImport ) };
-      }
-      catch( const std::exception& ex )
+    try
+    {
+      auto chunkImport = data::schema::Chunk();
+      obj.convert( chunkImport );
+      return { std::move( chunkImport ) };
+    }
+    catch( const std::exception& ex )
+    {
+      std::string exceptionMessage = ex.what();
+      core::setErrorDetails( "exception while decoding render chunk: %s", exceptionMessage.c_str() );
+      return std::unexpected( StatusSystemError );
+    }
+  }
+
+  // file is read by async io, so no worker waits for disk. only decoding goes to workers.
+  // token is checked between stages: buffers of cancelled load are released right away
+  cti::continuable<data::schema::Chunk> readChunkAsync( StringId id, LoadToken token )
+  {
+    return fs::ctiReadFile( data::getDataPath( id ) ).then( [token]( fs::FileBytes file ) -> cti::continuable<data::schema::Chunk> {
+      if( token.isCancelled() )
       {
-        std::string exceptionMessage = ex.what();
-        core::setErrorDetails( "exception while decoding render chunk: %s", exceptionMessage.c_str() );
-        return std::unexpected( StatusSystemError );
+        data::addLoadWastedBytes( file.getBytes().size() );
+        return cti::make_exceptional_continuable<data::schema::Chunk>( StatusCancelled );
       }
+
+      return system::task::ctiAsync( [file = std::move( file ), token]() -> std::expected<data::schema::Chunk, Status> {
+        if( !token.isCancelled() )
+        {
+          auto chunk = decodeChunk( file.getBytes() );
+          if( !chunk || !token.isCancelled() )
+            return chunk;
+        }
+
+        data::addLoadWastedBytes( file.getBytes().size() );
+        return std::unexpected( StatusCancelled );
+      },
+                                     token.getTaskPriority() );
     } );
   }
 
-  cti::continuable<None> uploadTextureToGPU( data::schema::Texture  texture,
-                                             data::RenderChunkData* data )
+  // adds uploaded asset to chunk on main thread, which owns it. chunk may be already destroyed when this runs
+  // for cancelled load, so token is checked before touching it. asset of cancelled load was never registered,
+  // but render thread owns device context, so it is released there
+  template<typename T>
+  cti::continuable<None> addUploaded( T uploaded, StringId id, u64 gpuBytes, data::RenderChunkData* data, LoadToken token )
   {
-    return system::task::ctiDeffered( [texture = std::move( texture ), data]() -> std::expected<None, Status> {
-      auto uploadTexture = core::render::Texture();
-      uploadTexture.size = { texture.width, texture.height };
-
-      if( auto s = uploadTexture.texture.init( texture ); s != StatusOk )
+    return system::task::ctiDeffered( [uploaded = std::move( uploaded ), id, gpuBytes, data, token]() mutable -> std::expected<None, Status> {
+      if( token.isCancelled() )
       {
-        mCoreLogError( "error uploading texture\n" );
-        return std::unexpected( s );
+        core::render::destroyDeferred( std::move( uploaded ) );
+        return std::unexpected( StatusCancelled );
       }
 
-      data->textures.add( texture.id, std::move( uploadTexture ) );
+      data->gpuBytes += gpuBytes;
+      data->cpuBytes += sizeof( T );
+      sData->stats.uploadedGpuBytes += gpuBytes;
+
+      if constexpr( std::is_same_v<T, core::render::Texture> )
+        data->textures.add( id, std::move( uploaded ) );
+      else
+        data->meshes.add( id, std::move( uploaded ) );
       return None();
     } );
   }
 
+  // gpu resources are created on render thread, which owns device context
+  cti::continuable<None> uploadTextureToGPU( data::schema::Texture  texture,
+                                             data::RenderChunkData* data,
+                                             LoadToken              token )
+  {
+    auto id       = StringId( texture.id );
+    u64  gpuBytes = 0;
+    for( const auto& mip: texture.data )
+      gpuBytes += mip.mem.size();
+
+    return core::render::ctiRenderThread( [texture = std::move( texture ), token]() -> std::expected<core::render::Texture, Status> {
+             if( token.isCancelled() )
+               return std::unexpected( StatusCancelled );
+
+             mCoreProfileScope( "upload texture" );
+             mCoreMemoryScope( Data );
+             auto uploadTexture = core::render::Texture();
+             uploadTexture.size = { texture.width, texture.height };
+
+             if( auto s = uploadTexture.texture.init( texture ); s != StatusOk )
+             {
+               mCoreLogError( "error uploading texture\n" );
+               return std::unexpected( s );
+             }
+             return uploadTexture;
+           } )
+        .then( [id, gpuBytes, data, token]( core::render::Texture uploadTexture ) {
+          return addUploaded( std::move( uploadTexture ), id, gpuBytes, data, token );
+        } );
+  }
+
   cti::continuable<None> uploadMeshToGPU( data::schema::Mesh     mesh,
-                                          data::RenderChunkData* data )
+                                          data::RenderChunkData* data,
+                                          LoadToken              token )
   {
-    return system::task::ctiDeffered( [mesh = std::move( mesh ), data]() mutable -> std::expected<None, Status> {
-      auto uploadMesh = core::render::Mesh();
+    auto id       = StringId( mesh.id );
+    u64  gpuBytes = mesh.indexBuffer.size() * sizeof( mesh.indexBuffer[0] ) +
+                   mesh.vertexBuffer.size() * sizeof( mesh.vertexBuffer[0] );
+
+    return core::render::ctiRenderThread( [mesh = std::move( mesh ), token]() mutable -> std::expected<core::render::Mesh, Status> {
+             if( token.isCancelled() )
+               return std::unexpected( StatusCancelled );
+
+             mCoreProfileScope( "upload mesh" );
+             mCoreMemoryScope( Data );
+             auto uploadMesh = core::render::Mesh();
 
 #ifdef _DEBUG
-      char ibName[128] = { 0 };
-      char vbName[128] = { 0 };
-      sprintf( ibName, "ib-" mFmtStringHash, mesh.id );
-      sprintf( vbName, "ib-" mFmtStringHash, mesh.id );
+             char ibName[128] = { 0 };
+             char vbName[128] = { 0 };
+             sprintf( ibName, "ib-" mFmtStringHash, mesh.id );
+             sprintf( vbName, "ib-" mFmtStringHash, mesh.id );
 #else
-      const char* ibName = "";
-      const char* vbName = "";
+             const char* ibName = "";
+             const char* vbName = "";
 #endif
 
-      if( auto s = uploadMesh.indexBuffer.init( ibName, makeArrayBytesView( mesh.indexBuffer ) );
-          s != StatusOk )
-      {
-        mCoreLogError( "error uploading index buffer\n" );
-        return std::unexpected( s );
-      }
+             if( auto s = uploadMesh.indexBuffer.init( ibName, makeArrayBytesView( mesh.indexBuffer ) );
+                 s != StatusOk )
+             {
+               mCoreLogError( "error uploading index buffer\n" );
+               return std::unexpected( s );
+             }
+
+             if( auto s = uploadMesh.vertexBuffer.init( vbName, makeArrayBytesView( mesh.vertexBuffer ) );
+                 s != StatusOk )
+             {
+               mCoreLogError( "error uploading vertex buffer\n" );
+               return std::unexpected( s );
+             }
+             return uploadMesh;
+           } )
+        .then( [id, gpuBytes, data, token]( core::render::Mesh uploadMesh ) {
+          return addUploaded( std::move( uploadMesh ), id, gpuBytes, data, token );
+        } );
+  }
 
-      if( auto s = uploadMesh.vertexBuffer.init( vbName, makeArrayBytesView( mesh.vertexBuffer ) );
-          s != StatusOk )
-      {
-        mCoreLogError( "error uploading vertex buffer\n" );
-        return std::unexpected( s );
-      }
 
-      data->meshes.add( mesh.id, std::move( uploadMesh ) );
-      return None();
-    } );
+  RenderChunkData* findRenderChunk( StringId id )
+  {
+    auto** chunk = sData->renderChunksIndex.try_get( id );
+    return chunk ? *chunk : nullptr;
+  }
+
+  // asset maps don't change after load completes, so pointers to their values can be published
+  void registerChunkAssets( RenderChunkData& chunk )
+  {
+    for( auto& [id, mesh]: chunk.meshes.data )
+      data::registerMesh( id, chunk.id, &mesh );
+    for( auto& [id, texture]: chunk.textures.data )
+      data::registerTexture( id, chunk.id, &texture );
   }
 
+  void unregisterChunkAssets( RenderChunkData& chunk )
+  {
+    for( auto& [id, mesh]: chunk.meshes.data )
+      data::unregisterMesh( id, chunk.id );
+    for( auto& [id, texture]: chunk.textures.data )
+      data::unregisterTexture( id, chunk.id );
+  }
 
-  RenderChunkData* findRenderChunk( StringId id )
+  void completeRenderChunk( RenderChunkData& chunk )
+  {
+    chunk.loading = false;
+    chunk.requesters.clear();
+    registerChunkAssets( chunk );
+    chunk.registered = true;
+
+    for( auto&& func: chunk.loadCallbacks )
+      func( StatusOk );
+    chunk.loadCallbacks.clear();
+
+    mCoreLog( "chunk " mFmtStringHash " is fully loaded and ready!\n", chunk.id.getHash() );
+  }
+
+  void failRenderChunk( RenderChunkData& chunk, Status s )
   {
-    auto chunkIt = std::find_if( sData->renderChunks.begin(), sData->renderChunks.end(),
-                                 [=]( RenderChunkData& data ) { return data.id == id; } );
-    return chunkIt != sData->renderChunks.end() ? &*chunkIt : nullptr;
+    // uploads still queued for this chunk must not touch it
+    chunk.load.cancel();
+    chunk.loading    = false;
+    chunk.loadStatus = s;
+    chunk.requesters.clear();
+
+    // following request of the same chunk reads it again instead of getting failed one
+    if( auto** indexed = sData->renderChunksIndex.try_get( chunk.id ); indexed && *indexed == &chunk )
+      sData->renderChunksIndex.erase( chunk.id );
+
+    if( s == StatusCancelled )
+      data::addLoadWastedBytes( chunk.gpuBytes );
+
+    for( auto&& func: chunk.loadCallbacks )
+      func( s );
+    chunk.loadCallbacks.clear();
+
+    if( s == StatusCancelled )
+      mCoreLogDebug( "chunk " mFmtStringHash " load is cancelled\n", chunk.id.getHash() );
+    else
+      mCoreLogError( "chunk " mFmtStringHash " is loaded with error: %d!\n", chunk.id.getHash(), static_cast<int>( s ) );
   }
 
-  RenderChunkData& addRenderChunk( StringId id )
+  void startRenderChunkLoad( RenderChunkData* chunk )
   {
-    sData->renderChunks.add( { .id = id, .loading = true } );
-    auto chunk = findRenderChunk( id );
+    auto token = chunk->load;
 
-    readChunkAsync( id )
-        .then( [chunk]( data::schema::Chunk chunkImport ) {
+    sData->reader( chunk->id, token )
+        .then( [chunk, token]( data::schema::Chunk chunkImport ) {
           auto subtasks = std::vector<cti::continuable<None>>();
 
           for( auto&& texture: chunkImport.textures )
-            subtasks.emplace_back( uploadTextureToGPU( std::move( texture ), chunk ) );
+            subtasks.emplace_back( uploadTextureToGPU( std::move( texture ), chunk, token ) );
 
           for( auto&& mesh: chunkImport.meshes )
-            subtasks.emplace_back( uploadMeshToGPU( std::move( mesh ), chunk ) );
+            subtasks.emplace_back( uploadMeshToGPU( std::move( mesh ), chunk, token ) );
 
           return cti::when_all( std::move( subtasks ) );
         } )
-        .then( [chunk]( std::vector<None> ) { // TODO: execution context?
-          chunk->loading = false;
-
-          for( auto&& func: chunk->loadCallbacks )
-            func( StatusOk );
-          chunk->loadCallbacks.clear();
-
-          mCoreLog( "chunk " mFmtStringHash " is fully loaded and ready!\n", chunk->id.getHash() );
+        .then( [chunk, token]( std::vector<None> ) {
+          completeRenderChunk( *chunk );
+          data::finishLoad( token, StatusOk );
         } )
-        .fail( [chunk]( Status s ) {
-          chunk->loading = false;
+        .fail( [chunk, token]( Status s ) {
+          // read and decode fail on io and worker threads, chunk is owned by main thread
+          system::task::runDeffered( [chunk, token, s]() {
+            failRenderChunk( *chunk, s );
+            data::finishLoad( token, s );
+          } );
+        } );
+  }
+
+  RenderChunkData& addRenderChunk( StringId id, LoadToken token )
+  {
+    sData->renderChunks.add( {
+        .id         = id,
+        .loading    = true,
+        .load       = LoadToken( token.getPriority() ),
+        .requesters = { token },
+        .cpuBytes   = sizeof( RenderChunkData ),
+    } );
+    auto chunk = &sData->renderChunks.back();
+    sData->renderChunksIndex.emplace_unique( id, chunk );
 
-          for( auto&& func: chunk->loadCallbacks )
-            func( s );
-          chunk->loadCallbacks.clear();
+    if( token.getPriority() == LoadPriority_Prefetch )
+    {
+      // background load: let OS start reading file while request waits in queue
+      fs::adviseWillNeed( data::getDataPath( id ) );
+    }
 
-          mCoreLogError( "chunk " mFmtStringHash " is loaded with error: %d!\n",
-                         chunk->id.getHash(), static_cast<int>( s ) );
-        } );
+    data::scheduleLoad( LoadJob{
+        .token    = chunk->load,
+        .start    = [chunk]() { startRenderChunkLoad( chunk ); },
+        .onCancel = [chunk]() { failRenderChunk( *chunk, StatusCancelled ); },
+    } );
 
     return *chunk;
   }
 
-  RenderChunkData& getOrAddRenderChunk( StringId id )
+  RenderChunkData& getOrAddRenderChunk( StringId id, LoadToken token )
   {
-    auto chunkIt = std::find_if( sData->renderChunks.begin(), sData->renderChunks.end(),
-                                 [=]( RenderChunkData& data ) { return data.id == id; } );
-    return chunkIt != sData->renderChunks.end()
-               ? *chunkIt
-               : addRenderChunk( id );
+    if( auto* chunk = findRenderChunk( id ) )
+    {
+      if( chunk->loading )
+        chunk->requesters.push_back( std::move( token ) );
+
+      sData->stats.hits++;
+      return *chunk;
+    }
+
+    sData->stats.misses++;
+    return addRenderChunk( id, std::move( token ) );
+  }
+
+  // requesters which were cancelled are forgotten, chunk load follows the rest of them
+  void updateRenderChunkRequesters()
+  {
+    for( auto& chunk: sData->renderChunks )
+    {
+      if( !chunk.loading || chunk.load.isCancelled() )
+        continue;
+
+      std::erase_if( chunk.requesters, []( const LoadToken& token ) { return token.isCancelled(); } );
+      if( chunk.requesters.empty() )
+      {
+        // following request of the same chunk starts new load
+        chunk.load.cancel();
+        sData->renderChunksIndex.erase( chunk.id );
+        continue;
+      }
+
+      auto priority = std::ranges::min( chunk.requesters | std::views::transform( &LoadToken::getPriority ) );
+      chunk.load.setPriority( priority );
+    }
+  }
+
+
+  bool isOverBudget()
+  {
+    return sData->stats.residentCpuBytes > sData->budget.cpuBytes ||
+           sData->stats.residentGpuBytes > sData->budget.gpuBytes;
+  }
+
+  void updateResidencyStats()
+  {
+    auto& stats            = sData->stats;
+    stats.residentCpuBytes = 0;
+    stats.residentGpuBytes = 0;
+    stats.cachedCpuBytes   = 0;
+    stats.cachedGpuBytes   = 0;
+    stats.residentChunks   = 0;
+    stats.cachedChunks     = 0;
+
+    for( auto& chunk: sData->renderChunks )
+    {
+      if( sData->renderChunks.getRefCount( chunk ) > 0 )
+      {
+        chunk.releasedTick = 0;
+      }
+      else
+      {
+        if( !chunk.releasedTick )
+          chunk.releasedTick = ++sData->releaseTick;
+
+        stats.cachedCpuBytes += chunk.cpuBytes;
+        stats.cachedGpuBytes += chunk.gpuBytes;
+        stats.cachedChunks++;
+      }
+
+      stats.residentCpuBytes += chunk.cpuBytes;
+      stats.residentGpuBytes += chunk.gpuBytes;
+      stats.residentChunks++;
+    }
+  }
+
+  // least recently released chunk, which is not used and not loading
+  RenderChunkData* findEvictionCandidate()
+  {
+    RenderChunkData* candidate = nullptr;
+
+    for( auto& chunk: sData->renderChunks )
+    {
+      if( chunk.loading || !chunk.releasedTick )
+        continue;
+      if( !candidate || chunk.releasedTick < candidate->releasedTick )
+        candidate = &chunk;
+    }
+
+    return candidate;
+  }
+
+  void evictRenderChunk( RenderChunkData& chunk, const char* reason )
+  {
+    // cancelled or failed chunk didn't register assets, while live chunk with the same id may have
+    if( chunk.registered )
+      unregisterChunkAssets( chunk );
+
+    // cancelled chunk is already replaced in index by new load of the same id
+    if( auto** indexed = sData->renderChunksIndex.try_get( chunk.id ); indexed && *indexed == &chunk )
+      sData->renderChunksIndex.erase( chunk.id );
+
+    // render thread may still submit lists which point to chunk assets. moved maps keep their storage,
+    // so those pointers stay valid until render thread releases them
+    core::render::destroyDeferred( std::move( chunk.meshes ) );
+    core::render::destroyDeferred( std::move( chunk.textures ) );
+
+    sData->stats.evictions++;
+    sData->stats.evictedGpuBytes += chunk.gpuBytes;
+    mCoreLog( "render chunk " mFmtStringHash " evicted (%s, cpu: " mFmtU64 " gpu: " mFmtU64 " bytes, hit rate: %.2f)\n",
+              chunk.id.getHash(), reason, chunk.cpuBytes, chunk.gpuBytes,
+              static_cast<f64>( sData->stats.getHitRate() ) );
   }
 } // namespace
 
 
 Status data::initializeRenderChunk()
 {
-  sData = new StaticData();
+  sData         = new StaticData();
+  sData->reader = readChunkAsync;
   return StatusOk;
 }
 
@@ -193,41 +461,68 @@ void data::destroyRenderChunk()
 
 void data::updateRenderChunk()
 {
-  std::vector<RefCounter> pinnedRefs;
+  updateRenderChunkRequesters();
+
+  // chunks which failed to load are not worth caching
+  sData->renderChunks.cleanupIf(
+      []( RenderChunkData& chunk ) { return !chunk.loading && chunk.loadStatus != StatusOk; },
+      []( RenderChunkData& chunk ) { evictRenderChunk( chunk, chunk.loadStatus == StatusCancelled ? "load cancelled" : "load failed" ); } );
 
-  for( auto& chunk: sData->renderChunks )
+  updateResidencyStats();
+
+  // loading chunks are never evicted: pending continuations hold pointers to them
+  while( isOverBudget() )
   {
-    if( chunk.loading )
-    {
-      pinnedRefs.push_back( sData->renderChunks.getRef( chunk ) );
-    }
+    auto* candidate = findEvictionCandidate();
+    if( !candidate )
+      break;
+
+    sData->renderChunks.cleanupIf(
+        [candidate]( RenderChunkData& chunk ) { return &chunk == candidate; },
+        []( RenderChunkData& chunk ) { evictRenderChunk( chunk, "over budget" ); } );
+
+    updateResidencyStats();
   }
+}
 
-  sData->renderChunks.cleanup( []( RenderChunkData& renderChunk ) {
-    mCoreLog( "render chunk " mFmtStringHash " removed\n", renderChunk.id.getHash() );
-  } );
+void data::setRenderChunkBudget( RenderChunkBudget budget )
+{
+  mCoreLog( "render chunk budget: cpu " mFmtU64 " gpu " mFmtU64 " bytes\n", budget.cpuBytes, budget.gpuBytes );
+  sData->budget = budget;
+}
+
+void data::setRenderChunkReader( RenderChunkReader reader )
+{
+  sData->reader = std::move( reader );
+}
+
+const RenderChunkStats& data::getRenderChunkStats()
+{
+  return sData->stats;
 }
 
 
-void RenderChunk::load( StringId id )
+void RenderChunk::load( StringId id, LoadToken token )
 {
   // load is like init, only once can happen
   assert( !data_ );
   assert( ref_.empty() );
 
-  auto& chunk = getOrAddRenderChunk( id );
+  auto& chunk = getOrAddRenderChunk( id, std::move( token ) );
 
   ref_  = sData->renderChunks.getRef( chunk );
   data_ = &chunk;
 }
 
-cti::continuable<RenderChunk> RenderChunk::loadCti( StringId id )
+cti::continuable<RenderChunk> RenderChunk::loadCti( StringId id, LoadToken token )
 {
   auto result = RenderChunk();
-  result.load( id );
+  result.load( id, std::move( token ) );
 
   if( result.isLoaded() )
     return cti::make_ready_continuable<RenderChunk>( std::move( result ) );
+  if( !result.data_->loading )
+    return cti::make_exceptional_continuable<RenderChunk>( result.data_->loadStatus );
 
   auto* data = result.data_;
 
@@ -243,11 +538,16 @@ cti::continuable<RenderChunk> RenderChunk::loadCti( StringId id )
   } );
 }
 
+u64 RenderChunk::getGpuBytes() const
+{
+  return data_ ? data_->gpuBytes : 0;
+}
+
 bool RenderChunk::isLoaded() const
 {
   if( !data_ || ref_.empty() )
     return false;
-  return !data_->loading;
+  return !data_->loading && data_->loadStatus == StatusOk;
 }
 
 core::render::Mesh* RenderChunk::getMesh( StringId id )
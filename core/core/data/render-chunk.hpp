@@ -1,14 +1,48 @@
 #pragma once
 #include "core/common.hpp"
+#include "core/data/load-scheduler.hpp"
 #include "core/data/ref-collection.hpp"
+#include "core/data/schema.hpp"
 #include "core/render/data.hpp"
+#include "core/system/task.hpp"
 
 namespace core::data
 {
+  // chunks without references stay resident (in LRU order) until budget is exceeded
+  struct RenderChunkBudget
+  {
+    u64 cpuBytes = 64ull << 20;
+    u64 gpuBytes = 1024ull << 20;
+  };
+
+  struct RenderChunkStats
+  {
+    u64 hits             = 0; // requested chunk was already resident (used or cached)
+    u64 misses           = 0; // requested chunk had to be read from disk
+    u64 evictions        = 0;
+    u64 evictedGpuBytes  = 0;
+    u64 uploadedGpuBytes = 0; // all time
+    u64 residentCpuBytes = 0; // all resident chunks
+    u64 residentGpuBytes = 0;
+    u64 cachedCpuBytes   = 0; // only chunks without references
+    u64 cachedGpuBytes   = 0;
+    u32 residentChunks   = 0;
+    u32 cachedChunks     = 0;
+
+    f32 getHitRate() const { return hits + misses ? static_cast<f32>( hits ) / static_cast<f32>( hits + misses ) : 0.f; }
+  };
+
+  // reads and decodes chunk file. tests replace it to load chunks without data directory
+  using RenderChunkReader = std::move_only_function<cti::continuable<schema::Chunk>( StringId id, LoadToken token )>;
+
   Status initializeRenderChunk();
   void   destroyRenderChunk();
   void   updateRenderChunk();
 
+  void                    setRenderChunkBudget( RenderChunkBudget budget );
+  void                    setRenderChunkReader( RenderChunkReader reader );
+  const RenderChunkStats& getRenderChunkStats();
+
 
   class RenderChunk
   {
@@ -16,10 +50,14 @@ namespace core::data
     struct RenderChunkData* data_ = nullptr;
 
   public:
-    bool isLoaded() const;
-    void load( StringId id );
+    bool isLoaded() const; // load finished without error
+    u64  getGpuBytes() const;
+
+    // chunk load is shared by all requesters: it is cancelled when every requester's token is cancelled,
+    // and goes with the most important priority of them
+    void load( StringId id, LoadToken token = LoadToken( LoadPriority_VisibleSoon ) );
 
-    static cti::continuable<RenderChunk> loadCti( StringId id );
+    static cti::continuable<RenderChunk> loadCti( StringId id, LoadToken token = LoadToken( LoadPriority_VisibleSoon ) );
 
     core::render::Mesh*    getMesh( StringId id );
     core::render::Texture* getTexture( StringId id );
@@ -16,7 +16,12 @@ Status data::readJsonFile( const std::string& path, ShSceneInfo& output )
 {
   auto json = Json();
   mCoreCheckStatus( core::fs::readFileJson( path, json ) );
+  return fromJson( json, output );
+}
+
 
+Status data::fromJson( const Json& json, ShSceneInfo& output )
+{
   try
   {
     output = json.get<ShSceneInfo>();
@@ -32,13 +37,11 @@ Status data::readJsonFile( const std::string& path, ShSceneInfo& output )
 }
 
 
-Status data::writeJsonFile( const std::string& path, const ShSceneInfo& data )
+Status data::toJson( const ShSceneInfo& data, Json& output )
 {
-  Json json;
-
   try
   {
-    json = Json( data );
+    output = Json( data );
   }
   catch( const nlohmann::json::exception& ex )
   {
@@ -47,5 +50,169 @@ Status data::writeJsonFile( const std::string& path, const ShSceneInfo& data )
     return StatusSystemError;
   }
 
+  return StatusOk;
+}
+
+Status data::writeJsonFile( const std::string& path, const ShSceneInfo& data )
+{
+  Json json;
+  mCoreCheckStatus( toJson( data, json ) );
   return fs::writeFileJson( path, json );
 }
+
+
+Status data::ShBinaryScene::open( const std::string& path )
+{
+  mCoreCheckStatus( file_.open( path.c_str() ) );
+
+  auto bytes  = file_.getBytes();
+  auto header = ShBinarySceneHeader();
+  if( bytes.size() < sizeof( header ) )
+  {
+    core::setErrorDetails( "binary scene '%s' is truncated", path.c_str() );
+    return StatusBadFile;
+  }
+
+  memcpy( &header, bytes.data(), sizeof( header ) );
+  if( header.magic != ShBinarySceneHeader::sMagic || header.version != ShBinarySceneHeader::sVersion )
+  {
+    core::setErrorDetails( "binary scene '%s' has unknown format or version", path.c_str() );
+    return StatusBadFile;
+  }
+
+  u64 entitiesOffset = sizeof( header );
+  u64 chunksOffset   = entitiesOffset + u64( header.entityCount ) * sizeof( StringHash );
+  u64 blocksOffset   = chunksOffset + u64( header.renderChunkCount ) * sizeof( StringHash );
+  u64 blocksEnd      = blocksOffset + u64( header.blockCount ) * sizeof( ShBinaryComponentBlock );
+  if( blocksEnd > bytes.size() )
+  {
+    core::setErrorDetails( "binary scene '%s' is truncated", path.c_str() );
+    return StatusBadFile;
+  }
+
+  entities_     = { reinterpret_cast<const StringHash*>( bytes.data() + entitiesOffset ), header.entityCount };
+  renderChunks_ = { reinterpret_cast<const StringHash*>( bytes.data() + chunksOffset ), header.renderChunkCount };
+  blocks_       = { reinterpret_cast<const ShBinaryComponentBlock*>( bytes.data() + blocksOffset ), header.blockCount };
+
+  for( const auto& block: blocks_ )
+  {
+    if( block.entitiesOffset % alignof( u32 ) != 0 ||
+        block.entitiesOffset + u64( block.count ) * sizeof( u32 ) > bytes.size() ||
+        block.propsOffset + u64( block.count ) * block.propsSize > bytes.size() )
+    {
+      core::setErrorDetails( "binary scene '%s': component block " mFmtStringHash " is out of file", path.c_str(), block.type );
+      return StatusBadFile;
+    }
+
+    for( u32 entity: getBlockEntities( block ) )
+    {
+      if( entity >= header.entityCount )
+      {
+        core::setErrorDetails( "binary scene '%s': component block " mFmtStringHash " refers to unknown entity", path.c_str(), block.type );
+        return StatusBadFile;
+      }
+    }
+  }
+
+  return StatusOk;
+}
+
+std::span<const u32> data::ShBinaryScene::getBlockEntities( const ShBinaryComponentBlock& block ) const
+{
+  return { reinterpret_cast<const u32*>( file_.getBytes().data() + block.entitiesOffset ), block.count };
+}
+
+std::span<const byte> data::ShBinaryScene::getBlockProps( const ShBinaryComponentBlock& block, u32 index ) const
+{
+  assert( index < block.count );
+  return file_.getBytes().subspan( block.propsOffset + u64( index ) * block.propsSize, block.propsSize );
+}
+
+
+Status data::toBinary( const ShSceneInfo& data, std::vector<byte>& output )
+{
+  struct BlockBuild
+  {
+    StringHash        type;
+    u32               propsSize;
+    std::vector<u32>  entities;
+    std::vector<byte> props;
+  };
+
+  auto blocks = std::vector<BlockBuild>();
+
+  for( size_t entity = 0; entity < data.objects.size(); ++entity )
+  {
+    for( const auto& component: data.objects[entity].components )
+    {
+      auto it = std::ranges::find( blocks, component.type, &BlockBuild::type );
+      if( it == blocks.end() )
+        it = blocks.insert( blocks.end(), BlockBuild{
+                                              .type      = component.type,
+                                              .propsSize = static_cast<u32>( component.props.size() ),
+                                              .entities  = {},
+                                              .props     = {},
+                                          } );
+
+      if( component.props.empty() || component.props.size() != it->propsSize )
+      {
+        core::setErrorDetails( "component " mFmtStringHash " of entity " mFmtStringHash " has no props or props of other size",
+                               component.type, data.objects[entity].id );
+        return StatusSystemError;
+      }
+
+      it->entities.push_back( static_cast<u32>( entity ) );
+      it->props.insert( it->props.end(), component.props.begin(), component.props.end() );
+    }
+  }
+
+  auto append = [&output]( const void* source, size_t size ) {
+    auto bytes = static_cast<const byte*>( source );
+    output.insert( output.end(), bytes, bytes + size );
+  };
+  auto align = [&output]() {
+    output.resize( ( output.size() + 15 ) & ~size_t( 15 ) );
+  };
+
+  auto header = ShBinarySceneHeader{
+      .magic            = ShBinarySceneHeader::sMagic,
+      .version          = ShBinarySceneHeader::sVersion,
+      .entityCount      = static_cast<u32>( data.objects.size() ),
+      .renderChunkCount = static_cast<u32>( data.render_chunks.size() ),
+      .blockCount       = static_cast<u32>( blocks.size() ),
+      .reserved         = 0,
+  };
+
+  output.clear();
+  append( &header, sizeof( header ) );
+  for( const auto& object: data.objects )
+    append( &object.id, sizeof( object.id ) );
+  append( data.render_chunks.data(), data.render_chunks.size() * sizeof( StringHash ) );
+
+  // blocks are filled when offsets of their data are known
+  size_t blocksOffset = output.size();
+  output.resize( blocksOffset + blocks.size() * sizeof( ShBinaryComponentBlock ) );
+
+  for( size_t i = 0; i < blocks.size(); ++i )
+  {
+    auto block = ShBinaryComponentBlock{
+        .type           = blocks[i].type,
+        .count          = static_cast<u32>( blocks[i].entities.size() ),
+        .propsSize      = blocks[i].propsSize,
+        .entitiesOffset = 0,
+        .propsOffset    = 0,
+    };
+
+    align();
+    block.entitiesOffset = output.size();
+    append( blocks[i].entities.data(), blocks[i].entities.size() * sizeof( u32 ) );
+
+    align();
+    block.propsOffset = output.size();
+    append( blocks[i].props.data(), blocks[i].props.size() );
+
+    memcpy( output.data() + blocksOffset + i * sizeof( block ), &block, sizeof( block ) );
+  }
+
+  return StatusOk;
+}
@@ -1,12 +1,14 @@
 #pragma once
 #include "core/common.hpp"
+#include "core/fs/file.hpp"
 
 namespace core::data
 {
   struct ShComponent
   {
-    StringHash type;
-    Json       data;
+    StringHash        type;
+    Json              data;
+    std::vector<byte> props; // component Props as is, for binary scene. not part of json
   };
 
   struct ShObjectInfo
@@ -21,6 +23,71 @@ namespace core::data
     std::vector<StringHash>   render_chunks;
   };
 
+  template<typename TComponent>
+  ShComponent makeShComponent( const typename TComponent::Props& props )
+  {
+    static_assert( std::is_trivially_copyable_v<typename TComponent::Props> );
+    auto bytes = reinterpret_cast<const byte*>( &props );
+    return ShComponent{
+        .type  = TComponent::getComponentId(),
+        .data  = Json( props ),
+        .props = std::vector<byte>( bytes, bytes + sizeof( props ) ),
+    };
+  }
+
   Status readJsonFile( const std::string& path, ShSceneInfo& output );
   Status writeJsonFile( const std::string& path, const ShSceneInfo& data );
+  Status toJson( const ShSceneInfo& data, Json& output );
+  Status fromJson( const Json& json, ShSceneInfo& output );
+
+
+  // binary scene layout, all offsets are from file start:
+  //   header, entity ids, render chunk ids, component blocks,
+  //   then for every block: indices of its entities and props of its components, one after another.
+  // blocks are in order of first appearance of component type, entity gets its components in block order
+  struct ShBinarySceneHeader
+  {
+    static constexpr u32 sMagic   = 0x42534853; // SHSB
+    static constexpr u32 sVersion = 1;
+
+    u32 magic;
+    u32 version;
+    u32 entityCount;
+    u32 renderChunkCount;
+    u32 blockCount;
+    u32 reserved;
+  };
+
+  struct ShBinaryComponentBlock
+  {
+    StringHash type;
+    u32        count;
+    u32        propsSize;
+    u64        entitiesOffset; // u32 per component
+    u64        propsOffset;    // propsSize per component
+  };
+
+  static_assert( sizeof( ShBinarySceneHeader ) % alignof( StringHash ) == 0 );
+  static_assert( sizeof( ShBinaryComponentBlock ) == 32 );
+
+  // binary scene is read in place from mapped file (or pack), props are copied straight into components
+  class ShBinaryScene
+  {
+    fs::FileView                            file_;
+    std::span<const StringHash>             entities_;
+    std::span<const StringHash>             renderChunks_;
+    std::span<const ShBinaryComponentBlock> blocks_;
+
+  public:
+    Status open( const std::string& path );
+
+    std::span<const StringHash>             getEntities() const { return entities_; }
+    std::span<const StringHash>             getRenderChunks() const { return renderChunks_; }
+    std::span<const ShBinaryComponentBlock> getComponentBlocks() const { return blocks_; }
+    std::span<const u32>                    getBlockEntities( const ShBinaryComponentBlock& block ) const;
+    std::span<const byte>                   getBlockProps( const ShBinaryComponentBlock& block, u32 index ) const;
+  };
+
+  // components must have props (made by makeShComponent), props of the same type must be of the same size
+  Status toBinary( const ShSceneInfo& data, std::vector<byte>& output );
 } // namespace core::data
@@ -911,7 +911,7 @@ private:
                 break;
             {
 #ifdef BS_THREAD_POOL_ENABLE_PRIORITY
-                const std::move_only_function<void()> task = std::move(std::remove_const_t<pr_task&>(tasks.top()).task);
+                std::move_only_function<void()> task = std::move(const_cast<pr_task&>(tasks.top()).task);
                 tasks.pop();
 #else
                 std::move_only_function<void()> task = std::move(tasks.front());
@@ -1036,14 +1036,6 @@ private:
         friend class thread_pool;
 
     public:
-        /**
-         * @brief Construct a new task with an assigned priority by copying the task.
-         *
-         * @param task_ The task.
-         * @param priority_ The desired priority.
-         */
-        explicit pr_task(const std::move_only_function<void()>& task_, const priority_t priority_ = 0) : task(task_), priority(priority_) {}
-
         /**
          * @brief Construct a new task with an assigned priority by moving the task.
          *
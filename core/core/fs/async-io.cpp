@@ -0,0 +1,598 @@
+#include "core/fs/async-io.hpp"
+#include "core/fs/file.hpp"
+#include "core/fs/pack.hpp"
+#include "core/system/profiler.hpp"
+#include "core/system/memory.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <latch>
+
+#ifdef __linux__
+#  include <fcntl.h>
+#  include <unistd.h>
+#  include <sys/mman.h>
+#  include <sys/syscall.h>
+#  include <linux/io_uring.h>
+#endif
+
+using namespace core;
+using namespace core::fs;
+
+
+namespace
+{
+  constexpr u32 sIoThreadCount = 4; // fallback: one blocking reader can't keep disk queue busy
+
+  struct PendingRead
+  {
+    ReadRequest request;
+    int         fd        = -1; // io_uring only
+    size_t      bytesRead = 0;
+  };
+
+
+#ifdef __linux__
+  // raw io_uring (no liburing): submission and completion rings are mapped once, reads are prepared
+  // in submission ring and whole batch is passed to kernel by one io_uring_enter
+  class IoUring
+  {
+    int           fd_          = -1;
+    void*         sqRing_      = nullptr;
+    void*         cqRing_      = nullptr;
+    size_t        sqRingSize_  = 0;
+    size_t        cqRingSize_  = 0;
+    io_uring_sqe* sqes_        = nullptr;
+    size_t        sqesSize_    = 0;
+    u32           entries_     = 0;
+    u32           unsubmitted_ = 0;
+
+    u32*          sqTail_  = nullptr;
+    u32           sqMask_  = 0;
+    u32*          sqArray_ = nullptr;
+    u32*          cqHead_  = nullptr;
+    u32*          cqTail_  = nullptr;
+    u32           cqMask_  = 0;
+    io_uring_cqe* cqes_    = nullptr;
+
+    template<typename T>
+    T* at( void* ring, u32 offset )
+    {
+      return reinterpret_cast<T*>( static_cast<byte*>( ring ) + offset );
+    }
+
+    bool isReadSupported()
+    {
+      constexpr u32 opCount = 256;
+
+      auto buffer = std::vector<byte>( sizeof( io_uring_probe ) + opCount * sizeof( io_uring_probe_op ) );
+      auto probe  = reinterpret_cast<io_uring_probe*>( buffer.data() );
+      if( syscall( __NR_io_uring_register, fd_, IORING_REGISTER_PROBE, probe, opCount ) < 0 )
+        return false;
+      return IORING_OP_READ <= probe->last_op && ( probe->ops[IORING_OP_READ].flags & IO_URING_OP_SUPPORTED );
+    }
+
+  public:
+    ~IoUring()
+    {
+      if( sqes_ )
+        munmap( sqes_, sqesSize_ );
+      if( cqRing_ && cqRing_ != sqRing_ )
+        munmap( cqRing_, cqRingSize_ );
+      if( sqRing_ )
+        munmap( sqRing_, sqRingSize_ );
+      if( fd_ >= 0 )
+        close( fd_ );
+    }
+
+    // false when kernel is too old or io_uring is forbidden (seccomp in containers, sysctl)
+    bool init( u32 queueDepth )
+    {
+      auto params = io_uring_params{};
+      fd_         = static_cast<int>( syscall( __NR_io_uring_setup, queueDepth, &params ) );
+      if( fd_ < 0 || !isReadSupported() )
+        return false;
+
+      entries_    = params.sq_entries;
+      sqRingSize_ = params.sq_off.array + params.sq_entries * sizeof( u32 );
+      cqRingSize_ = params.cq_off.cqes + params.cq_entries * sizeof( io_uring_cqe );
+      sqesSize_   = params.sq_entries * sizeof( io_uring_sqe );
+
+      bool singleMap = params.features & IORING_FEAT_SINGLE_MMAP;
+      if( singleMap )
+        sqRingSize_ = cqRingSize_ = std::max( sqRingSize_, cqRingSize_ );
+
+      sqRing_ = mmap( nullptr, sqRingSize_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_SQ_RING );
+      if( sqRing_ == MAP_FAILED )
+      {
+        sqRing_ = nullptr;
+        return false;
+      }
+
+      cqRing_ = singleMap ? sqRing_
+                          : mmap( nullptr, cqRingSize_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_CQ_RING );
+      if( cqRing_ == MAP_FAILED )
+      {
+        cqRing_ = nullptr;
+        return false;
+      }
+
+      void* sqes = mmap( nullptr, sqesSize_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_SQES );
+      if( sqes == MAP_FAILED )
+        return false;
+      sqes_ = static_cast<io_uring_sqe*>( sqes );
+
+      sqTail_  = at<u32>( sqRing_, params.sq_off.tail );
+      sqMask_  = *at<u32>( sqRing_, params.sq_off.ring_mask );
+      sqArray_ = at<u32>( sqRing_, params.sq_off.array );
+      cqHead_  = at<u32>( cqRing_, params.cq_off.head );
+      cqTail_  = at<u32>( cqRing_, params.cq_off.tail );
+      cqMask_  = *at<u32>( cqRing_, params.cq_off.ring_mask );
+      cqes_    = at<io_uring_cqe>( cqRing_, params.cq_off.cqes );
+      return true;
+    }
+
+    u32 getEntries() const { return entries_; }
+
+    // caller keeps number of reads in flight under entries, so submission ring is never full
+    void prepare( u8 opcode, int fd, std::span<byte> buffer, u64 offset, u64 userData )
+    {
+      u32  tail  = *sqTail_;
+      u32  index = tail & sqMask_;
+      auto sqe   = &sqes_[index];
+
+      memset( sqe, 0, sizeof( *sqe ) );
+      sqe->opcode    = opcode;
+      sqe->fd        = fd;
+      sqe->addr      = reinterpret_cast<u64>( buffer.data() );
+      sqe->len       = static_cast<u32>( std::min<size_t>( buffer.size(), 1u << 30 ) );
+      sqe->off       = offset;
+      sqe->user_data = userData;
+
+      sqArray_[index] = index;
+      std::atomic_ref( *sqTail_ ).store( tail + 1, std::memory_order_release );
+      ++unsubmitted_;
+    }
+
+    // entries which kernel refused are taken back out of submission ring and their user data goes to
+    // onRejected: nothing may submit them again, so left in ring they would never complete
+    template<typename F>
+    void submit( F&& onRejected )
+    {
+      while( unsubmitted_ )
+      {
+        long submitted = syscall( __NR_io_uring_enter, fd_, unsubmitted_, 0, 0, nullptr, 0 );
+        if( submitted < 0 && errno == EINTR )
+          continue;
+
+        if( submitted < 0 )
+        {
+          mCoreLogError( "io_uring_enter submit failed: %d, " mFmtU32 " entries rejected\n", errno, unsubmitted_ );
+          u32 tail = *sqTail_;
+          for( u32 i = tail - unsubmitted_; i != tail; ++i )
+            onRejected( sqes_[i & sqMask_].user_data );
+
+          std::atomic_ref( *sqTail_ ).store( tail - unsubmitted_, std::memory_order_release );
+          unsubmitted_ = 0;
+          return;
+        }
+        unsubmitted_ -= static_cast<u32>( submitted );
+      }
+    }
+
+    void waitCompletions()
+    {
+      syscall( __NR_io_uring_enter, fd_, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0 );
+    }
+
+    template<typename F>
+    void reapCompletions( F&& onCompletion )
+    {
+      u32 head = *cqHead_;
+      u32 tail = std::atomic_ref( *cqTail_ ).load( std::memory_order_acquire );
+
+      for( ; head != tail; ++head )
+      {
+        const auto& cqe = cqes_[head & cqMask_];
+        onCompletion( cqe.user_data, cqe.res );
+      }
+
+      std::atomic_ref( *cqHead_ ).store( head, std::memory_order_release );
+    }
+  };
+#endif
+
+
+  struct StaticData
+  {
+    std::mutex                               mutex;
+    std::condition_variable                  wakeup; // io threads wait for reads, destroy waits for idle
+    std::deque<std::unique_ptr<PendingRead>> pending;
+    u32                                      inFlight = 0;
+    bool                                     stopping = false;
+    std::vector<std::thread>                 threads;
+
+#ifdef __linux__
+    std::unique_ptr<IoUring> ring;
+#endif
+  };
+
+  StaticData* sData = nullptr;
+
+
+  void complete( std::unique_ptr<PendingRead> read, Status status )
+  {
+#ifdef __linux__
+    if( read->fd >= 0 )
+      close( read->fd );
+#endif
+    read->request.onComplete( status, status == StatusOk ? read->bytesRead : 0 );
+  }
+
+
+  void readBlocking( ReadRequest& request )
+  {
+    auto file = File( request.path.c_str(), "rb" );
+    if( !file.isOpen() )
+    {
+      request.onComplete( StatusNotFound, 0 );
+      return;
+    }
+
+    size_t size   = request.offset < file.getSize() ? std::min<size_t>( request.buffer.size(), file.getSize() - request.offset ) : 0;
+    Status status = file.seek( FileSeekDirectionBegin, static_cast<long>( request.offset ) );
+    if( status == StatusOk )
+      status = file.read( request.buffer.data(), size );
+
+    request.onComplete( status, status == StatusOk ? size : 0 );
+  }
+
+
+  void runIoThread()
+  {
+    system::profiler::setThreadName( "io" );
+    mCoreMemoryScope( Fs );
+
+    for( ;; )
+    {
+      auto read = std::unique_ptr<PendingRead>();
+      {
+        auto lock = std::unique_lock( sData->mutex );
+        sData->wakeup.wait( lock, []() { return sData->stopping || !sData->pending.empty(); } );
+        if( sData->pending.empty() )
+          return;
+
+        read = std::move( sData->pending.front() );
+        sData->pending.pop_front();
+        ++sData->inFlight;
+      }
+
+      {
+        mCoreProfileScope( "blocking read" );
+        readBlocking( read->request );
+      }
+
+      auto lock = std::lock_guard( sData->mutex );
+      --sData->inFlight;
+      sData->wakeup.notify_all();
+    }
+  }
+
+
+#ifdef __linux__
+  using RejectedReads = std::vector<std::unique_ptr<PendingRead>>;
+
+  // must be called under lock. reads which kernel refused are not in flight anymore, caller completes them
+  // with error after lock is released
+  RejectedReads pumpRing()
+  {
+    auto& ring = *sData->ring;
+
+    while( !sData->pending.empty() && sData->inFlight < ring.getEntries() )
+    {
+      auto* read = sData->pending.front().release();
+      sData->pending.pop_front();
+      ++sData->inFlight;
+
+      ring.prepare( IORING_OP_READ, read->fd, read->request.buffer.subspan( read->bytesRead ),
+                    read->request.offset + read->bytesRead, reinterpret_cast<u64>( read ) );
+    }
+
+    auto rejected = RejectedReads();
+    ring.submit( [&rejected]( u64 userData ) { rejected.emplace_back( reinterpret_cast<PendingRead*>( userData ) ); } );
+    sData->inFlight -= static_cast<u32>( rejected.size() );
+    return rejected;
+  }
+
+  void completeRejected( RejectedReads rejected )
+  {
+    for( auto& read: rejected )
+    {
+      core::setErrorDetails( "can't submit read of '%s'", read->request.path.c_str() );
+      complete( std::move( read ), StatusSystemError );
+    }
+  }
+
+
+  void runCompletionThread()
+  {
+    auto& ring     = *sData->ring;
+    bool  stopping = false;
+    system::profiler::setThreadName( "io completion" );
+    mCoreMemoryScope( Fs );
+
+    while( !stopping )
+    {
+      ring.waitCompletions();
+
+      auto completed = std::vector<std::pair<std::unique_ptr<PendingRead>, Status>>();
+      auto retried   = std::vector<std::unique_ptr<PendingRead>>();
+
+      ring.reapCompletions( [&]( u64 userData, s32 result ) {
+        // nop from destroy
+        if( !userData )
+        {
+          stopping = true;
+          return;
+        }
+
+        auto read = std::unique_ptr<PendingRead>( reinterpret_cast<PendingRead*>( userData ) );
+        if( result < 0 )
+        {
+          completed.emplace_back( std::move( read ), StatusSystemError );
+          return;
+        }
+
+        // short read is continued, unless it is the end of file
+        read->bytesRead += static_cast<size_t>( result );
+        if( result > 0 && read->bytesRead < read->request.buffer.size() )
+          retried.push_back( std::move( read ) );
+        else
+          completed.emplace_back( std::move( read ), StatusOk );
+      } );
+
+      {
+        // continuations of reads run here
+        mCoreProfileScope( "read completions" );
+        for( auto& [read, status]: completed )
+          complete( std::move( read ), status );
+      }
+
+      auto rejected = RejectedReads();
+      {
+        auto lock = std::lock_guard( sData->mutex );
+        sData->inFlight -= static_cast<u32>( completed.size() + retried.size() );
+        for( auto& read: retried )
+          sData->pending.push_front( std::move( read ) );
+        rejected = pumpRing();
+        sData->wakeup.notify_all();
+      }
+      completeRejected( std::move( rejected ) );
+    }
+  }
+#endif
+} // namespace
+
+
+Status fs::initAsyncIo( u32 queueDepth )
+{
+  sData = new StaticData();
+
+#ifdef __linux__
+  sData->ring = std::make_unique<IoUring>();
+  if( sData->ring->init( queueDepth ) )
+  {
+    mCoreLog( "async io: io_uring, queue depth " mFmtU32 "\n", sData->ring->getEntries() );
+    sData->threads.emplace_back( runCompletionThread );
+    return StatusOk;
+  }
+  sData->ring.reset();
+#else
+  ( void ) queueDepth;
+#endif
+
+  mCoreLog( "async io: " mFmtU32 " io threads\n", sIoThreadCount );
+  for( u32 i = 0; i < sIoThreadCount; ++i )
+    sData->threads.emplace_back( runIoThread );
+  return StatusOk;
+}
+
+
+void fs::destroyAsyncIo()
+{
+  if( !sData )
+    return;
+
+  {
+    auto lock = std::unique_lock( sData->mutex );
+    sData->wakeup.wait( lock, []() { return sData->pending.empty() && sData->inFlight == 0; } );
+    sData->stopping = true;
+
+#ifdef __linux__
+    // completion thread is woken up by nop without user data
+    if( sData->ring )
+    {
+      sData->ring->prepare( IORING_OP_NOP, -1, {}, 0, 0 );
+      sData->ring->submit( []( u64 ) {} );
+    }
+#endif
+  }
+
+  sData->wakeup.notify_all();
+  for( auto& thread: sData->threads )
+    thread.join();
+
+  delete sData;
+  sData = nullptr;
+}
+
+
+bool fs::isAsyncIoUring()
+{
+#ifdef __linux__
+  return sData && sData->ring;
+#else
+  return false;
+#endif
+}
+
+
+void fs::submitReads( std::vector<ReadRequest> requests )
+{
+  assert( sData );
+
+  auto reads = std::vector<std::unique_ptr<PendingRead>>();
+  reads.reserve( requests.size() );
+
+  for( auto& request: requests )
+  {
+    // packed files are in memory already
+    if( auto packed = std::span<const byte>(); findPackedFile( request.path, packed ) )
+    {
+      size_t size = request.offset < packed.size() ? std::min<size_t>( request.buffer.size(), packed.size() - request.offset ) : 0;
+      if( size )
+        memcpy( request.buffer.data(), packed.data() + request.offset, size );
+      request.onComplete( StatusOk, size );
+      continue;
+    }
+
+    auto read = std::make_unique<PendingRead>( PendingRead{
+        .request   = std::move( request ),
+        .fd        = -1,
+        .bytesRead = 0,
+    } );
+
+#ifdef __linux__
+    if( sData->ring )
+    {
+      read->fd = open( read->request.path.c_str(), O_RDONLY | O_CLOEXEC );
+      if( read->fd < 0 )
+      {
+        core::setErrorDetails( "can't open file '%s'", read->request.path.c_str() );
+        read->request.onComplete( StatusNotFound, 0 );
+        continue;
+      }
+    }
+#endif
+
+    reads.push_back( std::move( read ) );
+  }
+
+  auto lock = std::unique_lock( sData->mutex );
+  for( auto& read: reads )
+    sData->pending.push_back( std::move( read ) );
+
+#ifdef __linux__
+  if( sData->ring )
+  {
+    auto rejected = pumpRing();
+    sData->wakeup.notify_all(); // destroy may wait for rejected reads
+    lock.unlock();
+    completeRejected( std::move( rejected ) );
+    return;
+  }
+#endif
+
+  sData->wakeup.notify_all();
+}
+
+
+cti::continuable<FileBytes> fs::ctiReadFile( std::string path )
+{
+  return cti::make_continuable<FileBytes>( [path = std::move( path )]( auto&& promise ) mutable {
+    if( auto packed = std::span<const byte>(); findPackedFile( path, packed ) )
+    {
+      promise.set_value( FileBytes( packed ) );
+      return;
+    }
+
+    auto ec   = std::error_code();
+    u64  size = stdfs::file_size( path, ec );
+    if( ec )
+    {
+      core::setErrorDetails( "can't read file '%s': %s", path.c_str(), ec.message().c_str() );
+      promise.set_exception( StatusNotFound );
+      return;
+    }
+
+    // moving vector keeps its heap buffer, so request buffer stays valid while storage moves with completion
+    auto storage  = std::vector<byte>( size );
+    auto buffer   = std::span( storage );
+    auto requests = std::vector<ReadRequest>();
+    requests.push_back( ReadRequest{
+        .path       = std::move( path ),
+        .buffer     = buffer,
+        .offset     = 0,
+        .onComplete = [storage = std::move( storage ),
+                       promise = std::forward<decltype( promise )>( promise )]( Status status, size_t bytesRead ) mutable {
+          if( status != StatusOk )
+          {
+            promise.set_exception( status );
+            return;
+          }
+
+          storage.resize( bytesRead );
+          promise.set_value( FileBytes( std::move( storage ) ) );
+        },
+    } );
+    submitReads( std::move( requests ) );
+  } );
+}
+
+
+Status fs::readFiles( std::span<const std::string> paths, std::vector<FileBytes>& out )
+{
+  out = std::vector<FileBytes>( paths.size() );
+
+  auto storages = std::vector<std::vector<byte>>( paths.size() );
+  auto statuses = std::vector<Status>( paths.size(), StatusOk );
+  auto indices  = std::vector<size_t>(); // of files to read
+
+  for( size_t i = 0; i < paths.size(); ++i )
+  {
+    if( auto packed = std::span<const byte>(); findPackedFile( paths[i], packed ) )
+    {
+      out[i] = FileBytes( packed );
+      continue;
+    }
+
+    auto ec   = std::error_code();
+    u64  size = stdfs::file_size( paths[i], ec );
+    if( ec )
+    {
+      core::setErrorDetails( "can't read file '%s': %s", paths[i].c_str(), ec.message().c_str() );
+      return StatusNotFound;
+    }
+
+    storages[i].resize( size );
+    indices.push_back( i );
+  }
+
+  auto done     = std::latch( static_cast<std::ptrdiff_t>( indices.size() ) );
+  auto requests = std::vector<ReadRequest>();
+  requests.reserve( indices.size() );
+
+  for( size_t i: indices )
+  {
+    requests.push_back( ReadRequest{
+        .path       = paths[i],
+        .buffer     = storages[i],
+        .offset     = 0,
+        .onComplete = [&storages, &statuses, &done, i]( Status status, size_t bytesRead ) {
+          statuses[i] = status;
+          storages[i].resize( bytesRead );
+          done.count_down();
+        },
+    } );
+  }
+
+  submitReads( std::move( requests ) );
+  done.wait();
+
+  for( size_t i: indices )
+  {
+    mCoreCheckStatus( statuses[i] );
+    out[i] = FileBytes( std::move( storages[i] ) );
+  }
+  return StatusOk;
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include "core/common.hpp"
+
+namespace core::fs
+{
+  using ReadCompletion = std::move_only_function<void( Status status, size_t bytesRead )>;
+
+  // read of file part into buffer given by caller, buffer must live until completion.
+  // bytesRead is less than buffer size only at the end of file
+  struct ReadRequest
+  {
+    std::string     path;
+    std::span<byte> buffer;
+    u64             offset = 0;
+    ReadCompletion  onComplete;
+  };
+
+  // reads of one call are submitted as one batch: io_uring on linux, io threads with blocking reads elsewhere
+  // (or when io_uring is not allowed). worker threads never wait for io.
+  // completions are called on io thread, they should only pass work on (to task system)
+  Status initAsyncIo( u32 queueDepth = 256 );
+  void   destroyAsyncIo(); // waits for reads in flight
+  bool   isAsyncIoUring();
+  void   submitReads( std::vector<ReadRequest> requests );
+
+
+  // whole file: read by async io, or view of packed file (no io at all)
+  class FileBytes
+  {
+    std::vector<byte>     storage_;
+    std::span<const byte> view_;
+
+  public:
+    FileBytes() = default;
+    explicit FileBytes( std::vector<byte> storage ) : storage_( std::move( storage ) ) {}
+    explicit FileBytes( std::span<const byte> view ) : view_( view ) {}
+
+    std::span<const byte> getBytes() const { return view_.data() ? view_ : std::span<const byte>( storage_ ); }
+  };
+
+  cti::continuable<FileBytes> ctiReadFile( std::string path );
+
+  // blocks caller until all files are read
+  Status readFiles( std::span<const std::string> paths, std::vector<FileBytes>& out );
+} // namespace core::fs
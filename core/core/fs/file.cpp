@@ -1,10 +1,18 @@
 #include "core/fs/file.hpp"
+#include "core/fs/pack.hpp"
 
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wdocumentation-unknown-command"
 #include <zstd.h>
 #pragma GCC diagnostic pop
 
+#ifndef _WIN32
+#  include <fcntl.h>
+#  include <unistd.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#endif
+
 using namespace core;
 using namespace core::fs;
 
@@ -19,17 +27,38 @@ using namespace core::fs;
 
 namespace
 {
-  Status compress( std::span<const byte> source, std::vector<byte>& output, int compressionLevel )
+  struct StaticData
   {
-    size_t capacity = ZSTD_compressBound( source.size() );
-    output          = std::vector<byte>( capacity );
+    std::map<u32, ZSTD_DDict*> dictionaries; // by dictionary id
+  };
 
-    auto resultSize = ZSTD_compress( output.data(), capacity, source.data(), source.size(), compressionLevel );
-    mFailIfZStd( resultSize, "ZSTD_compress" );
-    output.resize( resultSize );
-    return StatusOk;
+  StaticData* sData = nullptr;
+
+
+  // frame compressed with dictionary can be decoded only with the same dictionary
+  Status findDictionary( const void* frame, size_t frameSize, const ZSTD_DDict*& out )
+  {
+    out = nullptr;
+
+    unsigned id = ZSTD_getDictID_fromFrame( frame, frameSize );
+    if( !id )
+      return StatusOk;
+
+    if( sData )
+    {
+      if( auto it = sData->dictionaries.find( id ); it != sData->dictionaries.end() )
+      {
+        out = it->second;
+        return StatusOk;
+      }
+    }
+
+    mCoreLogError( "zstd frame needs dictionary %u, which is not loaded\n", id );
+    return StatusBadFile;
   }
 
+
+  // handles files of several frames, frames written by stream (without content size) and frames with dictionaries
   Status decompress( std::span<const byte> encoded, std::vector<byte>& output )
   {
     unsigned long long contentSize = ZSTD_getFrameContentSize( encoded.data(), encoded.size() );
@@ -40,15 +69,61 @@ namespace
       return StatusBadFile;
     }
 
-    if( contentSize == ZSTD_CONTENTSIZE_UNKNOWN )
+    auto context = std::unique_ptr<ZSTD_DCtx, decltype( &ZSTD_freeDCtx )>( ZSTD_createDCtx(), &ZSTD_freeDCtx );
+
+    // single frame with known size is decompressed at once
+    if( contentSize != ZSTD_CONTENTSIZE_UNKNOWN && ZSTD_findFrameCompressedSize( encoded.data(), encoded.size() ) == encoded.size() )
     {
-      mCoreLogError( "zstd compression original size unknown\n" );
-      return StatusBadFile;
+      const ZSTD_DDict* dictionary = nullptr;
+      mCoreCheckStatus( findDictionary( encoded.data(), encoded.size(), dictionary ) );
+
+      output     = std::vector<byte>( contentSize );
+      size_t err = ZSTD_decompress_usingDDict( context.get(), output.data(), output.size(),
+                                               encoded.data(), encoded.size(), dictionary );
+      mFailIfZStd( err, "ZSTD_decompress_usingDDict" );
+      return StatusOk;
     }
 
-    output     = std::vector<byte>( contentSize );
-    size_t err = ZSTD_decompress( output.data(), output.size(), encoded.data(), encoded.size() );
-    mFailIfZStd( err, "ZSTD_decompress" );
+    size_t outputSize = 0;
+    output.resize( std::max<size_t>( encoded.size() * 4, ZSTD_DStreamOutSize() ) );
+
+    // frame by frame, every frame can have its own dictionary
+    for( size_t offset = 0; offset < encoded.size(); )
+    {
+      auto   frame     = encoded.subspan( offset );
+      size_t frameSize = ZSTD_findFrameCompressedSize( frame.data(), frame.size() );
+      mFailIfZStd( frameSize, "ZSTD_findFrameCompressedSize" );
+
+      const ZSTD_DDict* dictionary = nullptr;
+      mCoreCheckStatus( findDictionary( frame.data(), frameSize, dictionary ) );
+      ZSTD_DCtx_reset( context.get(), ZSTD_reset_session_only );
+      ZSTD_DCtx_refDDict( context.get(), dictionary );
+
+      auto   input  = ZSTD_inBuffer{ .src = frame.data(), .size = frameSize, .pos = 0 };
+      size_t result = 1;
+
+      // 0 means frame is decoded and flushed
+      while( result != 0 )
+      {
+        if( outputSize == output.size() )
+          output.resize( output.size() * 2 );
+
+        auto outputBuffer = ZSTD_outBuffer{ .dst = output.data() + outputSize, .size = output.size() - outputSize, .pos = 0 };
+        result            = ZSTD_decompressStream( context.get(), &outputBuffer, &input );
+        mFailIfZStd( result, "ZSTD_decompressStream" );
+        outputSize += outputBuffer.pos;
+
+        if( result != 0 && input.pos == input.size && outputBuffer.pos < outputBuffer.size )
+        {
+          mCoreLogError( "zstd frame is truncated\n" );
+          return StatusBadFile;
+        }
+      }
+
+      offset += frameSize;
+    }
+
+    output.resize( outputSize );
     return StatusOk;
   }
 } // namespace
@@ -145,6 +220,9 @@ Status File::write( const void* buffer, size_t size )
   if( !stream_ )
     return StatusBadFile;
 
+  if( size == 0 )
+    return StatusOk;
+
   size_t elementsWritten = fwrite( buffer, size, 1, stream_ );
   if( elementsWritten != 1 )
     return StatusSystemError;
@@ -169,6 +247,132 @@ Status File::read( void* buffer, size_t size )
 }
 
 
+MappedFile::MappedFile( const char* path )
+{
+#ifdef _WIN32
+  HANDLE file = CreateFileA( path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr );
+  if( file == INVALID_HANDLE_VALUE )
+  {
+    core::setErrorDetails( "can't open file '%s'", path );
+    return;
+  }
+
+  auto size = LARGE_INTEGER{};
+  if( !GetFileSizeEx( file, &size ) || size.QuadPart == 0 )
+  {
+    core::setErrorDetails( "can't map file '%s': file is empty or its size is unknown", path );
+    CloseHandle( file );
+    return;
+  }
+
+  // mapping holds file open by itself
+  HANDLE mapping = CreateFileMappingA( file, nullptr, PAGE_READONLY, 0, 0, nullptr );
+  CloseHandle( file );
+  if( !mapping )
+  {
+    core::setErrorDetails( "can't map file '%s': CreateFileMapping failed", path );
+    return;
+  }
+
+  void* view = MapViewOfFile( mapping, FILE_MAP_READ, 0, 0, 0 );
+  if( !view )
+  {
+    core::setErrorDetails( "can't map file '%s': MapViewOfFile failed", path );
+    CloseHandle( mapping );
+    return;
+  }
+
+  data_    = static_cast<const byte*>( view );
+  size_    = static_cast<size_t>( size.QuadPart );
+  mapping_ = mapping;
+#else
+  int fd = open( path, O_RDONLY );
+  if( fd < 0 )
+  {
+    core::setErrorDetails( "can't open file '%s'", path );
+    return;
+  }
+
+  struct stat info = {};
+  if( fstat( fd, &info ) != 0 || info.st_size == 0 )
+  {
+    core::setErrorDetails( "can't map file '%s': file is empty or its size is unknown", path );
+    close( fd );
+    return;
+  }
+
+  // mapping holds file open by itself
+  void* view = mmap( nullptr, static_cast<size_t>( info.st_size ), PROT_READ, MAP_PRIVATE, fd, 0 );
+  close( fd );
+  if( view == MAP_FAILED )
+  {
+    core::setErrorDetails( "can't map file '%s': mmap failed", path );
+    return;
+  }
+
+  data_ = static_cast<const byte*>( view );
+  size_ = static_cast<size_t>( info.st_size );
+#endif
+}
+
+MappedFile::~MappedFile()
+{
+  if( !data_ )
+    return;
+
+#ifdef _WIN32
+  UnmapViewOfFile( data_ );
+  CloseHandle( mapping_ );
+#else
+  munmap( const_cast<byte*>( data_ ), size_ );
+#endif
+}
+
+MappedFile::MappedFile( MappedFile&& other ) noexcept
+    : data_( std::exchange( other.data_, nullptr ) )
+    , size_( std::exchange( other.size_, 0 ) )
+    , mapping_( std::exchange( other.mapping_, nullptr ) )
+{
+}
+
+MappedFile& MappedFile::operator=( MappedFile&& other ) noexcept
+{
+  if( this != &other )
+  {
+    this->~MappedFile();
+    data_    = std::exchange( other.data_, nullptr );
+    size_    = std::exchange( other.size_, 0 );
+    mapping_ = std::exchange( other.mapping_, nullptr );
+  }
+  return *this;
+}
+
+
+Status FileView::open( const char* path )
+{
+  file_  = MappedFile();
+  bytes_ = {};
+
+  // packed files are looked up in memory, no syscalls at all
+  if( findPackedFile( path, bytes_ ) )
+    return StatusOk;
+
+  file_ = MappedFile( path );
+  if( file_.isOpen() )
+  {
+    bytes_ = file_.getBytes();
+    return StatusOk;
+  }
+
+  // empty file can't be mapped, but it is still a file
+  auto ec = std::error_code();
+  if( stdfs::is_regular_file( path, ec ) && stdfs::file_size( path, ec ) == 0 && !ec )
+    return StatusOk;
+
+  return StatusNotFound;
+}
+
+
 Status fs::writeFile( const char* path, std::span<const byte> data )
 {
   auto f = File{ path, "wb" };
@@ -176,6 +380,21 @@ Status fs::writeFile( const char* path, std::span<const byte> data )
 }
 
 
+Status fs::compress( std::span<const byte> source, std::vector<byte>& output, int compressionLevel,
+                     std::span<const byte> dictionary )
+{
+  size_t capacity = ZSTD_compressBound( source.size() );
+  output          = std::vector<byte>( capacity );
+
+  auto context    = std::unique_ptr<ZSTD_CCtx, decltype( &ZSTD_freeCCtx )>( ZSTD_createCCtx(), &ZSTD_freeCCtx );
+  auto resultSize = ZSTD_compress_usingDict( context.get(), output.data(), capacity, source.data(), source.size(),
+                                             dictionary.data(), dictionary.size(), compressionLevel );
+  mFailIfZStd( resultSize, "ZSTD_compress_usingDict" );
+  output.resize( resultSize );
+  return StatusOk;
+}
+
+
 Status fs::writeFileCompressed( const char* path, std::span<const byte> data, int compressionLevel )
 {
   std::vector<byte> encoded;
@@ -184,6 +403,217 @@ Status fs::writeFileCompressed( const char* path, std::span<const byte> data, in
 }
 
 
+Status fs::loadDictionaries( const char* path )
+{
+  unloadDictionaries();
+
+  auto object       = msgpack::object();
+  auto objectHandle = msgpack::object_handle();
+  mCoreCheckStatus( readFileMsgpack( path, object, objectHandle ) );
+
+  auto dictionaries = std::map<std::string, std::vector<byte>>();
+  try
+  {
+    object.convert( dictionaries );
+  }
+  catch( const std::exception& ex )
+  {
+    core::setErrorDetails( "bad dictionaries file: %s", ex.what() );
+    return StatusBadFile;
+  }
+
+  sData = new StaticData();
+
+  for( const auto& [name, bytes]: dictionaries )
+  {
+    auto* dictionary = ZSTD_createDDict( bytes.data(), bytes.size() );
+    u32   id         = ZSTD_getDictID_fromDDict( dictionary );
+
+    if( !id )
+    {
+      ZSTD_freeDDict( dictionary );
+      core::setErrorDetails( "'%s' is not a zstd dictionary", name.c_str() );
+      // reads must not see part of dictionaries
+      unloadDictionaries();
+      return StatusBadFile;
+    }
+
+    mCoreLog( "loaded zstd dictionary %s: %u (" mFmtU64 " bytes)\n", name.c_str(), id, static_cast<u64>( bytes.size() ) );
+    sData->dictionaries[id] = dictionary;
+  }
+
+  return StatusOk;
+}
+
+
+void fs::unloadDictionaries()
+{
+  if( !sData )
+    return;
+
+  for( auto& [id, dictionary]: sData->dictionaries )
+    ZSTD_freeDDict( dictionary );
+
+  delete sData;
+  sData = nullptr;
+}
+
+
+namespace core::fs
+{
+  struct CompressedFileWriterData
+  {
+    File              file;
+    ZSTD_CCtx*        context = nullptr;
+    std::vector<byte> input;  // small writes are gathered here, so zstd is not called for each of them
+    std::vector<byte> output; // compressed bytes on the way to file
+    size_t            inputSize    = 0;
+    u64               frameBytes   = 0; // source bytes of current frame
+    u64               sourceBytes  = 0;
+    u64               writtenBytes = 0;
+    Status            status       = StatusOk;
+
+    explicit CompressedFileWriterData( const char* path )
+        : file( path, "wb" )
+        , input( ZSTD_CStreamInSize() )
+        , output( ZSTD_CStreamOutSize() )
+    {
+    }
+
+    Status compress( std::span<const byte> source, ZSTD_EndDirective mode )
+    {
+      auto inputBuffer = ZSTD_inBuffer{ .src = source.data(), .size = source.size(), .pos = 0 };
+
+      for( ;; )
+      {
+        auto   outputBuffer = ZSTD_outBuffer{ .dst = output.data(), .size = output.size(), .pos = 0 };
+        size_t remaining    = ZSTD_compressStream2( context, &outputBuffer, &inputBuffer, mode );
+        mFailIfZStd( remaining, "ZSTD_compressStream2" );
+
+        mCoreCheckStatus( file.write( output.data(), outputBuffer.pos ) );
+        writtenBytes += outputBuffer.pos;
+
+        bool done = mode == ZSTD_e_end ? remaining == 0 : inputBuffer.pos == inputBuffer.size;
+        if( done )
+          return StatusOk;
+      }
+    }
+
+    Status flush( ZSTD_EndDirective mode )
+    {
+      auto pending = std::span( input.data(), inputSize );
+      inputSize    = 0;
+      return compress( pending, mode );
+    }
+
+    Status endFrame()
+    {
+      mCoreCheckStatus( flush( ZSTD_e_end ) );
+      frameBytes = 0;
+      return StatusOk;
+    }
+  };
+} // namespace core::fs
+
+
+CompressedFileWriter::CompressedFileWriter( const char* path, int compressionLevel, u32 workerCount )
+    : data_( new CompressedFileWriterData( path ) )
+{
+  if( !data_->file.isOpen() )
+  {
+    data_->status = StatusBadFile;
+    return;
+  }
+
+  data_->context = ZSTD_createCCtx();
+  ZSTD_CCtx_setParameter( data_->context, ZSTD_c_compressionLevel, compressionLevel );
+
+  if( workerCount > 1 )
+  {
+    size_t result = ZSTD_CCtx_setParameter( data_->context, ZSTD_c_nbWorkers, static_cast<int>( workerCount ) );
+    if( ZSTD_isError( result ) )
+      mCoreLogDebug( "zstd is built without multithreading, compressing on caller thread\n" );
+  }
+}
+
+CompressedFileWriter::~CompressedFileWriter()
+{
+  if( data_->context )
+    ZSTD_freeCCtx( data_->context );
+  delete data_;
+}
+
+void CompressedFileWriter::write( const char* data, size_t size )
+{
+  if( data_->status != StatusOk )
+    return;
+
+  data_->sourceBytes += size;
+  data_->frameBytes += size;
+
+  auto bytes = std::span( reinterpret_cast<const byte*>( data ), size );
+
+  if( data_->inputSize + bytes.size() <= data_->input.size() )
+  {
+    std::ranges::copy( bytes, data_->input.begin() + static_cast<std::ptrdiff_t>( data_->inputSize ) );
+    data_->inputSize += bytes.size();
+    return;
+  }
+
+  // big writes (mip data, vertex buffers) go to zstd without copying
+  data_->status = data_->flush( ZSTD_e_continue );
+  if( data_->status == StatusOk )
+    data_->status = data_->compress( bytes, ZSTD_e_continue );
+}
+
+void CompressedFileWriter::setCompressionLevel( int compressionLevel, std::span<const byte> dictionary )
+{
+  if( data_->status != StatusOk )
+    return;
+
+  // zstd applies most of parameters only at frame start
+  if( data_->frameBytes )
+    data_->status = data_->endFrame();
+
+  ZSTD_CCtx_setParameter( data_->context, ZSTD_c_compressionLevel, compressionLevel );
+
+  // empty dictionary returns context to no dictionary mode
+  size_t result = ZSTD_CCtx_loadDictionary( data_->context, dictionary.data(), dictionary.size() );
+  if( ZSTD_isError( result ) )
+  {
+    mCoreLogError( "zstd ZSTD_CCtx_loadDictionary failed: %s\n", ZSTD_getErrorName( result ) );
+    data_->status = StatusBadFile;
+  }
+}
+
+Status CompressedFileWriter::finish()
+{
+  mCoreCheckStatus( data_->status );
+
+  // empty file still gets a frame, so it can be decompressed
+  if( data_->frameBytes || !data_->writtenBytes )
+    data_->status = data_->endFrame();
+
+  return data_->status;
+}
+
+u64 CompressedFileWriter::getSourceBytes() const
+{
+  return data_->sourceBytes;
+}
+
+u64 CompressedFileWriter::getWrittenBytes() const
+{
+  return data_->writtenBytes;
+}
+
+u64 CompressedFileWriter::getMemoryBytes() const
+{
+  u64 contextBytes = data_->context ? ZSTD_sizeof_CCtx( data_->context ) : 0;
+  return data_->input.size() + data_->output.size() + contextBytes;
+}
+
+
 Status fs::writeFileJson( const char* path, const Json& data )
 {
   auto indent       = 2;
@@ -211,9 +641,84 @@ Status fs::writeFileJson( const char* path, const Json& data )
 
 Status fs::readFile( const char* path, std::vector<u8>& out )
 {
-  auto f = File{ path, "rb" };
-  out.resize( f.getSize() );
-  return f.read( out.data(), out.size() );
+  auto view = FileView();
+  mCoreCheckStatus( view.open( path ) );
+  out.assign( view.getBytes().begin(), view.getBytes().end() );
+  return StatusOk;
+}
+
+
+Status fs::adviseWillNeed( const char* path )
+{
+  // pack is already mapped, only its pages of the file are asked for
+  if( auto packed = std::span<const byte>(); findPackedFile( path, packed ) )
+  {
+    if( packed.empty() )
+      return StatusOk;
+
+#ifdef _WIN32
+    auto range = WIN32_MEMORY_RANGE_ENTRY{
+        .VirtualAddress = const_cast<byte*>( packed.data() ),
+        .NumberOfBytes  = packed.size(),
+    };
+    PrefetchVirtualMemory( GetCurrentProcess(), 1, &range, 0 );
+#else
+    // madvise wants page aligned address
+    static const auto sPageSize = static_cast<uintptr_t>( sysconf( _SC_PAGESIZE ) );
+
+    auto begin = reinterpret_cast<uintptr_t>( packed.data() ) & ~( sPageSize - 1 );
+    auto end   = reinterpret_cast<uintptr_t>( packed.data() + packed.size() );
+    madvise( reinterpret_cast<void*>( begin ), end - begin, MADV_WILLNEED );
+#endif
+    return StatusOk;
+  }
+
+#ifdef _WIN32
+  // there is no fadvise on windows: map file and ask memory manager to prefetch it into standby list
+  HANDLE file = CreateFileA( path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                             FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr );
+  if( file == INVALID_HANDLE_VALUE )
+  {
+    core::setErrorDetails( "adviseWillNeed: can't open file '%s'", path );
+    return StatusNotFound;
+  }
+
+  auto size = LARGE_INTEGER{};
+  if( !GetFileSizeEx( file, &size ) || size.QuadPart == 0 )
+  {
+    CloseHandle( file );
+    return StatusOk;
+  }
+
+  HANDLE mapping = CreateFileMappingA( file, nullptr, PAGE_READONLY, 0, 0, nullptr );
+  if( mapping )
+  {
+    if( void* view = MapViewOfFile( mapping, FILE_MAP_READ, 0, 0, 0 ) )
+    {
+      auto range = WIN32_MEMORY_RANGE_ENTRY{
+          .VirtualAddress = view,
+          .NumberOfBytes  = static_cast<SIZE_T>( size.QuadPart ),
+      };
+      PrefetchVirtualMemory( GetCurrentProcess(), 1, &range, 0 );
+      UnmapViewOfFile( view );
+    }
+    CloseHandle( mapping );
+  }
+
+  CloseHandle( file );
+  return StatusOk;
+#else
+  int fd = open( path, O_RDONLY );
+  if( fd < 0 )
+  {
+    core::setErrorDetails( "adviseWillNeed: can't open file '%s'", path );
+    return StatusNotFound;
+  }
+
+  posix_fadvise( fd, 0, 0, POSIX_FADV_WILLNEED );
+  close( fd );
+  return StatusOk;
+#endif
 }
 
 
@@ -298,12 +803,14 @@ Status fs::findFileUp( const stdfs::path& baseDirectory, const stdfs::path& file
 }
 
 
-Status fs::readFileJson( const char* path, Json& out )
+Status fs::decodeJson( std::span<const byte> bytes, Json& out, bool compressed )
 {
-  mCoreLog( "loading json at %s\n", path );
-
-  auto bytes = std::vector<byte>();
-  mCoreCheckStatus( fs::readFile( path, bytes ) );
+  auto decoded = std::vector<byte>();
+  if( compressed )
+  {
+    mCoreCheckStatus( decompress( bytes, decoded ) );
+    bytes = decoded;
+  }
 
   auto jsonString = std::string_view( reinterpret_cast<const char*>( bytes.data() ), bytes.size() );
 
@@ -321,13 +828,8 @@ Status fs::readFileJson( const char* path, Json& out )
 }
 
 
-Status fs::readFileMsgpack( const char* path, msgpack::object& out, msgpack::object_handle& outHandle )
+Status fs::decodeMsgpack( std::span<const byte> bytes, msgpack::object& out, msgpack::object_handle& outHandle )
 {
-  mCoreLog( "loading msgpack at %s\n", path );
-
-  auto bytes = std::vector<byte>();
-  mCoreCheckStatus( fs::readFile( path, bytes ) );
-
   try
   {
     outHandle = msgpack::unpack( reinterpret_cast<const char*>( bytes.data() ), bytes.size() );
@@ -343,27 +845,39 @@ Status fs::readFileMsgpack( const char* path, msgpack::object& out, msgpack::obj
 }
 
 
-Status fs::readFileMsgpackCompressed( const char* path, msgpack::object& out, msgpack::object_handle& outHandle )
+Status fs::decodeMsgpackCompressed( std::span<const byte> encoded, msgpack::object& out, msgpack::object_handle& outHandle )
 {
-  mCoreLog( "loading msgpack at %s\n", path );
   auto bytes = std::vector<byte>();
+  mCoreCheckStatus( decompress( encoded, bytes ) );
+  return decodeMsgpack( bytes, out, outHandle );
+}
 
-  {
-    auto encoded = std::vector<byte>();
-    mCoreCheckStatus( fs::readFile( path, encoded ) );
-    mCoreCheckStatus( decompress( encoded, bytes ) );
-  }
 
-  try
-  {
-    outHandle = msgpack::unpack( reinterpret_cast<const char*>( bytes.data() ), bytes.size() );
-    out       = outHandle.get();
-  }
-  catch( const std::exception& ex )
-  {
-    core::setErrorDetails( "exception while decoding render chunk: %s", ex.what() );
-    return StatusSystemError;
-  }
+Status fs::readFileJson( const char* path, Json& out )
+{
+  mCoreLog( "loading json at %s\n", path );
 
-  return StatusOk;
+  auto view = FileView();
+  mCoreCheckStatus( view.open( path ) );
+  return decodeJson( view.getBytes(), out, isCompressedJson( path ) );
+}
+
+
+Status fs::readFileMsgpack( const char* path, msgpack::object& out, msgpack::object_handle& outHandle )
+{
+  mCoreLog( "loading msgpack at %s\n", path );
+
+  auto view = FileView();
+  mCoreCheckStatus( view.open( path ) );
+  return decodeMsgpack( view.getBytes(), out, outHandle );
+}
+
+
+Status fs::readFileMsgpackCompressed( const char* path, msgpack::object& out, msgpack::object_handle& outHandle )
+{
+  mCoreLog( "loading msgpack at %s\n", path );
+
+  auto view = FileView();
+  mCoreCheckStatus( view.open( path ) );
+  return decodeMsgpackCompressed( view.getBytes(), out, outHandle );
 }
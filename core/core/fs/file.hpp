@@ -38,12 +38,75 @@ namespace core::fs
   };
 
 
+  // read only mapping of whole file, pages are read by OS on first access
+  class MappedFile
+  {
+    const byte* data_    = nullptr;
+    size_t      size_    = 0;
+    void*       mapping_ = nullptr; // file mapping handle on windows
+
+  public:
+    MappedFile() = default;
+    explicit MappedFile( const char* path );
+    ~MappedFile();
+
+    MappedFile( MappedFile&& other ) noexcept;
+    MappedFile& operator=( MappedFile&& other ) noexcept;
+
+    bool                  isOpen() const { return data_; }
+    std::span<const byte> getBytes() const { return { data_, size_ }; }
+  };
+
+
+  // bytes of file without copying: view into mounted pack (see pack.hpp) or mapping of loose file
+  class FileView
+  {
+    MappedFile            file_;
+    std::span<const byte> bytes_;
+
+  public:
+    Status                open( const char* path ); // returns: StatusOk / StatusNotFound
+    std::span<const byte> getBytes() const { return bytes_; }
+  };
+
+
+  // zstd stream straight to file, bytes are compressed as they come with bounded buffers.
+  // can be used as msgpack stream. after first error all writes are ignored and finish returns it
+  class CompressedFileWriter
+  {
+    struct CompressedFileWriterData* data_;
+
+  public:
+    // workerCount > 1 compresses on zstd's own threads (if zstd is built with multithreading)
+    CompressedFileWriter( const char* path, int compressionLevel, u32 workerCount = std::thread::hardware_concurrency() );
+    ~CompressedFileWriter();
+
+    CompressedFileWriter( const CompressedFileWriter& )            = delete;
+    CompressedFileWriter& operator=( const CompressedFileWriter& ) = delete;
+
+    void write( const char* data, size_t size );
+    void write( std::span<const byte> data ) { write( reinterpret_cast<const char*>( data.data() ), data.size() ); }
+
+    // ends current frame, following bytes go to new frame compressed with other level and dictionary
+    void setCompressionLevel( int compressionLevel, std::span<const byte> dictionary = {} );
+
+    // ends last frame, file is closed by destructor
+    Status finish();
+
+    u64 getSourceBytes() const;
+    u64 getWrittenBytes() const;
+    u64 getMemoryBytes() const; // buffers and zstd context
+  };
+
+
   struct EntryInfo
   {
     FsEntryType type;
   };
 
 
+  Status        compress( std::span<const byte> source, std::vector<byte>& output, int compressionLevel = 6,
+                        std::span<const byte> dictionary = {} );
   Status        writeFile( const char* path, std::span<const byte> data );
   inline Status writeFile( const std::string& path, std::span<const byte> data ) { return writeFile( path.c_str(), data ); }
   Status        writeFileCompressed( const char* path, std::span<const byte> data, int compressionLevel = 6 );
@@ -59,6 +122,24 @@ namespace core::fs
   Status        readFileMsgpackCompressed( const char* path, msgpack::object& out, msgpack::object_handle& outHandle );
   inline Status readFileMsgpackCompressed( const std::string& path, msgpack::object& out, msgpack::object_handle& outHandle ) { return readFileMsgpackCompressed( path.c_str(), out, outHandle ); }
 
+  // scene-tool writes json compressed with dictionary under its own extension, so files named .json stay plain text
+  inline bool isCompressedJson( std::string_view path ) { return path.ends_with( ".json.zst" ); }
+
+  // same as read functions, for bytes which are already in memory (read by async io)
+  Status decodeJson( std::span<const byte> bytes, Json& out, bool compressed = false );
+  Status decodeMsgpack( std::span<const byte> bytes, msgpack::object& out, msgpack::object_handle& outHandle );
+  Status decodeMsgpackCompressed( std::span<const byte> encoded, msgpack::object& out, msgpack::object_handle& outHandle );
+
+  // zstd dictionaries (msgpack map of name -> dictionary). compressed files which need them are decompressed
+  // with them transparently. must be loaded before any reads are started
+  Status        loadDictionaries( const char* path );
+  inline Status loadDictionaries( const std::string& path ) { return loadDictionaries( path.c_str() ); }
+  void          unloadDictionaries();
+
+  // hints OS that file will be read soon (or range of pack, if file is packed), so it can start reading it into page cache
+  Status        adviseWillNeed( const char* path );
+  inline Status adviseWillNeed( const std::string& path ) { return adviseWillNeed( path.c_str() ); }
+
   Status        getEntryInfo( const stdfs::path& path, EntryInfo& out ); // returns: StatusOk / StatusSystemError / StatusNotFound
   inline Status getEntryInfo( const char* path, EntryInfo& out ) { return getEntryInfo( stdfs::path( path ), out ); }
   Status        findFileUp( const stdfs::path& baseDirectory, const stdfs::path& fileName, stdfs::path& out );
@@ -1,3 +1,5 @@
 #pragma once
+#include "core/fs/async-io.hpp"
 #include "core/fs/file.hpp"
+#include "core/fs/pack.hpp"
 #include "core/fs/path.hpp"
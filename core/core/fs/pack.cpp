@@ -0,0 +1,200 @@
+#include "core/fs/pack.hpp"
+#include "core/fs/file.hpp"
+
+using namespace core;
+using namespace core::fs;
+
+
+namespace
+{
+  struct StaticData
+  {
+    MappedFile                 file;
+    std::string                root; // without trailing separator
+    std::span<const PackEntry> entries;
+  };
+
+  StaticData* sData = nullptr;
+
+
+  u64 alignUp( u64 value, u64 alignment )
+  {
+    return ( value + alignment - 1 ) / alignment * alignment;
+  }
+
+
+  Status validatePack( std::span<const byte> bytes, const char* path, std::span<const PackEntry>& out )
+  {
+    auto header = PackHeader();
+    if( bytes.size() < sizeof( header ) )
+    {
+      core::setErrorDetails( "pack '%s' is truncated", path );
+      return StatusBadFile;
+    }
+
+    memcpy( &header, bytes.data(), sizeof( header ) );
+    if( header.magic != PackHeader::sMagic || header.version != PackHeader::sVersion )
+    {
+      core::setErrorDetails( "pack '%s' has unknown format or version", path );
+      return StatusBadFile;
+    }
+
+    if( sizeof( header ) + u64( header.entryCount ) * sizeof( PackEntry ) > bytes.size() )
+    {
+      core::setErrorDetails( "pack '%s' is truncated", path );
+      return StatusBadFile;
+    }
+
+    out = { reinterpret_cast<const PackEntry*>( bytes.data() + sizeof( header ) ), header.entryCount };
+
+    for( const auto& entry: out )
+    {
+      if( entry.offset > bytes.size() || entry.size > bytes.size() - entry.offset )
+      {
+        core::setErrorDetails( "pack '%s' is truncated", path );
+        return StatusBadFile;
+      }
+    }
+
+    return StatusOk;
+  }
+} // namespace
+
+
+Status fs::writePack( const char* path, std::span<const PackSource> files, u32 alignment )
+{
+  assert( std::has_single_bit( alignment ) );
+
+  auto entries    = std::vector<PackEntry>();
+  u64  dataOffset = alignUp( sizeof( PackHeader ) + files.size() * sizeof( PackEntry ), alignment );
+  entries.reserve( files.size() );
+
+  for( const auto& source: files )
+  {
+    auto ec   = std::error_code();
+    u64  size = stdfs::file_size( source.path, ec );
+    if( ec )
+    {
+      core::setErrorDetails( "writePack: file size of '%s': %s", source.path.string().c_str(), ec.message().c_str() );
+      return StatusSystemError;
+    }
+
+    entries.push_back( PackEntry{
+        .id     = StringId( source.name ).getHash(),
+        .offset = dataOffset,
+        .size   = size,
+    } );
+    dataOffset = alignUp( dataOffset + size, alignment );
+  }
+
+  // sources are not sorted, index of source is needed to report collision
+  auto order = std::vector<size_t>();
+  order.reserve( files.size() );
+  for( size_t i = 0; i < files.size(); ++i )
+    order.push_back( i );
+  std::ranges::sort( order, {}, [&entries]( size_t i ) { return entries[i].id; } );
+  for( size_t i = 1; i < order.size(); ++i )
+  {
+    if( entries[order[i]].id == entries[order[i - 1]].id )
+    {
+      core::setErrorDetails( "writePack: '%s' and '%s' have the same id (" mFmtStringHash ")",
+                             files[order[i - 1]].name.c_str(), files[order[i]].name.c_str(), entries[order[i]].id );
+      return StatusSystemError;
+    }
+  }
+
+  auto sortedEntries = std::vector<PackEntry>();
+  sortedEntries.reserve( entries.size() );
+  for( size_t i: order )
+    sortedEntries.push_back( entries[i] );
+
+  auto header = PackHeader{
+      .magic      = PackHeader::sMagic,
+      .version    = PackHeader::sVersion,
+      .entryCount = static_cast<u32>( files.size() ),
+      .alignment  = alignment,
+  };
+
+  auto pack = File( path, "wb" );
+  mCoreCheckStatus( pack.write( &header, sizeof( header ) ) );
+  mCoreCheckStatus( pack.write( sortedEntries.data(), sortedEntries.size() * sizeof( PackEntry ) ) );
+
+  auto padding  = std::vector<byte>( alignment );
+  auto contents = std::vector<byte>();
+  u64  position = sizeof( header ) + sortedEntries.size() * sizeof( PackEntry );
+
+  // sources are read from disk directly, not through mounted pack
+  for( size_t i = 0; i < files.size(); ++i )
+  {
+    mCoreCheckStatus( pack.write( padding.data(), entries[i].offset - position ) );
+
+    auto source = File( files[i].path.string().c_str(), "rb" );
+    if( source.getSize() != entries[i].size )
+    {
+      core::setErrorDetails( "writePack: '%s' changed while pack was written", files[i].name.c_str() );
+      return StatusSystemError;
+    }
+
+    contents.resize( source.getSize() );
+    mCoreCheckStatus( source.read( contents.data(), contents.size() ) );
+    mCoreCheckStatus( pack.write( contents.data(), contents.size() ) );
+    position = entries[i].offset + entries[i].size;
+  }
+
+  return StatusOk;
+}
+
+
+Status fs::mountPack( const char* packPath, const stdfs::path& rootDirectory )
+{
+  unmountPack();
+
+  auto file = MappedFile( packPath );
+  if( !file.isOpen() )
+    return StatusNotFound;
+
+  auto entries = std::span<const PackEntry>();
+  mCoreCheckStatus( validatePack( file.getBytes(), packPath, entries ) );
+
+  auto root = rootDirectory.string();
+  while( !root.empty() && ( root.back() == '/' || root.back() == '\\' ) )
+    root.pop_back();
+
+  mCoreLog( "mounted pack %s: " mFmtSize " files\n", packPath, entries.size() );
+  sData = new StaticData{
+      .file    = std::move( file ),
+      .root    = std::move( root ),
+      .entries = entries,
+  };
+  return StatusOk;
+}
+
+
+void fs::unmountPack()
+{
+  delete sData;
+  sData = nullptr;
+}
+
+
+bool fs::findPackedFile( std::string_view path, std::span<const byte>& out )
+{
+  if( !sData || !path.starts_with( sData->root ) )
+    return false;
+
+  auto name = path.substr( sData->root.size() );
+  if( name.empty() || ( name.front() != '/' && name.front() != '\\' ) )
+    return false;
+
+  // path is made by joining root with relative path, separators of relative part depend on platform
+  auto normalized = std::string( name.substr( 1 ) );
+  std::ranges::replace( normalized, '\\', '/' );
+
+  StringHash id = StringId( normalized ).getHash();
+  auto       it = std::ranges::lower_bound( sData->entries, id, {}, &PackEntry::id );
+  if( it == sData->entries.end() || it->id != id )
+    return false;
+
+  out = sData->file.getBytes().subspan( it->offset, it->size );
+  return true;
+}
@@ -0,0 +1,43 @@
+#pragma once
+#include "core/common.hpp"
+
+namespace core::fs
+{
+  // pack layout: header, entries sorted by id, then data of files, each aligned.
+  // data goes in order files were given to writePack, so files read together should be stored together
+  struct PackHeader
+  {
+    static constexpr u32 sMagic   = 0x4B504853; // SHPK
+    static constexpr u32 sVersion = 1;
+
+    u32 magic;
+    u32 version;
+    u32 entryCount;
+    u32 alignment;
+  };
+
+  struct PackEntry
+  {
+    StringHash id; // of path relative to pack root, '/' separated
+    u64        offset;
+    u64        size;
+  };
+
+  static_assert( sizeof( PackHeader ) % alignof( PackEntry ) == 0 );
+
+  struct PackSource
+  {
+    std::string name; // path relative to pack root, '/' separated
+    stdfs::path path;
+  };
+
+  Status writePack( const char* path, std::span<const PackSource> files, u32 alignment = 64 );
+
+  // while pack is mounted, reads of files under root directory are served from mapped pack without any syscalls.
+  // files which are not in pack are read from disk
+  Status mountPack( const char* packPath, const stdfs::path& rootDirectory );
+  void   unmountPack();
+
+  // view stays valid until unmountPack
+  bool findPackedFile( std::string_view path, std::span<const byte>& out );
+} // namespace core::fs
@@ -0,0 +1,147 @@
+#include "core/hash.hpp"
+
+using namespace core;
+
+
+namespace
+{
+  constexpr u64 sPrime1 = 0x9E3779B185EBCA87ull;
+  constexpr u64 sPrime2 = 0xC2B2AE3D27D4EB4Full;
+  constexpr u64 sPrime3 = 0x165667B19E3779F9ull;
+  constexpr u64 sPrime4 = 0x85EBCA77C2B2AE63ull;
+  constexpr u64 sPrime5 = 0x27D4EB2F165667C5ull;
+
+  u64 read64( const byte* p )
+  {
+    u64 value;
+    memcpy( &value, p, sizeof( value ) );
+    return value; // little endian only
+  }
+
+  u32 read32( const byte* p )
+  {
+    u32 value;
+    memcpy( &value, p, sizeof( value ) );
+    return value;
+  }
+
+  u64 round( u64 acc, u64 input )
+  {
+    acc += input * sPrime2;
+    acc = std::rotl( acc, 31 );
+    return acc * sPrime1;
+  }
+
+  u64 mergeRound( u64 acc, u64 value )
+  {
+    acc ^= round( 0, value );
+    return acc * sPrime1 + sPrime4;
+  }
+
+  void consumeStripe( u64* acc, const byte* p )
+  {
+    acc[0] = round( acc[0], read64( p ) );
+    acc[1] = round( acc[1], read64( p + 8 ) );
+    acc[2] = round( acc[2], read64( p + 16 ) );
+    acc[3] = round( acc[3], read64( p + 24 ) );
+  }
+} // namespace
+
+
+Hasher64::Hasher64( u64 seed )
+    : seed_( seed )
+{
+  acc_[0] = seed + sPrime1 + sPrime2;
+  acc_[1] = seed + sPrime2;
+  acc_[2] = seed;
+  acc_[3] = seed - sPrime1;
+}
+
+void Hasher64::update( std::span<const byte> bytes )
+{
+  const byte* p    = bytes.data();
+  size_t      size = bytes.size();
+  totalSize_ += size;
+
+  // fill pending stripe first
+  if( bufferSize_ )
+  {
+    size_t fill = std::min<size_t>( size, sizeof( buffer_ ) - bufferSize_ );
+    memcpy( buffer_ + bufferSize_, p, fill );
+    bufferSize_ += static_cast<u32>( fill );
+    p += fill;
+    size -= fill;
+
+    if( bufferSize_ < sizeof( buffer_ ) )
+      return;
+
+    consumeStripe( acc_, buffer_ );
+    bufferSize_ = 0;
+  }
+
+  for( ; size >= sizeof( buffer_ ); p += sizeof( buffer_ ), size -= sizeof( buffer_ ) )
+    consumeStripe( acc_, p );
+
+  if( size )
+  {
+    memcpy( buffer_, p, size );
+    bufferSize_ = static_cast<u32>( size );
+  }
+}
+
+u64 Hasher64::digest() const
+{
+  u64 h;
+  if( totalSize_ >= sizeof( buffer_ ) )
+  {
+    h = std::rotl( acc_[0], 1 ) + std::rotl( acc_[1], 7 ) + std::rotl( acc_[2], 12 ) + std::rotl( acc_[3], 18 );
+    h = mergeRound( h, acc_[0] );
+    h = mergeRound( h, acc_[1] );
+    h = mergeRound( h, acc_[2] );
+    h = mergeRound( h, acc_[3] );
+  }
+  else
+  {
+    h = seed_ + sPrime5;
+  }
+
+  h += totalSize_;
+
+  const byte* p   = buffer_;
+  const byte* end = buffer_ + bufferSize_;
+
+  for( ; p + 8 <= end; p += 8 )
+  {
+    h ^= round( 0, read64( p ) );
+    h = std::rotl( h, 27 ) * sPrime1 + sPrime4;
+  }
+
+  if( p + 4 <= end )
+  {
+    h ^= static_cast<u64>( read32( p ) ) * sPrime1;
+    h = std::rotl( h, 23 ) * sPrime2 + sPrime3;
+    p += 4;
+  }
+
+  for( ; p < end; ++p )
+  {
+    h ^= static_cast<u64>( *p ) * sPrime5;
+    h = std::rotl( h, 11 ) * sPrime1;
+  }
+
+  // avalanche
+  h ^= h >> 33;
+  h *= sPrime2;
+  h ^= h >> 29;
+  h *= sPrime3;
+  h ^= h >> 32;
+  return h;
+}
+
+
+u64 core::hash64( std::span<const byte> bytes, u64 seed )
+{
+  auto hasher = Hasher64( seed );
+  hasher.update( bytes );
+  return hasher.digest();
+}
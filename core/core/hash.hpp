@@ -0,0 +1,32 @@
+#pragma once
+#include "core/common.hpp"
+
+namespace core
+{
+  // xxh64 content hash. unlike StringId it is meant for big blobs (file contents, texture data)
+  class Hasher64
+  {
+    u64  acc_[4];
+    byte buffer_[32];
+    u32  bufferSize_ = 0;
+    u64  totalSize_  = 0;
+    u64  seed_;
+
+  public:
+    explicit Hasher64( u64 seed = 0 );
+
+    void update( std::span<const byte> bytes );
+    void update( const void* data, size_t size ) { update( std::span( static_cast<const byte*>( data ), size ) ); }
+
+    template<typename T>
+      requires std::is_trivially_copyable_v<T>
+    void updateValue( const T& value )
+    {
+      update( &value, sizeof( value ) );
+    }
+
+    u64 digest() const;
+  };
+
+  u64 hash64( std::span<const byte> bytes, u64 seed = 0 );
+} // namespace core
@@ -1,4 +1,5 @@
 #include "core/input/input.hpp"
+#include "core/input/replay.hpp"
 
 using namespace core;
 using namespace core::input;
@@ -89,6 +90,7 @@ Status input::init()
 
 void input::destroy()
 {
+  destroyReplay();
   delete sData;
 }
 
@@ -102,6 +104,8 @@ void input::handle( SDL_Event& e )
 {
   if( e.type != SDL_KEYDOWN && e.type != SDL_KEYUP )
     return;
+  if( !replayFilterEvent( e ) )
+    return;
 
   if( Key k = convertSdlKey( e.key.keysym.sym );
       k != KeyCount )
@@ -0,0 +1,211 @@
+#include "core/input/replay.hpp"
+#include "core/input/input.hpp"
+#include "core/fs/file.hpp"
+
+using namespace core;
+using namespace core::input;
+
+
+namespace
+{
+  constexpr u32 sReplayMagic   = 0x50525956; // VYRP
+  constexpr u32 sReplayVersion = 1;
+
+  // file is header, then all frames, then all events of all frames in order
+  struct ReplayHeader
+  {
+    u32 magic;
+    u32 version;
+    u32 frameCount;
+    u32 eventCount;
+  };
+
+  struct ReplayFrame
+  {
+    u32 dtUs;
+    u32 eventCount;
+  };
+
+  struct ReplayEvent
+  {
+    u32 type; // SDL_KEYDOWN or SDL_KEYUP
+    s32 key;  // SDL_Keycode
+    u32 mod;
+  };
+
+  enum ReplayMode
+  {
+    ReplayModeRecording,
+    ReplayModePlaying,
+  };
+
+  struct StaticData
+  {
+    ReplayMode               mode;
+    ReplayOptions            options;
+    std::vector<ReplayFrame> frames;
+    std::vector<ReplayEvent> events;
+    u32                      frameEvents = 0; // recorded for frame which is not finished yet
+    u32                      frameCursor = 0;
+    u32                      eventCursor = 0;
+    bool                     playing     = false; // replayed events pass through input
+  };
+
+  StaticData* sData = nullptr;
+
+
+  template<typename T>
+  void appendBytes( std::vector<byte>& out, std::span<const T> items )
+  {
+    auto* begin = reinterpret_cast<const byte*>( items.data() );
+    out.insert( out.end(), begin, begin + items.size_bytes() );
+  }
+
+  template<typename T>
+  void readItems( std::span<const byte>& in, std::vector<T>& items, u32 count )
+  {
+    items.resize( count );
+    memcpy( items.data(), in.data(), count * sizeof( T ) );
+    in = in.subspan( count * sizeof( T ) );
+  }
+
+  void playEvent( const ReplayEvent& event )
+  {
+    auto e           = SDL_Event{};
+    e.type           = event.type;
+    e.key.keysym.sym = event.key;
+    e.key.keysym.mod = static_cast<Uint16>( event.mod );
+
+    sData->playing = true;
+    input::handle( e );
+    sData->playing = false;
+  }
+} // namespace
+
+
+Status input::startRecording()
+{
+  destroyReplay();
+  sData       = new StaticData();
+  sData->mode = ReplayModeRecording;
+  mCoreLog( "input recording started\n" );
+  return StatusOk;
+}
+
+Status input::stopRecording( const char* path )
+{
+  if( !sData || sData->mode != ReplayModeRecording )
+  {
+    core::setErrorDetails( "input is not recorded" );
+    return StatusNotFound;
+  }
+
+  auto header = ReplayHeader{
+      .magic      = sReplayMagic,
+      .version    = sReplayVersion,
+      .frameCount = static_cast<u32>( sData->frames.size() ),
+      .eventCount = static_cast<u32>( sData->events.size() - sData->frameEvents ),
+  };
+
+  // events of unfinished frame are dropped
+  auto bytes = std::vector<byte>();
+  appendBytes( bytes, std::span<const ReplayHeader>( &header, 1 ) );
+  appendBytes( bytes, std::span<const ReplayFrame>( sData->frames ) );
+  appendBytes( bytes, std::span<const ReplayEvent>( sData->events ).first( header.eventCount ) );
+  mCoreCheckStatus( fs::writeFile( path, bytes ) );
+
+  mCoreLog( "input recording written to %s: " mFmtU32 " frames, " mFmtU32 " events\n", path, header.frameCount, header.eventCount );
+  destroyReplay();
+  return StatusOk;
+}
+
+Status input::startReplay( const char* path, ReplayOptions options )
+{
+  auto bytes = std::vector<byte>();
+  mCoreCheckStatus( fs::readFile( path, bytes ) );
+
+  auto in     = std::span<const byte>( bytes );
+  auto header = ReplayHeader();
+  if( in.size() >= sizeof( header ) )
+    memcpy( &header, in.data(), sizeof( header ) );
+  in = in.subspan( std::min( in.size(), sizeof( header ) ) );
+
+  if( header.magic != sReplayMagic || header.version != sReplayVersion ||
+      in.size() != header.frameCount * sizeof( ReplayFrame ) + header.eventCount * sizeof( ReplayEvent ) )
+  {
+    core::setErrorDetails( "%s is not input recording of version " mFmtU32, path, sReplayVersion );
+    return StatusBadFile;
+  }
+
+  destroyReplay();
+  sData          = new StaticData();
+  sData->mode    = ReplayModePlaying;
+  sData->options = options;
+  readItems( in, sData->frames, header.frameCount );
+  readItems( in, sData->events, header.eventCount );
+
+  u64 frameEvents = 0;
+  for( const auto& frame: sData->frames )
+    frameEvents += frame.eventCount;
+  if( frameEvents != header.eventCount )
+  {
+    destroyReplay();
+    core::setErrorDetails( "%s has events which don't belong to any frame", path );
+    return StatusBadFile;
+  }
+
+  mCoreLog( "replaying %s: " mFmtU32 " frames, " mFmtU32 " events, %s delta time\n", path,
+            header.frameCount, header.eventCount, options.fixedDtUs ? "fixed" : "recorded" );
+  return StatusOk;
+}
+
+bool input::isReplaying()
+{
+  return sData && sData->mode == ReplayModePlaying && sData->frameCursor < sData->frames.size();
+}
+
+u32 input::getReplayFrameCount()
+{
+  return sData ? static_cast<u32>( sData->frames.size() ) : 0;
+}
+
+void input::replayFrameBegin( system::DeltaTime& deltaTime )
+{
+  if( !sData )
+    return;
+
+  if( sData->mode == ReplayModeRecording )
+  {
+    sData->frames.push_back( ReplayFrame{ .dtUs = static_cast<u32>( deltaTime.getUs() ), .eventCount = sData->frameEvents } );
+    sData->frameEvents = 0;
+    return;
+  }
+
+  if( !isReplaying() )
+    return;
+
+  const auto& frame = sData->frames[sData->frameCursor++];
+  for( u32 i = 0; i < frame.eventCount; ++i )
+    playEvent( sData->events[sData->eventCursor++] );
+
+  deltaTime.setUs( sData->options.fixedDtUs ? sData->options.fixedDtUs : frame.dtUs );
+}
+
+bool input::replayFilterEvent( const SDL_Event& e )
+{
+  if( !sData )
+    return true;
+
+  if( sData->mode == ReplayModePlaying )
+    return sData->playing;
+
+  sData->events.push_back( ReplayEvent{ .type = e.type, .key = e.key.keysym.sym, .mod = e.key.keysym.mod } );
+  sData->frameEvents++;
+  return true;
+}
+
+void input::destroyReplay()
+{
+  delete sData;
+  sData = nullptr;
+}
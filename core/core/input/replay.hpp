@@ -0,0 +1,29 @@
+#pragma once
+#include "core/common.hpp"
+#include "core/system/time.hpp"
+
+// recording of all that makes two runs of the same scene differ: key events and delta time of every frame.
+// async loads still finish when they finish, so replay is deterministic for camera and logic driven by input
+namespace core::input
+{
+  struct ReplayOptions
+  {
+    u64 fixedDtUs = 0; // 0 plays delta times as they were recorded
+  };
+
+  Status startRecording();
+  Status stopRecording( const char* path ); // writes what was recorded so far
+
+  // live keyboard is ignored while replay plays
+  Status startReplay( const char* path, ReplayOptions options = {} );
+  bool   isReplaying(); // false once last recorded frame is played
+  u32    getReplayFrameCount();
+
+  // core loop, after events of frame are handled: records frame or plays next one into input and delta time
+  void replayFrameBegin( system::DeltaTime& deltaTime );
+
+  // input, for every event: records it, returns false when live input is replaced by replay
+  bool replayFilterEvent( const SDL_Event& e );
+
+  void destroyReplay();
+} // namespace core::input
@@ -5,29 +5,6 @@
 using namespace core;
 using namespace core::logic;
 
-namespace
-{
-  core::render::Mesh* findMesh( core::data::RenderChunksView renderChunks, StringId id )
-  {
-    for( auto& chunk: renderChunks )
-      if( auto* mesh = chunk.getMesh( id ) )
-        return mesh;
-
-    assert( false ); // mesh not found
-    return nullptr;  // TODO: return default?
-  }
-
-  core::render::Texture* findTexture( core::data::RenderChunksView renderChunks, StringId id )
-  {
-    for( auto& chunk: renderChunks )
-      if( auto* mesh = chunk.getTexture( id ) )
-        return mesh;
-
-    assert( false ); // texture not found
-    return nullptr;  // TODO: return default?
-  }
-} // namespace
-
 
 Mat4 TransformComponent::getWorldTransform() const
 {
@@ -39,22 +16,30 @@ Mat4 TransformComponent::getWorldTransform() const
 
 void MaterialComponent::init()
 {
-  textureDiffuse = findTexture( getEntity()->getScene()->getRenderChunks(), props.textureDiffuseId );
+  textureDiffuse = data::findTexture( props.textureDiffuseId );
+  assert( textureDiffuse.isResident() ); // texture not found. TODO: return default?
 }
 
 
 void RenderMeshComponent::init()
 {
-  mesh      = findMesh( getEntity()->getScene()->getRenderChunks(), props.meshId );
+  mesh      = data::findMesh( props.meshId );
+  assert( mesh.isResident() ); // mesh not found. TODO: return default?
   transform = getComponent<TransformComponent>();
   material  = getComponent<MaterialComponent>();
 }
 
 void RenderMeshComponent::update( const core::system::DeltaTime& )
 {
+  // chunk with asset may be evicted while scene is alive, render pass expects both of them
+  auto* meshAsset    = mesh.get();
+  auto* textureAsset = material->textureDiffuse.get();
+  if( !meshAsset || !textureAsset )
+    return;
+
   auto drawable = render::RenderList::Drawable{
-      .mesh           = mesh,
-      .diffuseTexture = material->textureDiffuse,
+      .mesh           = meshAsset,
+      .diffuseTexture = textureAsset,
       .blendMode      = material->props.blendMode,
       .worldTransform = transform->getWorldTransform(),
   };
@@ -2,6 +2,7 @@
 #include "core/common.hpp"
 #include "core/logic/entity-system.hpp"
 #include "core/render/render.hpp"
+#include "core/data/asset-index.hpp"
 
 namespace core::logic
 {
@@ -36,7 +37,7 @@ namespace core::logic
 
     mCoreComponent( MaterialComponent );
 
-    core::render::Texture* textureDiffuse;
+    core::data::TextureHandle textureDiffuse;
 
     void init() override;
   };
@@ -54,9 +55,9 @@ namespace core::logic
 
     mCoreComponent( RenderMeshComponent );
 
-    core::render::Mesh* mesh;
-    MaterialComponent*  material;
-    TransformComponent* transform;
+    core::data::MeshHandle mesh;
+    MaterialComponent*     material;
+    TransformComponent*    transform;
 
     void init() override;
     void update( const core::system::DeltaTime& ) override;
@@ -73,6 +73,7 @@ Component::~Component()
 }
 
 void Component::deserialize( const Json& obj ) { ( void ) obj; }
+void Component::deserializeBinary( std::span<const byte> bytes ) { ( void ) bytes; }
 void Component::init() {}
 void Component::shutdown() {}
 void Component::update( const system::DeltaTime& dt ) { ( void ) dt; }
@@ -15,7 +15,15 @@
                                                                              \
   ~Class() override = default;                                               \
                                                                              \
-  void deserialize( const Json& obj ) override { props = obj.get<Props>(); }
+  void deserialize( const Json& obj ) override { props = obj.get<Props>(); } \
+                                                                             \
+  void deserializeBinary( std::span<const byte> bytes ) override             \
+  {                                                                          \
+    static_assert( std::is_trivially_copyable_v<Props> );                    \
+    if( bytes.size() != sizeof( Props ) )                                    \
+      throw std::runtime_error( "binary props size mismatch" );              \
+    memcpy( &props, bytes.data(), sizeof( Props ) );                         \
+  }
 
 
 namespace core
@@ -75,7 +83,8 @@ namespace core
     Entity* getEntity() const { return entity_; }
 
     virtual void deserialize( const Json& obj );
-    virtual void init();
+    virtual void deserializeBinary( std::span<const byte> bytes ); // props from binary scene
+    virtual void init(); // scene from data is initialized on worker, before main thread can see it
     virtual void shutdown();
     virtual void update( const system::DeltaTime& dt );
 
@@ -117,7 +126,7 @@ namespace core
     Entity* addEntity( StringId id );
 
     data::RenderChunksView getRenderChunks() { return renderChunks_; }
-    void                   setRenderChunks( data::RenderChunks renderChunks ) { renderChunks_ = renderChunks; }
+    void                   setRenderChunks( data::RenderChunks renderChunks ) { renderChunks_ = std::move( renderChunks ); }
 
     // TODO: it looks weird...
     auto entitiesIteratorBegin() { return entities_.begin(); }
@@ -8,17 +8,42 @@ using namespace core::logic;
 
 namespace
 {
+  // binary scene is used when it exists, json one is for debugging
+  struct SceneSource
+  {
+    data::ShSceneInfo                          json;
+    std::shared_ptr<const data::ShBinaryScene> binary; // stays mapped until scene is activated
+
+    std::span<const StringHash> getRenderChunks() const { return binary ? binary->getRenderChunks() : json.render_chunks; }
+  };
+
   struct SceneInfo
   {
-    Scene             scene;
-    bool              isLoading = false;
-    system::Stopwatch loadingTime;
+    std::unique_ptr<Scene> scene; // empty one while loading, built scene replaces it
+    bool                   isLoading = false;
+    data::LoadToken        load; // cancelled when scene is unloaded before it is activated
+    data::RenderChunks     renderChunks; // held here while scene is built, ref counts are main thread only
+    system::Stopwatch      loadingTime;
+    u64                    uploadedGpuBytesBefore = data::getRenderChunkStats().uploadedGpuBytes; // to report transition cost
+  };
+
+  // scene data loaded in background, but not activated yet
+  struct ScenePrefetch
+  {
+    bool               isLoading    = true;
+    data::LoadToken    load         = data::LoadToken( data::LoadPriority_Prefetch );
+    SceneInfo*         waitingScene = nullptr; // scene load requested while prefetch is in flight
+    SceneSource        source;
+    data::RenderChunks renderChunks;
+    system::Stopwatch  loadingTime;
   };
 
   struct StaticData
   {
-    StringIdMap<ComponentFabric> componentFabrics;
-    std::list<SceneInfo>         scenes;
+    StringIdMap<ComponentFabric>                componentFabrics;
+    std::list<SceneInfo>                        scenes;
+    StringIdMap<std::shared_ptr<ScenePrefetch>> prefetches;
+    ScenePrefetchStats                          prefetchStats;
   };
 
   StaticData* sData = nullptr;
@@ -44,46 +69,262 @@ namespace
     }
   }
 
-  void loadSceneAsync( StringId sceneId, SceneInfo* scene )
+  void instantiateBinaryComponents( Scene& scene, const data::ShBinaryScene& binary )
+  {
+    auto entities = binary.getEntities() |
+                    std::views::transform( [&scene]( StringHash id ) { return scene.addEntity( id ); } ) |
+                    std::ranges::to<std::vector>();
+
+    // TODO: this is developer's try-catch
+    try
+    {
+      for( const auto& block: binary.getComponentBlocks() )
+      {
+        auto blockEntities = binary.getBlockEntities( block );
+        for( u32 i = 0; i < block.count; ++i )
+        {
+          auto* entity            = entities[blockEntities[i]];
+          auto* componentInstance = componentInstantiate( block.type, entity );
+          componentInstance->deserializeBinary( binary.getBlockProps( block, i ) );
+          entity->addComponent( block.type, componentInstance );
+        }
+      }
+    }
+    catch( std::exception& ex )
+    {
+      mCoreLogError( "instantiate components of binary scene " mFmtStringHash " failed: %s\n",
+                     scene.getId().getHash(), ex.what() );
+      assert( false );
+    }
+  }
+
+  u64 getRenderChunksGpuBytes( const data::RenderChunks& renderChunks )
+  {
+    u64 bytes = 0;
+    for( const auto& chunk: renderChunks )
+      bytes += chunk.getGpuBytes();
+    return bytes;
+  }
+
+  // binary scene is mapped, it is not read at all. json is read by async io and parsed on worker
+  cti::continuable<SceneSource> readSceneSourceAsync( const std::string& path, bool isBinary,
+                                                      system::task::TaskPriority priority )
+  {
+    if( isBinary )
+    {
+      return system::task::ctiAsync( [path]() -> std::expected<SceneSource, Status> {
+        mCoreMemoryScope( Logic );
+        auto source = SceneSource();
+        auto binary = std::make_shared<data::ShBinaryScene>();
+        if( auto s = binary->open( path ); s != StatusOk )
+          return std::unexpected( s );
+        source.binary = std::move( binary );
+        return { std::move( source ) };
+      },
+                                     priority );
+    }
+
+    bool isCompressed = fs::isCompressedJson( path );
+    return fs::ctiReadFile( path ).then( [priority, isCompressed]( fs::FileBytes file ) {
+      return system::task::ctiAsync( [file = std::move( file ), isCompressed]() -> std::expected<SceneSource, Status> {
+        mCoreMemoryScope( Logic );
+        auto source = SceneSource();
+        auto json   = Json();
+        if( auto s = fs::decodeJson( file.getBytes(), json, isCompressed ); s != StatusOk )
+          return std::unexpected( s );
+        if( auto s = data::fromJson( json, source.json ); s != StatusOk )
+          return std::unexpected( s );
+        return { std::move( source ) };
+      },
+                                     priority );
+    } );
+  }
+
+  // reads scene description and loads all its render chunks, results are delivered on main thread.
+  // token goes to every render chunk, so cancelled scene load drops chunks nobody else waits for
+  auto loadSceneDataAsync( StringId sceneId, data::LoadToken token )
   {
-    scene->isLoading   = true;
-    auto sceneJsonPath = data::getDataPath( StringId( sceneId, ".scene.json" ) );
+    auto binaryId     = StringId( sceneId, ".scene.bin" );
+    auto compressedId = StringId( sceneId, ".scene.json.zst" );
+    bool isBinary     = data::hasDataPath( binaryId );
+    auto jsonId       = data::hasDataPath( compressedId ) ? compressedId : StringId( sceneId, ".scene.json" );
+    auto scenePath    = data::getDataPath( isBinary ? binaryId : jsonId );
+    if( token.getPriority() == data::LoadPriority_Prefetch )
+      fs::adviseWillNeed( scenePath );
 
-    system::task::ctiAsync( [sceneJsonPath]() -> std::expected<data::ShSceneInfo, Status> {
-      return utils::turnIntoExpected( data::readJsonFile, sceneJsonPath );
-    } )
-        .then( []( data::ShSceneInfo sceneInfo ) {
-          auto renderChunks = sceneInfo.render_chunks |
-                              std::views::transform( []( StringHash h ) { return StringId( h ); } ) |
-                              std::views::transform( data::RenderChunk::loadCti ) |
+    return readSceneSourceAsync( scenePath, isBinary, token.getTaskPriority() )
+        .then( [token]( SceneSource source ) {
+          // render chunks are managed from main thread
+          return system::task::ctiDeffered(
+              [source = std::move( source ), token]() mutable -> std::expected<SceneSource, Status> {
+                if( token.isCancelled() )
+                  return std::unexpected( StatusCancelled );
+                return { std::move( source ) };
+              } );
+        } )
+        .then( [token]( SceneSource source ) {
+          auto renderChunks = source.getRenderChunks() |
+                              std::views::transform( [&token]( StringHash h ) {
+                                return data::RenderChunk::loadCti( StringId( h ), token );
+                              } ) |
                               std::ranges::to<std::vector>();
-          return cti::when_all( std::move( sceneInfo ), std::move( renderChunks ) );
+          return cti::when_all( std::move( source ), std::move( renderChunks ) );
+        } );
+  }
+
+  // worker: scene is not visible to anybody yet, so nothing else touches its entities. component init
+  // may only look at its own entity and at assets of chunks which are loaded before build starts
+  std::unique_ptr<Scene> buildScene( StringId sceneId, const SceneSource& source )
+  {
+    mCoreProfileScope( "build scene" );
+    auto scene = std::make_unique<Scene>( sceneId );
+
+    if( source.binary )
+    {
+      instantiateBinaryComponents( *scene, *source.binary );
+    }
+    else
+    {
+      for( const auto& object: source.json.objects )
+      {
+        auto* entity = scene->addEntity( object.id );
+        instantiateComponents( *entity, object );
+      }
+    }
+
+    scene->init();
+    return scene;
+  }
+
+  void publishScene( SceneInfo* scene, std::unique_ptr<Scene> built, u64 buildMs )
+  {
+    mCoreMemoryScope( Logic );
+    built->setRenderChunks( std::move( scene->renderChunks ) );
+    scene->scene     = std::move( built );
+    scene->isLoading = false;
+    mCoreLog( "scene " mFmtStringHash " loaded and initialized. it took " mFmtU64 "ms (built in " mFmtU64 "ms), uploaded " mFmtU64 " gpu bytes\n",
+              scene->scene->getId().getHash(), scene->loadingTime.getMs(), buildMs,
+              data::getRenderChunkStats().uploadedGpuBytes - scene->uploadedGpuBytesBefore );
+
+    const auto& chunkStats = data::getRenderChunkStats();
+    mCoreLog( "render chunk cache: hit rate %.2f (" mFmtU64 "/" mFmtU64 "), evictions " mFmtU64 ", cached " mFmtU32 " chunks (" mFmtU64 " gpu bytes)\n",
+              static_cast<f64>( chunkStats.getHitRate() ), chunkStats.hits, chunkStats.hits + chunkStats.misses,
+              chunkStats.evictions, chunkStats.cachedChunks, chunkStats.cachedGpuBytes );
+
+    const auto& prefetchStats = sData->prefetchStats;
+    mCoreLog( "scene prefetch: hits " mFmtU64 ", misses " mFmtU64 ", prefetched " mFmtU64 " bytes, wasted " mFmtU64 " bytes\n",
+              prefetchStats.hits, prefetchStats.misses, prefetchStats.prefetchedBytes, prefetchStats.wastedBytes );
+
+    data::logLoadSchedulerStats();
+  }
+
+  // entities are created and initialized on worker, main thread only swaps finished scene in, so
+  // activation costs the same for any scene size. scene keeps loading until then
+  void activateScene( SceneInfo* scene, SceneSource source, data::RenderChunks renderChunks )
+  {
+    scene->isLoading    = true;
+    scene->renderChunks = std::move( renderChunks );
+
+    auto token   = scene->load;
+    auto sceneId = scene->scene->getId();
+    system::task::runAsync( [scene, token, sceneId, source = std::move( source )]() {
+      if( token.isCancelled() )
+        return;
+
+      mCoreMemoryScope( Logic );
+      auto stopwatch = system::Stopwatch();
+      auto built     = buildScene( sceneId, source );
+      u64  buildMs   = stopwatch.getMs();
+
+      system::task::runDeffered( [scene, token, built = std::move( built ), buildMs]() mutable {
+        // unloaded meanwhile, scene info is gone
+        if( token.isCancelled() )
+        {
+          built->shutdown();
+          return;
+        }
+        publishScene( scene, std::move( built ), buildMs );
+      } );
+    },
+                            token.getTaskPriority() );
+  }
+
+  void erasePrefetch( StringId sceneId, const ScenePrefetch* prefetch )
+  {
+    // cancelled prefetch may be already replaced by new one
+    if( auto* it = sData->prefetches.try_get( sceneId ); it && it->get() == prefetch )
+      sData->prefetches.erase( sceneId );
+  }
+
+  // scene pointer is valid only while its token is not cancelled: unload erases scene and cancels token.
+  // failures are reported from io and worker threads, so they are moved to main thread first
+  void loadSceneAsync( StringId sceneId, SceneInfo* scene )
+  {
+    scene->isLoading = true;
+    auto token       = scene->load;
+
+    loadSceneDataAsync( sceneId, token )
+        .then( [scene, token]( SceneSource source, data::RenderChunks renderChunks ) {
+          if( !token.isCancelled() )
+            activateScene( scene, std::move( source ), std::move( renderChunks ) );
         } )
-        .then( [scene]( data::ShSceneInfo              sceneInfo,
-                        std::vector<data::RenderChunk> renderChunks ) {
-          scene->scene.setRenderChunks( std::move( renderChunks ) );
+        .fail( [scene, token]( Status s ) {
+          system::task::runDeffered( [scene, token, s]() {
+            if( token.isCancelled() )
+              return;
+            mCoreLogError( "scene load failed: %d\n", static_cast<int>( s ) );
+            scene->isLoading = false;
+          } );
+        } );
+  }
 
-          for( const auto& object: sceneInfo.objects )
+  void prefetchSceneAsync( StringId sceneId, std::shared_ptr<ScenePrefetch> prefetch )
+  {
+    loadSceneDataAsync( sceneId, prefetch->load )
+        .then( [sceneId, prefetch]( SceneSource source, data::RenderChunks renderChunks ) {
+          u64 bytes           = getRenderChunksGpuBytes( renderChunks );
+          prefetch->isLoading = false;
+          sData->prefetchStats.prefetchedBytes += bytes;
+
+          mCoreLog( "scene " mFmtStringHash " prefetched in " mFmtU64 "ms (" mFmtU64 " gpu bytes)\n",
+                    sceneId.getHash(), prefetch->loadingTime.getMs(), bytes );
+
+          if( prefetch->load.isCancelled() )
           {
-            auto* entity = scene->scene.addEntity( object.id );
-            instantiateComponents( *entity, object );
+            // chunks are released here, they stay in render chunk cache until evicted
+            sData->prefetchStats.wastedBytes += bytes;
+            erasePrefetch( sceneId, prefetch.get() );
+          }
+          else if( prefetch->waitingScene )
+          {
+            sData->prefetches.erase( sceneId );
+            activateScene( prefetch->waitingScene, std::move( source ), std::move( renderChunks ) );
+          }
+          else
+          {
+            prefetch->source       = std::move( source );
+            prefetch->renderChunks = std::move( renderChunks );
           }
-
-          scene->scene.init();
-          scene->isLoading = false;
-          mCoreLog( "scene " mFmtStringHash " loaded and initialized. it took " mFmtU64 "ms\n",
-                    scene->scene.getId().getHash(), scene->loadingTime.getMs() );
         } )
-        .fail( [scene]( Status s ) {
-          mCoreLogError( "scene load failed: %d\n", static_cast<int>( s ) );
-          scene->isLoading = false;
+        .fail( [sceneId, prefetch]( Status s ) {
+          system::task::runDeffered( [sceneId, prefetch, s]() {
+            erasePrefetch( sceneId, prefetch.get() );
+            if( prefetch->load.isCancelled() )
+              return;
+
+            mCoreLogError( "scene " mFmtStringHash " prefetch failed: %d\n", sceneId.getHash(), static_cast<int>( s ) );
+            if( prefetch->waitingScene )
+              loadSceneAsync( sceneId, prefetch->waitingScene );
+          } );
         } );
   }
+
 } // namespace
 
 
 Status logic::init()
 {
+  mCoreMemoryScope( Logic );
   sData = new StaticData();
   registerComponents();
   return StatusOk;
@@ -91,18 +332,27 @@ Status logic::init()
 
 void logic::destroy()
 {
+  // scene builds on workers use component fabrics and assets: pending ones are dropped, running ones finish first
+  for( auto& sceneInfo: sData->scenes )
+    sceneInfo.load.cancel();
+  for( auto& [sceneId, prefetch]: sData->prefetches )
+    prefetch->load.cancel();
+  system::task::wait();
+
   delete sData;
 }
 
 void logic::update()
 {
+  mCoreProfileScope( "logic::update" );
+  mCoreMemoryScope( Logic );
   bool hasActiveScene = false;
 
   for( auto& sceneInfo: sData->scenes )
   {
     if( !sceneInfo.isLoading )
     {
-      sceneInfo.scene.update( loopGetDeltaTime() );
+      sceneInfo.scene->update( loopGetDeltaTime() );
       hasActiveScene = true;
     }
   }
@@ -113,12 +363,32 @@ void logic::update()
   }
 }
 
+bool logic::hasActiveScene()
+{
+  for( const auto& sceneInfo: sData->scenes )
+    if( !sceneInfo.isLoading )
+      return true;
+  return false;
+}
+
+bool logic::isLoading()
+{
+  for( const auto& sceneInfo: sData->scenes )
+    if( sceneInfo.isLoading )
+      return true;
+  for( const auto& [sceneId, prefetch]: sData->prefetches )
+    if( prefetch->isLoading )
+      return true;
+  return false;
+}
+
 void logic::sceneLoad( StringId sceneId )
 {
+  mCoreMemoryScope( Logic );
   mCoreLog( "loading scene " mFmtStringHash "\n", sceneId.getHash() );
 
   auto it = std::ranges::find_if( sData->scenes, [=]( SceneInfo& scene ) {
-    return scene.scene.getId() == sceneId;
+    return scene.scene->getId() == sceneId;
   } );
   if( it != sData->scenes.end() )
   {
@@ -127,16 +397,89 @@ void logic::sceneLoad( StringId sceneId )
   }
 
   mCoreLog( "loading scene " mFmtStringHash "...\n", sceneId.getHash() );
-  auto* scene = &sData->scenes.emplace_back( Scene( sceneId ) );
+  auto* scene = &sData->scenes.emplace_back( SceneInfo{
+      .scene = std::make_unique<Scene>( sceneId ),
+      .load  = data::LoadToken( data::LoadPriority_Blocking ),
+  } );
+
+  auto* prefetchPtr = sData->prefetches.try_get( sceneId );
+  if( !prefetchPtr )
+  {
+    sData->prefetchStats.misses++;
+    loadSceneAsync( sceneId, scene );
+    return;
+  }
+
+  auto prefetch = *prefetchPtr;
+  sData->prefetchStats.hits++;
+
+  if( prefetch->isLoading )
+  {
+    // activate as soon as prefetch completes. scene shares prefetch token, so its unload cancels prefetch
+    prefetch->load.setPriority( data::LoadPriority_Blocking );
+    prefetch->waitingScene = scene;
+    scene->load            = prefetch->load;
+    scene->isLoading       = true;
+    return;
+  }
+
+  sData->prefetches.erase( sceneId );
+  activateScene( scene, std::move( prefetch->source ), std::move( prefetch->renderChunks ) );
+}
+
+void logic::scenePrefetch( StringId sceneId, data::LoadPriority priority )
+{
+  if( auto* prefetch = sData->prefetches.try_get( sceneId ) )
+  {
+    // scene load which waits for this prefetch already made it blocking
+    if( !( *prefetch )->waitingScene )
+      ( *prefetch )->load.setPriority( priority );
+    return;
+  }
+
+  auto it = std::ranges::find_if( sData->scenes, [=]( SceneInfo& scene ) {
+    return scene.scene->getId() == sceneId;
+  } );
+  if( it != sData->scenes.end() )
+    return;
+
+  mCoreLog( "prefetching scene " mFmtStringHash "...\n", sceneId.getHash() );
+  auto prefetch = std::make_shared<ScenePrefetch>();
+  prefetch->load.setPriority( priority );
+  sData->prefetches.emplace_unique( sceneId, prefetch );
 
-  loadSceneAsync( sceneId, scene );
+  prefetchSceneAsync( sceneId, std::move( prefetch ) );
+}
+
+void logic::scenePrefetchCancel( StringId sceneId )
+{
+  auto* prefetchPtr = sData->prefetches.try_get( sceneId );
+  if( !prefetchPtr )
+    return;
+
+  auto prefetch = *prefetchPtr;
+  if( prefetch->waitingScene )
+    return;
+
+  mCoreLog( "cancel prefetch of scene " mFmtStringHash "\n", sceneId.getHash() );
+
+  // chunks not loaded yet are dropped by load scheduler, following prefetch starts over
+  prefetch->load.cancel();
+  if( !prefetch->isLoading )
+    sData->prefetchStats.wastedBytes += getRenderChunksGpuBytes( prefetch->renderChunks );
+  sData->prefetches.erase( sceneId );
+}
+
+const ScenePrefetchStats& logic::getScenePrefetchStats()
+{
+  return sData->prefetchStats;
 }
 
 void logic::sceneUnload( StringId sceneId )
 {
   core::system::task::runDeffered( [sceneId]() {
     auto it = std::ranges::find_if( sData->scenes, [=]( SceneInfo& scene ) {
-      return scene.scene.getId() == sceneId;
+      return scene.scene->getId() == sceneId;
     } );
 
     if( it == sData->scenes.end() )
@@ -147,12 +490,17 @@ void logic::sceneUnload( StringId sceneId )
 
     if( it->isLoading )
     {
-      mCoreLogError( "trying to unload scene " mFmtStringHash " which is loading\n", sceneId.getHash() );
+      // render chunks requested only by this scene are cancelled, shared ones keep loading
+      mCoreLog( "cancel loading of scene " mFmtStringHash "\n", sceneId.getHash() );
+      it->load.cancel();
+      if( auto* prefetch = sData->prefetches.try_get( sceneId ); prefetch && ( *prefetch )->waitingScene == &*it )
+        sData->prefetches.erase( sceneId );
+      sData->scenes.erase( it );
       return;
     }
 
     mCoreLog( "unloading scene " mFmtStringHash "...\n", sceneId.getHash() );
-    it->scene.shutdown();
+    it->scene->shutdown();
     sData->scenes.erase( it );
   } );
 }
@@ -160,10 +508,10 @@ void logic::sceneUnload( StringId sceneId )
 Scene* logic::sceneNew( const char* name )
 {
   auto& sceneInfo = sData->scenes.emplace_back( SceneInfo{
-      .scene     = core::Scene( StringId( name ) ),
+      .scene     = std::make_unique<core::Scene>( StringId( name ) ),
       .isLoading = false,
   } );
-  return &sceneInfo.scene;
+  return sceneInfo.scene.get();
 }
 
 void logic::componentRegister( StringId componentId, ComponentFabric componentFabric )
@@ -1,5 +1,6 @@
 #pragma once
 #include "core/common.hpp"
+#include "core/data/load-scheduler.hpp"
 #include "core/logic/entity-system.hpp"
 #include "core/logic/components.hpp"
 
@@ -10,10 +11,28 @@ namespace core::logic
   void   destroy();
   void   update();
 
+  struct ScenePrefetchStats
+  {
+    u64 hits            = 0; // scene load found prefetched (or prefetching) scene data
+    u64 misses          = 0; // scene load had to start from scratch
+    u64 prefetchedBytes = 0;
+    u64 wastedBytes     = 0; // prefetched, but cancelled before activation
+  };
+
+  bool isLoading();      // any scene or prefetch
+  bool hasActiveScene(); // otherwise loading screen is shown
+
   void   sceneLoad( StringId sceneId );
   void   sceneUnload( StringId sceneId );
   Scene* sceneNew( const char* name );
 
+  // loads scene json and render chunks in background, without activating scene.
+  // following sceneLoad of the same scene picks up prefetched data, repeated call changes priority.
+  // cancel drops render chunks which are not loaded yet, unless other scene needs them
+  void                      scenePrefetch( StringId sceneId, data::LoadPriority priority = data::LoadPriority_Prefetch );
+  void                      scenePrefetchCancel( StringId sceneId );
+  const ScenePrefetchStats& getScenePrefetchStats();
+
   using ComponentFabric = std::function<Component*( Entity* )>;
 
   void       componentRegister( StringId componentId, ComponentFabric componentFabric );
@@ -74,6 +74,23 @@ bool BoundingBox::isInside( Vec3 point ) const
          isInsideProjection( bz );
 }
 
+f32 BoundingBox::distanceTo( Vec3 point ) const
+{
+  Vec3 p = point - center;
+
+  auto outsideProjection = [p]( Vec3 axis ) {
+    // normalized, then clamped to [0..1] edge
+    auto projPtoAxis = glm::dot( p, axis ) /
+                       glm::length2( axis );
+    auto outside     = projPtoAxis < 0.0f ? -projPtoAxis : glm::max( projPtoAxis - 1.0f, 0.0f );
+    return outside * glm::length( axis );
+  };
+
+  return glm::length( Vec3( outsideProjection( bx ),
+                            outsideProjection( by ),
+                            outsideProjection( bz ) ) );
+}
+
 void BoundingBox::debugDraw( Vec4 color ) const
 {
   auto A1 = center;
@@ -1,6 +1,10 @@
 #pragma once
 #include "core/common.hpp"
-#include "core/render/gapi/resources.hpp"
+#if mCoreHeadless
+#  include "core/render/null/resources.hpp"
+#else
+#  include "core/render/gapi/resources.hpp"
+#endif
 
 namespace core::render
 {
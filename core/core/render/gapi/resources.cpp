@@ -312,10 +312,10 @@ Status VertexShader::init( ArrayBytesView bytes, VertexShaderLayout layout )
   return StatusOk;
 }
 
-Status VertexShader::initFromSource( const char* directory, const char* name, VertexShaderLayout layout )
+Status VertexShader::initFromSource( const char* directory, const char* name, std::span<const byte> source, VertexShaderLayout layout )
 {
   auto shaderBytes = std::vector<byte>{};
-  mCoreCheckStatus( compileShader( directory, name, ShaderTypeVertex, shaderBytes ) );
+  mCoreCheckStatus( compileShader( directory, name, source, ShaderTypeVertex, shaderBytes ) );
   return init( ArrayBytesView::fromContainer( shaderBytes ), layout );
 }
 
@@ -336,10 +336,10 @@ Status PixelShader::init( ArrayBytesView bytes )
   return StatusOk;
 }
 
-Status PixelShader::initFromSource( const char* directory, const char* name )
+Status PixelShader::initFromSource( const char* directory, const char* name, std::span<const byte> source )
 {
   auto shaderBytes = std::vector<byte>{};
-  mCoreCheckStatus( compileShader( directory, name, ShaderTypePixel, shaderBytes ) );
+  mCoreCheckStatus( compileShader( directory, name, source, ShaderTypePixel, shaderBytes ) );
   return init( ArrayBytesView::fromContainer( shaderBytes ) );
 }
 
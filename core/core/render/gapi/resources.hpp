@@ -112,7 +112,7 @@ namespace core::render::gapi
     ComPtr<ID3D11InputLayout>  inputLayout;
 
     Status init( ArrayBytesView bytes, VertexShaderLayout layout );
-    Status initFromSource( const char* directory, const char* name, VertexShaderLayout layout );
+    Status initFromSource( const char* directory, const char* name, std::span<const byte> source, VertexShaderLayout layout );
     void   use();
   };
 
@@ -122,7 +122,7 @@ namespace core::render::gapi
     ComPtr<ID3D11PixelShader> pixelShader;
 
     Status init( ArrayBytesView bytes );
-    Status initFromSource( const char* directory, const char* name );
+    Status initFromSource( const char* directory, const char* name, std::span<const byte> source );
     void   use();
   };
 
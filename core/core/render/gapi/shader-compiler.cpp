@@ -44,26 +44,21 @@ namespace
       ( void ) includeType;
       ( void ) pParentData;
 
+      // includes may be packed too
       auto path = core::fs::pathJoin( directory_, pFileName );
-      auto f    = core::fs::File{ path.c_str(), "rb" };
+      auto view = core::fs::FileView();
 
-      if( !f.isOpen() || !f.getSize() )
+      if( view.open( path.c_str() ) != StatusOk || view.getBytes().empty() )
       {
         mCoreLogError( "error open shader include file: '%s'\n", pFileName );
         return E_UNEXPECTED;
       }
 
-      auto* bytes = new byte[f.getSize()];
-
-      if( f.read( bytes, f.getSize() ) != StatusOk )
-      {
-        mCoreLogError( "error read shader include file: '%s'\n", pFileName );
-        delete[] bytes;
-        return E_UNEXPECTED;
-      }
+      auto* bytes = new byte[view.getBytes().size()];
+      std::ranges::copy( view.getBytes(), bytes );
 
       *ppData = bytes;
-      *pBytes = static_cast<UINT>( f.getSize() );
+      *pBytes = static_cast<UINT>( view.getBytes().size() );
 
       return S_OK;
     }
@@ -92,7 +87,16 @@ Status render::gapi::compileShader( const char*      directory,
 {
   auto bytes = std::vector<byte>();
   mCoreCheckStatus( fs::readFile( fs::pathJoin( directory, name ), bytes ) );
+  return compileShader( directory, name, bytes, shaderType, out );
+}
+
 
+Status render::gapi::compileShader( const char*           directory,
+                                    const char*           name,
+                                    std::span<const byte> source,
+                                    ShaderType            shaderType,
+                                    std::vector<u8>&      out )
+{
   UINT flags = D3DCOMPILE_ENABLE_STRICTNESS |
                D3DCOMPILE_OPTIMIZATION_LEVEL3 |
                D3DCOMPILE_WARNINGS_ARE_ERRORS;
@@ -108,7 +112,7 @@ Status render::gapi::compileShader( const char*      directory,
   const char* profile        = shaderTypeToProfileName( shaderType );
   auto        includeHandler = IncludeHandler{ directory };
 
-  auto hrr = ::D3DCompile( bytes.data(), bytes.size(),
+  auto hrr = ::D3DCompile( source.data(), source.size(),
                            name, defines, &includeHandler,
                            "main", profile, flags, 0, &shaderBlob, &errorBlob );
 
@@ -15,4 +15,11 @@ namespace core::render::gapi
                         ShaderType       shaderType,
                         std::vector<u8>& out );
 
+  // source is already read, includes are still read from directory
+  Status compileShader( const char*           directory,
+                        const char*           name,
+                        std::span<const byte> source,
+                        ShaderType            shaderType,
+                        std::vector<u8>&      out );
+
 } // namespace core::render::gapi
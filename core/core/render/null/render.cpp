@@ -0,0 +1,52 @@
+#include "core/render/render.hpp"
+#include "core/render/render-thread.hpp"
+
+using namespace core;
+using namespace core::render;
+
+namespace
+{
+  constexpr Vec2 sViewportSize = { 1920, 1080 }; // what window of d3d11 backend has, so cameras get the same projection
+} // namespace
+
+
+// render list is extracted and handed to render thread as usual, only nothing draws it
+void RenderList::submit()
+{
+}
+
+
+Status core::render::initialize()
+{
+  mCoreLog( "null render backend, nothing is drawn\n" );
+  return startRenderThread( []( RenderList& renderList ) { renderList.submit(); } );
+}
+
+
+void render::destroy()
+{
+  stopRenderThread();
+}
+
+
+void render::update()
+{
+}
+
+
+RenderList& render::getRenderList()
+{
+  return getBuildingRenderList();
+}
+
+
+Vec2 render::getViewportSize()
+{
+  return sViewportSize;
+}
+
+
+void render::present()
+{
+  publishRenderList();
+}
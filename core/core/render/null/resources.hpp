@@ -0,0 +1,40 @@
+#pragma once
+#include "core/common.hpp"
+#include "core/data/schema.hpp"
+
+// null render backend: resources remember sizes cpu side asks about, nothing is created on gpu
+namespace core::render::gapi
+{
+  struct IndexBuffer
+  {
+    u32 elementSize  = 0;
+    u32 elementCount = 0;
+
+    Status init( const char*, ArrayBytesView bytes )
+    {
+      elementSize  = static_cast<u32>( bytes.getElementSize() );
+      elementCount = static_cast<u32>( bytes.getSize() );
+      return StatusOk;
+    }
+  };
+
+
+  struct VertexBuffer
+  {
+    u32 elementSize  = 0;
+    u32 elementCount = 0;
+
+    Status init( const char*, ArrayBytesView bytes )
+    {
+      elementSize  = static_cast<u32>( bytes.getElementSize() );
+      elementCount = static_cast<u32>( bytes.getSize() );
+      return StatusOk;
+    }
+  };
+
+
+  struct Texture
+  {
+    Status init( const data::schema::Texture& ) { return StatusOk; }
+  };
+} // namespace core::render::gapi
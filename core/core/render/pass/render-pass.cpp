@@ -2,6 +2,7 @@
 #include "core/render/gapi/device.hpp"
 #include "core/render/gapi/render-pipeline.hpp"
 #include "core/math/math.hpp"
+#include "core/system/profiler.hpp"
 
 using namespace core::render;
 using namespace core::render::gapi;
@@ -62,6 +63,7 @@ Status RenderPass3D::init()
 
 void RenderPass3D::render( RenderList& renderList )
 {
+  mCoreProfileScope( "RenderPass3D::render" );
   depthStencil.clear();
   renderTarget.clear( Vec4( 0, 1, 0, 1 ) );
 
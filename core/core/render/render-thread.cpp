@@ -0,0 +1,183 @@
+#include "core/render/render-thread.hpp"
+#include "core/system/time.hpp"
+
+using namespace core;
+using namespace core::render;
+
+
+namespace
+{
+  // uploads of loading chunk can take long, rest of them waits for next frame. commands never run earlier
+  // than they are allowed, so postponing them is always fine
+  constexpr u64 sCommandsDeadlineMs = 8;
+
+  struct QueuedCommand
+  {
+    u64           listIndex; // runs before list of this index is submitted
+    RenderCommand command;
+  };
+
+  struct StaticData
+  {
+    RenderListHandoff handoff;
+    SubmitFunc        submit;
+    std::thread       thread;
+    std::atomic<u64>  publishedLists = 0;
+
+    std::mutex                commandsMutex;
+    std::deque<QueuedCommand> commands;
+  };
+
+  StaticData* sData = nullptr;
+
+
+  // without render thread there is nobody to run commands. they are dropped, resources captured by them are released
+  void queueCommand( RenderCommand command, u64 listDelay )
+  {
+    if( !sData )
+      return;
+
+    auto lock = std::lock_guard( sData->commandsMutex );
+    sData->commands.push_back( QueuedCommand{
+        .listIndex = sData->publishedLists.load( std::memory_order_relaxed ) + listDelay,
+        .command   = std::move( command ),
+    } );
+  }
+
+  void runCommands( u64 listIndex, u64 deadlineMs )
+  {
+    auto stopwatch = system::Stopwatch();
+
+    while( stopwatch.getMs() < deadlineMs )
+    {
+      auto command = RenderCommand();
+      {
+        auto lock = std::lock_guard( sData->commandsMutex );
+        if( sData->commands.empty() || sData->commands.front().listIndex > listIndex )
+          return;
+        command = std::move( sData->commands.front().command );
+        sData->commands.pop_front();
+      }
+      command();
+    }
+  }
+
+  void runRenderThread()
+  {
+    system::profiler::setThreadName( "render" );
+    mCoreMemoryScope( Render );
+
+    for( u64 listIndex = 0;; ++listIndex )
+    {
+      auto* list = sData->handoff.acquire();
+      if( !list )
+        break;
+
+      {
+        mCoreProfileScope( "render commands" );
+        runCommands( listIndex, sCommandsDeadlineMs );
+      }
+      {
+        mCoreProfileScope( "render submit" );
+        sData->submit( *list );
+      }
+      sData->handoff.release();
+    }
+
+    runCommands( ~u64( 0 ), ~u64( 0 ) );
+  }
+} // namespace
+
+
+void RenderListHandoff::publish()
+{
+  {
+    auto lock = std::unique_lock( mutex_ );
+    assert( !stopped_ );
+    changed_.wait( lock, [this]() { return !published_ && !inFlight_; } );
+    published_ = &lists_[building_];
+    building_ ^= 1u;
+  }
+  changed_.notify_all();
+
+  // storage of previous lists is in arena of older frame, it is dropped here
+  lists_[building_].clear();
+}
+
+RenderList* RenderListHandoff::acquire()
+{
+  auto lock = std::unique_lock( mutex_ );
+  changed_.wait( lock, [this]() { return published_ || stopped_; } );
+  auto* list = std::exchange( published_, nullptr );
+  inFlight_  = list != nullptr;
+  return list;
+}
+
+void RenderListHandoff::release()
+{
+  {
+    auto lock = std::lock_guard( mutex_ );
+    inFlight_ = false;
+  }
+  changed_.notify_all();
+}
+
+void RenderListHandoff::stop()
+{
+  {
+    auto lock = std::lock_guard( mutex_ );
+    stopped_  = true;
+  }
+  changed_.notify_all();
+}
+
+
+Status render::initRenderThread()
+{
+  sData = new StaticData();
+  return StatusOk;
+}
+
+Status render::startRenderThread( SubmitFunc submit )
+{
+  assert( sData && !sData->thread.joinable() );
+  sData->submit = std::move( submit );
+  sData->thread = std::thread( runRenderThread );
+  return StatusOk;
+}
+
+void render::stopRenderThread()
+{
+  if( !sData )
+    return;
+
+  // backend could fail before it started thread, queued commands are dropped then
+  sData->handoff.stop();
+  if( sData->thread.joinable() )
+    sData->thread.join();
+  delete sData;
+  sData = nullptr;
+}
+
+RenderList& render::getBuildingRenderList()
+{
+  return sData->handoff.getBuilding();
+}
+
+void render::publishRenderList()
+{
+  // waits only when render thread is still busy with previous frame
+  mCoreProfileScope( "render wait" );
+  sData->handoff.publish();
+  sData->publishedLists.fetch_add( 1, std::memory_order_relaxed );
+}
+
+void render::runOnRenderThread( RenderCommand command )
+{
+  queueCommand( std::move( command ), 0 );
+}
+
+void render::destroyDeferredCommand( RenderCommand command )
+{
+  queueCommand( std::move( command ), 1 );
+}
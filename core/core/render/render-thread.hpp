@@ -0,0 +1,82 @@
+#pragma once
+#include "core/common.hpp"
+#include "core/render/render.hpp"
+#include <condition_variable>
+
+namespace core::render
+{
+  // two render lists: main thread builds one while render thread submits the other.
+  // at most one list is in flight, so logic of frame N+1 overlaps submission of frame N
+  class RenderListHandoff
+  {
+    RenderList              lists_[2];
+    u32                     building_ = 0;
+    std::mutex              mutex_;
+    std::condition_variable changed_;
+    RenderList*             published_ = nullptr; // waits for render thread
+    bool                    inFlight_  = false;   // render thread submits it
+    bool                    stopped_   = false;
+
+  public:
+    RenderList& getBuilding() { return lists_[building_]; }
+
+    // main thread: hands built list over. waits until render thread is done with the other list, which is built next
+    void publish();
+
+    // render thread: waits for published list and owns it until release. nullptr once stopped and nothing is published
+    RenderList* acquire();
+    void        release();
+
+    // render thread finishes list which is already published, then acquire returns nullptr
+    void stop();
+  };
+
+
+  using RenderCommand = std::move_only_function<void()>;
+  using SubmitFunc    = std::move_only_function<void( RenderList& )>;
+
+  // commands are queued from here on, even before device exists. startup loads scene while device is created
+  Status initRenderThread();
+
+  // backend starts it once device is created. render thread owns device context from now on,
+  // submit is called there for every published list
+  Status startRenderThread( SubmitFunc submit );
+  void   stopRenderThread(); // submits what is published, runs all queued commands, joins thread
+
+  RenderList& getBuildingRenderList();
+  void        publishRenderList();
+
+  // any thread: command runs on render thread after lists published so far are submitted, usually right
+  // before the one built now. commands run in order they are queued
+  void runOnRenderThread( RenderCommand command );
+
+  // resources which lists of previous frames may point to: released on render thread after all lists
+  // published so far and the one built now are submitted
+  void destroyDeferredCommand( RenderCommand command );
+
+  template<typename T>
+  void destroyDeferred( T&& resources )
+  {
+    destroyDeferredCommand( [resources = std::forward<T>( resources )]() mutable {
+      auto released = std::move( resources );
+    } );
+  }
+
+
+  // same as task::ctiDeffered, only promise is resolved on render thread
+  template<typename F>
+  auto ctiRenderThread( F&& f ) -> cti::continuable<typename std::invoke_result_t<F>::value_type>
+  {
+    using TResult = typename std::invoke_result_t<F>::value_type;
+    return cti::make_continuable<TResult>( [f = std::move( f )]( auto&& promise ) {
+      runOnRenderThread( [f       = std::move( f ),
+                          promise = std::forward<decltype( promise )>( promise )]() mutable {
+        auto expected = f();
+        if( expected.has_value() )
+          promise.set_value( std::move( expected ).value() );
+        else
+          promise.set_exception( expected.error() );
+      } );
+    } );
+  }
+} // namespace core::render
@@ -1,4 +1,5 @@
 #include "core/render/render.hpp"
+#include "core/render/render-thread.hpp"
 #include "core/render/gapi/device.hpp"
 #include "core/render/shader-table.hpp"
 #include "core/render/pass/render-pass.hpp"
@@ -17,7 +18,6 @@ namespace
   struct StaticData
   {
     RenderPass3D renderPass3d;
-    RenderList   renderList;
   };
 
   StaticData* sData = nullptr;
@@ -86,12 +86,18 @@ Status core::render::initialize( HWND windowHandle )
     mCoreCheckStatus( sData->renderPass3d.init() );
   }
 
-  return StatusOk;
+  // device context is used only by render thread from now on
+  return startRenderThread( []( RenderList& renderList ) {
+    renderList.submit();
+    gDevice->viewport.present();
+    gDevice->logMessages();
+  } );
 }
 
 
 void render::destroy()
 {
+  stopRenderThread();
   delete sData;
   delete gCommonRenderData;
   delete gDevice;
@@ -103,11 +109,14 @@ void render::update()
 #ifdef _DEBUG
   if( input::isKeyMod( input::KeyModCtrl ) && input::isKeyDown( input::KeyR ) )
   {
-    auto s = gCommonRenderData->shaderTable.reload();
-    if( s != StatusOk )
-      mCoreLogError( "error reload shader table: %d\n", static_cast<int>( s ) );
-    else
-      mCoreLog( "shader table reloaded!\n" );
+    // shaders are used by render thread, they are replaced between its frames
+    runOnRenderThread( []() {
+      auto s = gCommonRenderData->shaderTable.reload();
+      if( s != StatusOk )
+        mCoreLogError( "error reload shader table: %d\n", static_cast<int>( s ) );
+      else
+        mCoreLog( "shader table reloaded!\n" );
+    } );
   }
 #endif
 }
@@ -115,14 +124,17 @@ void render::update()
 
 RenderList& render::getRenderList()
 {
-  return sData->renderList;
+  return getBuildingRenderList();
+}
+
+
+Vec2 render::getViewportSize()
+{
+  return gDevice->viewport.fSize;
 }
 
 
 void render::present()
 {
-  sData->renderList.submit();
-  sData->renderList.clear();
-  gDevice->viewport.present();
-  gDevice->logMessages();
+  publishRenderList();
 }
@@ -1,9 +1,13 @@
 #pragma once
 #include "core/common.hpp"
 #include "core/render/data.hpp"
-#include "core/render/shader-table.hpp"
-#include "core/render/gapi/resources.hpp"
-#include "core/render/gapi/device.hpp"
+#include "core/system/frame-allocator.hpp"
+
+#if !mCoreHeadless
+#  include "core/render/shader-table.hpp"
+#  include "core/render/gapi/resources.hpp"
+#  include "core/render/gapi/device.hpp"
+#endif
 
 namespace core::render
 {
@@ -15,6 +19,7 @@ namespace core::render
   mCoreDeclareEnum( BlendMode, xBlendModeEnum );
 
 
+  // built anew each frame, so its lists live in frame arena
   class RenderList
   {
   public:
@@ -28,7 +33,7 @@ namespace core::render
       Mat4      worldTransform;
     };
 
-    std::vector<Drawable> drawables;
+    system::FrameVector<Drawable> drawables;
 
     struct Point
     {
@@ -36,7 +41,7 @@ namespace core::render
       Vec4 color;
     };
 
-    std::vector<Point> lines; // must be pairs (line list)
+    system::FrameVector<Point> lines; // must be pairs (line list)
 
     struct PointLight
     {
@@ -44,7 +49,7 @@ namespace core::render
       Vec3 color;
       f32  intensity;
     };
-    std::vector<PointLight> lights;
+    system::FrameVector<PointLight> lights;
 
     Vec3 viewPosition;
     Mat4 worldToViewTransform;
@@ -54,14 +59,15 @@ namespace core::render
 
     void clear()
     {
-      drawables.clear();
-      lines.clear();
-      lights.clear();
+      system::resetFrameVector( drawables );
+      system::resetFrameVector( lines );
+      system::resetFrameVector( lights );
       loadingScreen = false;
     }
   };
 
 
+#if !mCoreHeadless
   struct CommonRenderData
   {
     ShaderTable             shaderTable;
@@ -82,9 +88,15 @@ namespace core::render
 
 
   Status initialize( HWND windowHandle );
-  void   destroy();
-  void   update();
+#else
+  Status initialize(); // null backend, see render/null
+#endif
+
+  void destroy();
+  void update();
 
+  // main thread builds list of next frame, present hands it over to render thread (see render-thread.hpp)
   RenderList& getRenderList();
+  Vec2        getViewportSize();
   void        present();
 } // namespace core::render
@@ -1,23 +1,59 @@
 #include "core/render/shader-table.hpp"
+#include "core/fs/fs.hpp"
 
 using namespace core::render;
 
 
 namespace
 {
+  // every source used by reload, they are read in one batch before anything is compiled
+  constexpr const char* sShaderSourceNames[] = {
+      "texture_2d.vs.hlsl",
+      "texture_2d.ps.hlsl",
+      "texture_2dms.ps.hlsl",
+      "loading.vs.hlsl",
+      "loading.ps.hlsl",
+      "old_full.vs.hlsl",
+      "old_full.ps.hlsl",
+      "line.vs.hlsl",
+      "line.ps.hlsl",
+  };
+
+  struct ShaderSources
+  {
+    std::vector<core::fs::FileBytes> files; // in order of names
+
+    Status read( const std::string& directory )
+    {
+      auto paths = std::vector<std::string>();
+      for( const char* name: sShaderSourceNames )
+        paths.push_back( core::fs::pathJoin( directory, name ) );
+      return core::fs::readFiles( paths, files );
+    }
+
+    std::span<const byte> get( const char* name ) const
+    {
+      auto it = std::ranges::find( sShaderSourceNames, std::string_view( name ) );
+      assert( it != std::end( sShaderSourceNames ) );
+      return files[static_cast<size_t>( it - std::begin( sShaderSourceNames ) )].getBytes();
+    }
+  };
+
+
   template<typename... TVertexShaderItemLayout>
   Status makePipelineFromSource(
-      ShaderPipeline&    out,
-      const std::string& directory,
-      const char*        vertexSourceName,
-      const char*        pixelSourceName,
+      ShaderPipeline&      out,
+      const std::string&   directory,
+      const ShaderSources& sources,
+      const char*          vertexSourceName,
+      const char*          pixelSourceName,
       TVertexShaderItemLayout... vertexShaderItemLayouts )
   {
     gapi::VertexShaderItemLayout layout[] = { vertexShaderItemLayouts... };
     mCoreCheckStatus( out.vertexShader.initFromSource(
-        directory.c_str(), vertexSourceName, gapi::VertexShaderLayout( layout ) ) );
+        directory.c_str(), vertexSourceName, sources.get( vertexSourceName ), gapi::VertexShaderLayout( layout ) ) );
     mCoreCheckStatus( out.pixelShader.initFromSource(
-        directory.c_str(), pixelSourceName ) );
+        directory.c_str(), pixelSourceName, sources.get( pixelSourceName ) ) );
     return StatusOk;
   }
 } // namespace
@@ -37,24 +73,27 @@ Status ShaderTable::reload()
   using L = gapi::VertexShaderItemLayout;
   auto st = ShaderTable{ .directory = directory };
 
-  mCoreCheckStatus( makePipelineFromSource( st.texture2D, st.directory, mShaderPair( texture_2d ),
+  auto sources = ShaderSources();
+  mCoreCheckStatus( sources.read( st.directory ) );
+
+  mCoreCheckStatus( makePipelineFromSource( st.texture2D, st.directory, sources, mShaderPair( texture_2d ),
                                             L{ .name = "Position", .format = gapi::GPUFormatRG32F },
                                             L{ .name = "UV", .format = gapi::GPUFormatRG32F } ) );
 
-  mCoreCheckStatus( makePipelineFromSource( st.texture2DMS, st.directory, "texture_2d.vs.hlsl", "texture_2dms.ps.hlsl",
+  mCoreCheckStatus( makePipelineFromSource( st.texture2DMS, st.directory, sources, "texture_2d.vs.hlsl", "texture_2dms.ps.hlsl",
                                             L{ .name = "Position", .format = gapi::GPUFormatRG32F },
                                             L{ .name = "UV", .format = gapi::GPUFormatRG32F } ) );
 
-  mCoreCheckStatus( makePipelineFromSource( st.loading, st.directory, mShaderPair( loading ),
+  mCoreCheckStatus( makePipelineFromSource( st.loading, st.directory, sources, mShaderPair( loading ),
                                             L{ .name = "Position", .format = gapi::GPUFormatRG32F },
                                             L{ .name = "UV", .format = gapi::GPUFormatRG32F } ) );
 
-  mCoreCheckStatus( makePipelineFromSource( st.oldFull, st.directory, mShaderPair( old_full ),
+  mCoreCheckStatus( makePipelineFromSource( st.oldFull, st.directory, sources, mShaderPair( old_full ),
                                             L{ .name = "MyPosition", .format = gapi::GPUFormatRGB32F },
                                             L{ .name = "Normal", .format = gapi::GPUFormatRGB32F },
                                             L{ .name = "UVCoord", .format = gapi::GPUFormatRG32F } ) );
 
-  mCoreCheckStatus( makePipelineFromSource( st.line, st.directory, mShaderPair( line ),
+  mCoreCheckStatus( makePipelineFromSource( st.line, st.directory, sources, mShaderPair( line ),
                                             L{ .name = "Position", .format = gapi::GPUFormatRGB32F },
                                             L{ .name = "Color", .format = gapi::GPUFormatRGB32F } ) );
 
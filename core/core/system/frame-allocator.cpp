@@ -0,0 +1,178 @@
+#include "core/system/frame-allocator.hpp"
+
+using namespace core;
+using namespace core::system;
+using namespace core::system::frame;
+
+
+namespace
+{
+  struct alignas( 16 ) Block
+  {
+    Block* next = nullptr;
+    size_t size = 0; // of data after header
+
+    byte* getData() { return reinterpret_cast<byte*>( this + 1 ); }
+  };
+
+  // blocks are linked with tail, so whole arena is moved to free list at once
+  struct Arena
+  {
+    Block* head       = nullptr;
+    Block* tail       = nullptr;
+    u32    blocks     = 0;
+    u64    blockBytes = 0;
+  };
+
+  struct StaticData
+  {
+    size_t           blockSize = 0;
+    std::atomic<u64> frameIndex;
+
+    std::mutex      mutex; // protects arenas and free list, taken only when thread needs new block
+    Arena           arenas[sFrameArenaCount];
+    Block*          freeBlocks = nullptr;
+    FrameArenaStats stats;
+  };
+
+  StaticData* sData = nullptr;
+
+  struct ThreadCursor
+  {
+    u64   frameIndex = ~u64( 0 );
+    byte* cursor     = nullptr;
+    byte* end        = nullptr;
+  };
+
+  constinit thread_local ThreadCursor tCursor;
+
+  // frame index goes on after reinit, so cursors left from previous init never match
+  constinit u64 sNextFrameIndex = 0;
+
+
+  byte* alignUp( byte* ptr, size_t alignment )
+  {
+    auto address = ( reinterpret_cast<uintptr_t>( ptr ) + alignment - 1 ) & ~( alignment - 1 );
+    return reinterpret_cast<byte*>( address );
+  }
+
+  // under lock
+  Block* takeBlock( size_t size )
+  {
+    for( auto** it = &sData->freeBlocks; *it; it = &( *it )->next )
+    {
+      if( ( *it )->size < size )
+        continue;
+      auto* block = *it;
+      *it         = block->next;
+      block->next = nullptr;
+      return block;
+    }
+
+    // big allocations get block of their own size, which is reused like any other
+    auto blockSize = std::max( size, sData->blockSize );
+    auto* block    = new( ::operator new( sizeof( Block ) + blockSize ) ) Block{ .next = nullptr, .size = blockSize };
+    sData->stats.allBlocks++;
+    return block;
+  }
+
+  void* allocateSlow( size_t size, size_t alignment, u64 frameIndex )
+  {
+    Block* block = nullptr;
+    {
+      auto lock = std::lock_guard( sData->mutex );
+      block     = takeBlock( size + alignment );
+
+      auto& arena = sData->arenas[frameIndex % sFrameArenaCount];
+      if( arena.tail )
+        arena.tail->next = block;
+      else
+        arena.head = block;
+      arena.tail = block;
+      arena.blocks++;
+      arena.blockBytes += block->size;
+    }
+
+    auto* ptr = alignUp( block->getData(), alignment );
+    tCursor   = ThreadCursor{
+          .frameIndex = frameIndex,
+          .cursor     = ptr + size,
+          .end        = block->getData() + block->size,
+    };
+    return ptr;
+  }
+
+  void deleteBlocks( Block* block )
+  {
+    while( block )
+    {
+      auto* next = block->next;
+      block->~Block();
+      ::operator delete( block );
+      block = next;
+    }
+  }
+} // namespace
+
+
+Status frame::init( size_t blockSize )
+{
+  sData            = new StaticData();
+  sData->blockSize = blockSize;
+  sData->frameIndex.store( sNextFrameIndex, std::memory_order_relaxed );
+  return StatusOk;
+}
+
+void frame::destroy()
+{
+  for( auto& arena: sData->arenas )
+    deleteBlocks( arena.head );
+  deleteBlocks( sData->freeBlocks );
+  sNextFrameIndex = sData->frameIndex.load( std::memory_order_relaxed ) + 1;
+  delete sData;
+  sData = nullptr;
+}
+
+void frame::frameEnd()
+{
+  u64  frameIndex = sData->frameIndex.load( std::memory_order_relaxed );
+  auto lock       = std::lock_guard( sData->mutex );
+
+  const auto& finished     = sData->arenas[frameIndex % sFrameArenaCount];
+  sData->stats.blocks     = finished.blocks;
+  sData->stats.blockBytes = finished.blockBytes;
+
+  // next frame takes arena of the oldest one, thread cursors in it are invalidated by frame index
+  auto& next = sData->arenas[( frameIndex + 1 ) % sFrameArenaCount];
+  if( next.head )
+  {
+    next.tail->next   = sData->freeBlocks;
+    sData->freeBlocks = next.head;
+  }
+  next = Arena();
+
+  sData->frameIndex.store( frameIndex + 1, std::memory_order_release );
+}
+
+void* frame::allocate( size_t size, size_t alignment )
+{
+  u64   frameIndex = sData->frameIndex.load( std::memory_order_acquire );
+  auto& cursor     = tCursor;
+
+  if( cursor.frameIndex == frameIndex )
+  {
+    auto* ptr = alignUp( cursor.cursor, alignment );
+    if( ptr <= cursor.end && size <= static_cast<size_t>( cursor.end - ptr ) )
+    {
+      cursor.cursor = ptr + size;
+      return ptr;
+    }
+  }
+
+  return allocateSlow( size, alignment, frameIndex );
+}
+
+const FrameArenaStats& frame::getStats()
+{
+  return sData->stats;
+}
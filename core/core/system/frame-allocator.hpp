@@ -0,0 +1,67 @@
+#pragma once
+#include "core/common.hpp"
+
+namespace core::system::frame
+{
+  // memory allocated in frame stays valid while next frames are built, until its arena comes around again
+  inline constexpr u32 sFrameArenaCount = 3;
+
+  struct FrameArenaStats
+  {
+    u32 blocks     = 0; // used by last finished frame
+    u64 blockBytes = 0;
+    u32 allBlocks  = 0; // in all arenas and free list
+  };
+
+  Status init( size_t blockSize = 1 << 20 );
+  void   destroy();
+
+  // main thread, once per frame: next arena is reset in O(1), its blocks go to free list.
+  // other threads must not keep allocating into frame which already ended
+  void frameEnd();
+
+  // any thread: bump allocation in block owned by calling thread, there is no free.
+  // blocks are reused between frames, so after warmup frames don't touch heap
+  void* allocate( size_t size, size_t alignment );
+
+  const FrameArenaStats& getStats();
+} // namespace core::system::frame
+
+
+namespace core::system
+{
+  // std allocator over frame arena, deallocate does nothing: memory goes away with arena
+  template<typename T>
+  class FrameAllocator
+  {
+  public:
+    using value_type = T;
+
+    FrameAllocator() noexcept = default;
+
+    template<typename U>
+    FrameAllocator( const FrameAllocator<U>& ) noexcept
+    {}
+
+    T* allocate( size_t count ) { return static_cast<T*>( frame::allocate( count * sizeof( T ), alignof( T ) ) ); }
+    void deallocate( T*, size_t ) noexcept {}
+
+    template<typename U>
+    bool operator==( const FrameAllocator<U>& ) const noexcept
+    {
+      return true;
+    }
+  };
+
+  template<typename T>
+  using FrameVector = std::vector<T, FrameAllocator<T>>;
+
+  // drops storage of previous frame and reserves as much as it used, so list rarely grows within frame
+  template<typename T>
+  void resetFrameVector( FrameVector<T>& vector )
+  {
+    auto capacity = vector.size();
+    vector        = FrameVector<T>();
+    vector.reserve( capacity );
+  }
+} // namespace core::system
@@ -0,0 +1,95 @@
+#include "core/system/frame-report.hpp"
+#include "core/fs/file.hpp"
+
+using namespace core;
+using namespace core::system;
+
+
+FramePercentiles system::computePercentiles( std::span<const f32> values )
+{
+  if( values.empty() )
+    return FramePercentiles();
+
+  auto sorted = std::vector<f32>( values.begin(), values.end() );
+  std::ranges::sort( sorted );
+
+  auto at = [&sorted]( f64 percentile ) {
+    auto rank = static_cast<size_t>( std::ceil( percentile * static_cast<f64>( sorted.size() ) ) );
+    return sorted[std::clamp<size_t>( rank, 1, sorted.size() ) - 1];
+  };
+
+  return FramePercentiles{
+      .p50 = at( 0.50 ),
+      .p95 = at( 0.95 ),
+      .p99 = at( 0.99 ),
+      .max = sorted.back(),
+  };
+}
+
+
+void FrameReport::addFrame( f32 frameMs, bool isLoading, bool isStall )
+{
+  frameMs_.push_back( frameMs );
+  if( isLoading )
+    loadingFrames_++;
+  if( isStall )
+  {
+    stallFrames_++;
+    stallMs_ += frameMs;
+  }
+}
+
+void FrameReport::addScopes( const profiler::FrameSummary& summary )
+{
+  for( const auto& scope: summary.scopes )
+  {
+    auto name = std::string_view( scope.name );
+    auto it   = std::ranges::find( scopes_, name, &ScopeTotal::name );
+    if( it == scopes_.end() )
+      it = scopes_.insert( it, ScopeTotal{ .name = name } );
+
+    it->frames++;
+    it->totalMs += scope.totalMs;
+    it->maxMs = std::max( it->maxMs, scope.totalMs );
+  }
+}
+
+void FrameReport::log() const
+{
+  auto frames = getFramePercentiles();
+  mCoreLog( "frames: " mFmtU32 ", p50 %.2fms, p95 %.2fms, p99 %.2fms, max %.2fms\n", getFrameCount(),
+            static_cast<f64>( frames.p50 ), static_cast<f64>( frames.p95 ), static_cast<f64>( frames.p99 ), static_cast<f64>( frames.max ) );
+  mCoreLog( "loading frames: " mFmtU32 ", load stalls: " mFmtU32 " frames, %.2fms\n",
+            loadingFrames_, stallFrames_, static_cast<f64>( stallMs_ ) );
+  mCoreLog( "time to first frame: %.2fms\n", static_cast<f64>( timeToFirstFrameMs_ ) );
+
+  auto byTotal = scopes_;
+  std::ranges::sort( byTotal, std::greater{}, &ScopeTotal::totalMs );
+  for( const auto& scope: byTotal )
+    mCoreLog( "  %-32s mean %.3fms, max %.3fms per frame\n", std::string( scope.name ).c_str(),
+              static_cast<f64>( scope.totalMs ) / std::max( getFrameCount(), 1u ), static_cast<f64>( scope.maxMs ) );
+}
+
+Status FrameReport::writeJson( const char* path ) const
+{
+  auto frames = getFramePercentiles();
+  auto json   = Json{
+      { "frames", getFrameCount() },
+      { "frameMs", { { "p50", frames.p50 }, { "p95", frames.p95 }, { "p99", frames.p99 }, { "max", frames.max } } },
+      { "loadingFrames", loadingFrames_ },
+      { "stallFrames", stallFrames_ },
+      { "stallMs", stallMs_ },
+      { "timeToFirstFrameMs", timeToFirstFrameMs_ },
+  };
+
+  auto& scopes = json["scopes"];
+  for( const auto& scope: scopes_ )
+  {
+    scopes[std::string( scope.name )] = {
+        { "meanMs", scope.totalMs / static_cast<f32>( std::max( getFrameCount(), 1u ) ) },
+        { "maxMs", scope.maxMs },
+    };
+  }
+
+  return fs::writeFileJson( path, json );
+}
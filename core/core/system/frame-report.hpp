@@ -0,0 +1,50 @@
+#pragma once
+#include "core/common.hpp"
+#include "core/system/profiler.hpp"
+
+namespace core::system
+{
+  struct FramePercentiles
+  {
+    f32 p50 = 0;
+    f32 p95 = 0;
+    f32 p99 = 0;
+    f32 max = 0;
+  };
+
+  // nearest rank, values don't have to be sorted
+  FramePercentiles computePercentiles( std::span<const f32> values );
+
+
+  // frame times of a run, to compare runs of the same replay
+  class FrameReport
+  {
+    struct ScopeTotal
+    {
+      std::string_view name;
+      u32              frames  = 0; // which had the scope at all
+      f32              totalMs = 0;
+      f32              maxMs   = 0; // of one frame
+    };
+
+    std::vector<f32>        frameMs_;
+    std::vector<ScopeTotal> scopes_;
+    u32                     loadingFrames_      = 0; // something was loading
+    u32                     stallFrames_        = 0; // nothing to show but loading screen
+    f32                     stallMs_            = 0;
+    f32                     timeToFirstFrameMs_ = 0; // startup, from initialize to first presented frame
+
+  public:
+    void reserve( u32 frames ) { frameMs_.reserve( frames ); }
+
+    void addFrame( f32 frameMs, bool isLoading, bool isStall );
+    void addScopes( const profiler::FrameSummary& summary ); // per subsystem breakdown
+    void setTimeToFirstFrame( f32 ms ) { timeToFirstFrameMs_ = ms; }
+
+    u32              getFrameCount() const { return static_cast<u32>( frameMs_.size() ); }
+    FramePercentiles getFramePercentiles() const { return computePercentiles( frameMs_ ); }
+
+    void   log() const;
+    Status writeJson( const char* path ) const;
+  };
+} // namespace core::system
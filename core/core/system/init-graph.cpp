@@ -0,0 +1,150 @@
+#include "core/system/init-graph.hpp"
+#include "core/system/profiler.hpp"
+#include "core/system/task.hpp"
+
+using namespace core;
+using namespace core::system;
+
+
+void InitGraph::add( const char* name, std::initializer_list<const char*> dependencies, InitThread thread, InitFunc init )
+{
+  auto stage = Stage{
+      .name         = name,
+      .dependencies = {},
+      .thread       = thread,
+      .init         = std::move( init ),
+  };
+
+  for( const char* dependency: dependencies )
+  {
+    auto it = std::ranges::find_if( stages_, [dependency]( const Stage& s ) {
+      return std::string_view( s.name ) == dependency;
+    } );
+    assert( it != stages_.end() && "dependency must be added before stage" );
+    if( it != stages_.end() )
+      stage.dependencies.push_back( static_cast<u32>( it - stages_.begin() ) );
+  }
+
+  stages_.push_back( std::move( stage ) );
+}
+
+
+bool InitGraph::isReady( const Stage& stage ) const
+{
+  return std::ranges::all_of( stage.dependencies, [this]( u32 index ) {
+    return stages_[index].done && stages_[index].status == StatusOk;
+  } );
+}
+
+
+void InitGraph::runStage( Stage& stage )
+{
+  u64    beginUs = stopwatch_.getUs();
+  Status status  = StatusOk;
+  {
+    mCoreProfileScope( stage.name );
+    status = stage.init();
+  }
+  u64 endUs = stopwatch_.getUs();
+
+  {
+    auto lock     = std::lock_guard( mutex_ );
+    stage.status  = status;
+    stage.done    = true;
+    stage.beginUs = beginUs;
+    stage.endUs   = endUs;
+    if( status != StatusOk && failed_ == StatusOk )
+    {
+      mCoreLogError( "init stage %s failed: %d\n", stage.name, static_cast<int>( status ) );
+      failed_ = status;
+    }
+  }
+  changed_.notify_all();
+}
+
+
+Status InitGraph::run()
+{
+  stopwatch_.reset();
+  auto lock = std::unique_lock( mutex_ );
+
+  for( ;; )
+  {
+    Stage* mainStage = nullptr;
+    bool   running   = false;
+
+    for( auto& stage: stages_ )
+    {
+      if( stage.started )
+      {
+        if( !stage.done )
+          running = true;
+        continue;
+      }
+      if( failed_ != StatusOk || !isReady( stage ) )
+        continue;
+
+      if( stage.thread == InitThreadMain )
+      {
+        mainStage = mainStage ? mainStage : &stage;
+        continue;
+      }
+
+      stage.started = true;
+      running       = true;
+      task::runAsync( [this, &stage]() { runStage( stage ); } );
+    }
+
+    // stages of main thread go in order they were added, workers keep going meanwhile
+    if( mainStage )
+    {
+      mainStage->started = true;
+      lock.unlock();
+      runStage( *mainStage );
+      lock.lock();
+      continue;
+    }
+
+    if( !running )
+      break;
+    changed_.wait( lock );
+  }
+
+  totalUs_ = stopwatch_.getUs();
+  assert( failed_ != StatusOk || std::ranges::all_of( stages_, &Stage::done ) );
+  return failed_;
+}
+
+
+u64 InitGraph::getStageUs( const char* name ) const
+{
+  for( const auto& stage: stages_ )
+  {
+    if( std::string_view( stage.name ) == name )
+      return stage.done ? stage.endUs - stage.beginUs : 0;
+  }
+  return 0;
+}
+
+
+void InitGraph::logReport() const
+{
+  u64 sumUs = 0;
+  for( const auto& stage: stages_ )
+    sumUs += stage.endUs - stage.beginUs;
+
+  // sum above total is time won by running stages at the same time
+  mCoreLog( "startup: %.1fms, stages took %.1fms together\n",
+            static_cast<f64>( totalUs_ ) / 1000.0, static_cast<f64>( sumUs ) / 1000.0 );
+
+  for( const auto& stage: stages_ )
+  {
+    if( !stage.done )
+    {
+      mCoreLog( "  %-12s %-6s skipped\n", stage.name, stage.thread == InitThreadMain ? "main" : "worker" );
+      continue;
+    }
+    mCoreLog( "  %-12s %-6s %8.1f .. %8.1fms\n", stage.name, stage.thread == InitThreadMain ? "main" : "worker",
+              static_cast<f64>( stage.beginUs ) / 1000.0, static_cast<f64>( stage.endUs ) / 1000.0 );
+  }
+}
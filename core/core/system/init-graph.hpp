@@ -0,0 +1,57 @@
+#pragma once
+#include "core/common.hpp"
+#include "core/system/time.hpp"
+#include <condition_variable>
+
+namespace core::system
+{
+  enum InitThread
+  {
+    InitThreadAny,  // task pool
+    InitThreadMain, // thread which runs graph: window, device
+  };
+
+
+  // startup stages with dependencies between them. stage starts as soon as all its dependencies succeeded,
+  // so independent stages run at the same time. needs task pool initialized
+  class InitGraph
+  {
+  public:
+    using InitFunc = std::move_only_function<Status()>;
+
+  private:
+    struct Stage
+    {
+      const char*      name;
+      std::vector<u32> dependencies;
+      InitThread       thread;
+      InitFunc         init;
+      Status           status  = StatusOk;
+      bool             started = false;
+      bool             done    = false;
+      u64              beginUs = 0; // since run started
+      u64              endUs   = 0;
+    };
+
+    std::vector<Stage>      stages_;
+    std::mutex              mutex_;
+    std::condition_variable changed_;
+    Stopwatch               stopwatch_;
+    Status                  failed_  = StatusOk; // first failure
+    u64                     totalUs_ = 0;
+
+    bool isReady( const Stage& stage ) const;
+    void runStage( Stage& stage );
+
+  public:
+    // dependencies are names of stages added before
+    void add( const char* name, std::initializer_list<const char*> dependencies, InitThread thread, InitFunc init );
+
+    // returns once all stages are done. after first failure no more stages are started, its status is returned
+    Status run();
+
+    u64  getTotalUs() const { return totalUs_; }
+    u64  getStageUs( const char* name ) const; // duration, 0 if stage didn't run
+    void logReport() const;                    // when every stage ran, what overlapped
+  };
+} // namespace core::system
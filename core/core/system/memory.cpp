@@ -0,0 +1,287 @@
+#include "core/system/memory.hpp"
+#include <new>
+
+using namespace core;
+using namespace core::system;
+using namespace core::system::memory;
+
+
+namespace
+{
+  constexpr size_t sMinAlignment = 16; // of malloc on x64, header size too
+
+  // own cache line per tag, so threads working on different subsystems don't share it
+  struct alignas( 64 ) TagCounters
+  {
+    std::atomic<u64> liveBytes   = 0;
+    std::atomic<u64> peakBytes   = 0;
+    std::atomic<u64> allocations = 0;
+    std::atomic<u64> budget      = 0;
+  };
+
+  // allocations start before main and end after it, so these are not in static data
+  constinit TagCounters            sCounters[sMemoryTagCount];
+  constinit thread_local MemoryTag tTag = MemoryTag_Untagged;
+
+  struct AllocationHeader
+  {
+    u64 size;
+    u32 tag;
+    u32 offset; // from start of malloc block to pointer given out
+  };
+  static_assert( sizeof( AllocationHeader ) == sMinAlignment );
+
+
+  struct StaticData
+  {
+    bool overBudget[sMemoryTagCount] = {};
+    u64  lastAllocations[sMemoryTagCount] = {};
+
+    bool checkAllocations  = false;
+    u32  checkWarmupFrames = 0;
+    u32  steadyFrames      = 0;
+  };
+
+  StaticData* sData = nullptr;
+
+
+  void* allocate( size_t size, size_t alignment ) noexcept
+  {
+    // header is right before pointer given out, block is aligned at least to header size
+    alignment   = std::max( alignment, sMinAlignment );
+    auto* block = static_cast<byte*>( std::malloc( size + alignment ) );
+    if( !block )
+      return nullptr;
+
+    auto  address = ( reinterpret_cast<uintptr_t>( block ) + sizeof( AllocationHeader ) + alignment - 1 ) & ~( alignment - 1 );
+    auto* ptr     = reinterpret_cast<byte*>( address );
+    auto  tag     = tTag;
+
+    auto* header = reinterpret_cast<AllocationHeader*>( ptr ) - 1;
+    *header      = AllocationHeader{ .size = size, .tag = tag, .offset = static_cast<u32>( ptr - block ) };
+
+    auto& counters = sCounters[tag];
+    u64   live     = counters.liveBytes.fetch_add( size, std::memory_order_relaxed ) + size;
+    u64   peak     = counters.peakBytes.load( std::memory_order_relaxed );
+    while( live > peak && !counters.peakBytes.compare_exchange_weak( peak, live, std::memory_order_relaxed ) )
+    {
+    }
+    counters.allocations.fetch_add( 1, std::memory_order_relaxed );
+
+    return ptr;
+  }
+
+  void* allocateOrThrow( size_t size, size_t alignment )
+  {
+    if( auto* ptr = allocate( size, alignment ) )
+      return ptr;
+    throw std::bad_alloc();
+  }
+
+  void deallocate( void* ptr ) noexcept
+  {
+    if( !ptr )
+      return;
+
+    auto* header = static_cast<AllocationHeader*>( ptr ) - 1;
+    sCounters[header->tag].liveBytes.fetch_sub( header->size, std::memory_order_relaxed );
+    std::free( static_cast<byte*>( ptr ) - header->offset );
+  }
+
+
+  void checkBudgets()
+  {
+    for( u32 i = 0; i < sMemoryTagCount; ++i )
+    {
+      auto tag   = static_cast<MemoryTag>( i );
+      auto stats = getTagStats( tag );
+      bool over  = stats.budget && stats.liveBytes > stats.budget;
+      if( over == sData->overBudget[i] )
+        continue;
+
+      sData->overBudget[i] = over;
+      if( over )
+        mCoreLogError( "memory of %s is over budget: " mFmtU64 " of " mFmtU64 " bytes\n", toString( tag ), stats.liveBytes, stats.budget );
+      else
+        mCoreLog( "memory of %s is back in budget: " mFmtU64 " of " mFmtU64 " bytes\n", toString( tag ), stats.liveBytes, stats.budget );
+    }
+  }
+
+  void checkAllocations( bool isSteady, const u64 ( &frameAllocations )[sMemoryTagCount] )
+  {
+    sData->steadyFrames = isSteady ? sData->steadyFrames + 1 : 0;
+    if( sData->steadyFrames <= sData->checkWarmupFrames )
+      return;
+
+    u64 total = 0;
+    for( u64 count: frameAllocations )
+      total += count;
+    if( !total )
+      return;
+
+    // one log line, formatted on stack: heap allocation here would be counted in the next frame
+    char   tags[512] = { 0 };
+    size_t length    = 0;
+    for( u32 i = 0; i < sMemoryTagCount && length < sizeof( tags ); ++i )
+    {
+      if( !frameAllocations[i] )
+        continue;
+      int written = snprintf( tags + length, sizeof( tags ) - length, " %s " mFmtU64,
+                              toString( static_cast<MemoryTag>( i ) ), frameAllocations[i] );
+      if( written < 0 )
+        break;
+      length += static_cast<size_t>( written );
+    }
+
+    mCoreLogError( "steady frame made " mFmtU64 " heap allocations:%s\n", total, tags );
+    assert( false && "steady frame must not allocate" );
+  }
+} // namespace
+
+
+MemoryScope::MemoryScope( MemoryTag tag ) noexcept
+    : previous_( tTag )
+{
+  tTag = tag;
+}
+
+MemoryScope::~MemoryScope()
+{
+  tTag = previous_;
+}
+
+
+Status memory::init()
+{
+  sData = new StaticData();
+  for( u32 i = 0; i < sMemoryTagCount; ++i )
+    sData->lastAllocations[i] = sCounters[i].allocations.load( std::memory_order_relaxed );
+  return StatusOk;
+}
+
+void memory::destroy()
+{
+  logReport();
+  delete sData;
+  sData = nullptr;
+}
+
+void memory::frameEnd( bool isSteady )
+{
+  u64 frameAllocations[sMemoryTagCount] = {};
+  for( u32 i = 0; i < sMemoryTagCount; ++i )
+  {
+    u64 allocations           = sCounters[i].allocations.load( std::memory_order_relaxed );
+    frameAllocations[i]       = allocations - sData->lastAllocations[i];
+    sData->lastAllocations[i] = allocations;
+  }
+
+  checkBudgets();
+  if( sData->checkAllocations )
+    checkAllocations( isSteady, frameAllocations );
+
+  // logs above may allocate, it is not counted to next frame
+  for( u32 i = 0; i < sMemoryTagCount; ++i )
+    sData->lastAllocations[i] = sCounters[i].allocations.load( std::memory_order_relaxed );
+}
+
+void memory::setBudget( MemoryTag tag, u64 bytes )
+{
+  mCoreLog( "memory budget of %s: " mFmtU64 " bytes\n", toString( tag ), bytes );
+  sCounters[tag].budget.store( bytes, std::memory_order_relaxed );
+}
+
+MemoryTagStats memory::getTagStats( MemoryTag tag )
+{
+  const auto& counters = sCounters[tag];
+  return MemoryTagStats{
+      .liveBytes   = counters.liveBytes.load( std::memory_order_relaxed ),
+      .peakBytes   = counters.peakBytes.load( std::memory_order_relaxed ),
+      .allocations = counters.allocations.load( std::memory_order_relaxed ),
+      .budget      = counters.budget.load( std::memory_order_relaxed ),
+  };
+}
+
+u64 memory::getAllocationCount()
+{
+  u64 total = 0;
+  for( const auto& counters: sCounters )
+    total += counters.allocations.load( std::memory_order_relaxed );
+  return total;
+}
+
+void memory::logReport()
+{
+  mCoreLog( "memory by tag:\n" );
+  for( u32 i = 0; i < sMemoryTagCount; ++i )
+  {
+    auto tag   = static_cast<MemoryTag>( i );
+    auto stats = getTagStats( tag );
+    mCoreLog( "  %-8s live " mFmtU64 ", peak " mFmtU64 ", budget " mFmtU64 " bytes, " mFmtU64 " allocations\n",
+              toString( tag ), stats.liveBytes, stats.peakBytes, stats.budget, stats.allocations );
+  }
+}
+
+void memory::setAllocationCheck( bool enabled, u32 warmupFrames )
+{
+  mCoreLog( "steady frame allocation check: %s, " mFmtU32 " warmup frames\n", enabled ? "on" : "off", warmupFrames );
+  sData->checkAllocations  = enabled;
+  sData->checkWarmupFrames = warmupFrames;
+  sData->steadyFrames      = 0;
+}
+
+
+// replaced for whole program: everything allocated with new is counted under tag of current thread.
+// malloc is not tracked
+void* operator new( size_t size )
+{
+  return allocateOrThrow( size, sMinAlignment );
+}
+
+void* operator new[]( size_t size )
+{
+  return allocateOrThrow( size, sMinAlignment );
+}
+
+void* operator new( size_t size, std::align_val_t alignment )
+{
+  return allocateOrThrow( size, static_cast<size_t>( alignment ) );
+}
+
+void* operator new[]( size_t size, std::align_val_t alignment )
+{
+  return allocateOrThrow( size, static_cast<size_t>( alignment ) );
+}
+
+void* operator new( size_t size, const std::nothrow_t& ) noexcept
+{
+  return allocate( size, sMinAlignment );
+}
+
+void* operator new[]( size_t size, const std::nothrow_t& ) noexcept
+{
+  return allocate( size, sMinAlignment );
+}
+
+void* operator new( size_t size, std::align_val_t alignment, const std::nothrow_t& ) noexcept
+{
+  return allocate( size, static_cast<size_t>( alignment ) );
+}
+
+void* operator new[]( size_t size, std::align_val_t alignment, const std::nothrow_t& ) noexcept
+{
+  return allocate( size, static_cast<size_t>( alignment ) );
+}
+
+void operator delete( void* ptr ) noexcept { deallocate( ptr ); }
+void operator delete[]( void* ptr ) noexcept { deallocate( ptr ); }
+void operator delete( void* ptr, size_t ) noexcept { deallocate( ptr ); }
+void operator delete[]( void* ptr, size_t ) noexcept { deallocate( ptr ); }
+void operator delete( void* ptr, std::align_val_t ) noexcept { deallocate( ptr ); }
+void operator delete[]( void* ptr, std::align_val_t ) noexcept { deallocate( ptr ); }
+void operator delete( void* ptr, size_t, std::align_val_t ) noexcept { deallocate( ptr ); }
+void operator delete[]( void* ptr, size_t, std::align_val_t ) noexcept { deallocate( ptr ); }
+void operator delete( void* ptr, const std::nothrow_t& ) noexcept { deallocate( ptr ); }
+void operator delete[]( void* ptr, const std::nothrow_t& ) noexcept { deallocate( ptr ); }
+void operator delete( void* ptr, std::align_val_t, const std::nothrow_t& ) noexcept { deallocate( ptr ); }
+void operator delete[]( void* ptr, std::align_val_t, const std::nothrow_t& ) noexcept { deallocate( ptr ); }
@@ -0,0 +1,61 @@
+#pragma once
+#include "core/common.hpp"
+
+namespace core::system::memory
+{
+#define xMemoryTagEnum( X )   \
+  X( MemoryTag, Untagged )    \
+  X( MemoryTag, Data )        \
+  X( MemoryTag, Logic )       \
+  X( MemoryTag, Render )      \
+  X( MemoryTag, Task )        \
+  X( MemoryTag, Fs )
+
+  // every heap allocation of program is counted under tag of scope it was made in.
+  // memory is released to the same tag, no matter which thread or scope frees it
+  mCoreDeclareEnum( MemoryTag, xMemoryTagEnum );
+
+  inline constexpr u32 sMemoryTagCount = MemoryTag_Fs + 1;
+
+  struct MemoryTagStats
+  {
+    u64 liveBytes   = 0;
+    u64 peakBytes   = 0; // high-water mark of live bytes
+    u64 allocations = 0; // all time
+    u64 budget      = 0; // 0 is unlimited
+  };
+
+  Status init();
+  void   destroy();
+
+  // main thread, once per frame. logs tags which went over budget.
+  // steady frame is one where nothing loads: with allocation check on, after warmup steady frames in a row
+  // every next steady frame must not allocate at all
+  void frameEnd( bool isSteady );
+
+  void           setBudget( MemoryTag tag, u64 bytes );
+  MemoryTagStats getTagStats( MemoryTag tag );
+  u64            getAllocationCount(); // all tags, all time
+  void           logReport();
+
+  void setAllocationCheck( bool enabled, u32 warmupFrames = 60 );
+
+
+  // sets tag of current thread until end of scope, nested scopes restore previous tag
+  class MemoryScope
+  {
+    MemoryTag previous_;
+
+  public:
+    explicit MemoryScope( MemoryTag tag ) noexcept;
+    ~MemoryScope();
+
+    MemoryScope( const MemoryScope& )            = delete;
+    MemoryScope& operator=( const MemoryScope& ) = delete;
+  };
+} // namespace core::system::memory
+
+
+// mCoreMemoryScope( Data ), tag is member name of MemoryTag
+#define mCoreMemoryScope( tag ) \
+  ::core::system::memory::MemoryScope mCoreConcat( memoryScope, __LINE__ )( ::core::system::memory::MemoryTag_##tag )
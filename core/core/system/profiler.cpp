@@ -0,0 +1,341 @@
+#include "core/system/profiler.hpp"
+#include "core/system/system.hpp"
+#include "core/fs/file.hpp"
+
+using namespace core;
+using namespace core::system;
+
+
+namespace
+{
+  using profiler::details::ProfileEvent;
+  using profiler::details::sThreadRingSize;
+
+  constexpr u64 sCalibrationNs = 2'000'000;
+
+  // written only by owning thread, read only by main thread in frameEnd
+  struct ThreadRing
+  {
+    std::atomic<u64>                head   = 0; // events written, published with release
+    u64                             tail   = 0; // events collected
+    u32                             index  = 0;
+    std::atomic<const char*>        name   = nullptr;
+    std::unique_ptr<ProfileEvent[]> events = std::make_unique<ProfileEvent[]>( sThreadRingSize );
+  };
+
+  struct FrameEvent
+  {
+    const char* name;
+    u64         beginNs;
+    u64         endNs;
+    u32         thread;
+  };
+
+  struct ProfileFrame
+  {
+    u64                     index   = 0;
+    u64                     beginNs = 0;
+    u64                     endNs   = 0;
+    std::vector<FrameEvent> events;
+  };
+
+  struct StaticData
+  {
+    profiler::ProfilerOptions options;
+
+    std::mutex                               ringsMutex; // new threads register while frame end collects rings
+    std::vector<std::unique_ptr<ThreadRing>> rings;
+
+    std::vector<ProfileFrame> history; // ring of options.historyFrames
+    u64                       frameIndex    = 0;
+    u64                       frameBeginNs  = 0;
+    u64                       lastDumpFrame = 0;
+
+    // ticks to nanoseconds, refined each frame as measured interval grows
+    u64 originTicks = 0;
+    u64 originNs    = 0;
+    f64 nsPerTick   = 1;
+
+    profiler::FrameSummary             summary;
+    emhash8::HashMap<const char*, u32> summaryIndex; // name to index in summary scopes
+  };
+
+  StaticData* sData = nullptr;
+
+
+  u64 getClockNs()
+  {
+    auto sinceEpoch = std::chrono::steady_clock::now().time_since_epoch();
+    return static_cast<u64>( std::chrono::duration_cast<std::chrono::nanoseconds>( sinceEpoch ).count() );
+  }
+
+  void calibrate()
+  {
+    u64 ticks = profiler::getTicks();
+    u64 ns    = getClockNs();
+    if( ticks > sData->originTicks && ns > sData->originNs )
+      sData->nsPerTick = static_cast<f64>( ns - sData->originNs ) / static_cast<f64>( ticks - sData->originTicks );
+  }
+
+  u64 ticksToNs( u64 ticks )
+  {
+    auto diff = static_cast<f64>( static_cast<s64>( ticks - sData->originTicks ) ) * sData->nsPerTick;
+    return sData->originNs + static_cast<u64>( std::max( diff, 0.0 ) );
+  }
+
+  // thread rings of previous initialization are recognized by generation
+  u32 sLastGeneration = 0;
+
+  thread_local ThreadRing* tRing           = nullptr;
+  thread_local u32         tRingGeneration = 0;
+
+
+  ThreadRing* getThreadRing( u32 generation )
+  {
+    if( tRingGeneration == generation )
+      return tRing;
+
+    auto lock  = std::lock_guard( sData->ringsMutex );
+    auto* ring = sData->rings.emplace_back( std::make_unique<ThreadRing>() ).get();
+    ring->index     = static_cast<u32>( sData->rings.size() - 1 );
+    tRing           = ring;
+    tRingGeneration = generation;
+
+    profiler::details::tCursor = profiler::details::ThreadCursor{
+        .events     = ring->events.get(),
+        .head       = &ring->head,
+        .generation = generation,
+    };
+    return ring;
+  }
+
+  // events which writer could overwrite while they were copied are thrown away
+  void collectRing( ThreadRing& ring, std::vector<FrameEvent>& out, u32& dropped )
+  {
+    u64 head  = ring.head.load( std::memory_order_acquire );
+    u64 begin = std::max( ring.tail, head > sThreadRingSize ? head - sThreadRingSize : 0 );
+
+    size_t first = out.size();
+    for( u64 i = begin; i < head; ++i )
+    {
+      const auto& event = ring.events[i & ( sThreadRingSize - 1 )];
+      out.push_back( FrameEvent{
+          .name    = event.name,
+          .beginNs = ticksToNs( event.beginTicks ),
+          .endNs   = ticksToNs( event.endTicks ),
+          .thread  = ring.index,
+      } );
+    }
+
+    u64 after = ring.head.load( std::memory_order_acquire );
+    u64 safe  = std::clamp( after > sThreadRingSize ? after - sThreadRingSize : 0, begin, head );
+    out.erase( out.begin() + static_cast<ptrdiff_t>( first ),
+               out.begin() + static_cast<ptrdiff_t>( first + ( safe - begin ) ) );
+
+    dropped += static_cast<u32>( safe - ring.tail );
+    ring.tail = head;
+  }
+
+  void updateSummary( const ProfileFrame& frame, u32 dropped )
+  {
+    auto& summary      = sData->summary;
+    summary.frameIndex = frame.index;
+    summary.frameMs    = static_cast<f32>( frame.endNs - frame.beginNs ) / 1e6f;
+    summary.events     = static_cast<u32>( frame.events.size() );
+    summary.dropped    = dropped;
+    summary.scopes.clear();
+    sData->summaryIndex.clear();
+
+    for( const auto& event: frame.events )
+    {
+      auto [it, inserted] = sData->summaryIndex.try_emplace( event.name, static_cast<u32>( summary.scopes.size() ) );
+      if( inserted )
+        summary.scopes.push_back( profiler::ScopeSummary{ .name = event.name, .calls = 0, .totalMs = 0, .maxMs = 0 } );
+
+      auto& scope = summary.scopes[it->second];
+      f32   ms    = static_cast<f32>( event.endNs - event.beginNs ) / 1e6f;
+      scope.calls++;
+      scope.totalMs += ms;
+      scope.maxMs = std::max( scope.maxMs, ms );
+    }
+
+    std::ranges::sort( summary.scopes, std::greater{}, &profiler::ScopeSummary::totalMs );
+  }
+
+  void appendFormat( std::string& out, const char* fmt, ... )
+  {
+    va_list args;
+    va_start( args, fmt );
+    out += core::formatMessage( fmt, args );
+    va_end( args );
+  }
+
+  void dumpSlowFrame( const ProfileFrame& frame )
+  {
+    sData->lastDumpFrame = frame.index;
+
+    auto directory = stdfs::path();
+    if( getExeDirectory( directory ) != StatusOk )
+      directory = stdfs::current_path();
+
+    auto path = ( directory / ( "profile-slow-frame-" + std::to_string( frame.index ) + ".json" ) ).string();
+    if( auto s = profiler::exportChromeTrace( path.c_str() ); s != StatusOk )
+    {
+      mCoreLogError( "slow frame trace is not written: %d\n", static_cast<int>( s ) );
+      return;
+    }
+
+    mCoreLog( "slow frame " mFmtU64 " (%.2fms), last " mFmtU32 " frames are written to %s\n",
+              frame.index, static_cast<f64>( frame.endNs - frame.beginNs ) / 1e6, sData->options.historyFrames, path.c_str() );
+    profiler::logFrameSummary();
+  }
+} // namespace
+
+
+std::atomic<u32>                                       profiler::details::sGeneration = 0;
+thread_local constinit profiler::details::ThreadCursor profiler::details::tCursor;
+
+
+Status profiler::init( ProfilerOptions options )
+{
+  sData                        = new StaticData();
+  sData->options               = options;
+  sData->options.historyFrames = std::max( options.historyFrames, 1u );
+  sData->history.resize( sData->options.historyFrames );
+
+  // first estimate of tick length, so first frames are not far off
+  sData->originTicks = getTicks();
+  sData->originNs    = getClockNs();
+  while( getClockNs() - sData->originNs < sCalibrationNs )
+    std::this_thread::yield();
+  calibrate();
+  sData->frameBeginNs = getClockNs();
+
+  profiler::details::sGeneration.store( ++sLastGeneration, std::memory_order_release );
+  setThreadName( "main" );
+
+#if mCoreProfilerEnabled
+  mCoreLog( "profiler: " mFmtU32 " frames of history, slow frame %.1fms\n",
+            sData->options.historyFrames, static_cast<f64>( sData->options.slowFrameMs ) );
+#else
+  mCoreLog( "profiler: scopes are compiled out\n" );
+#endif
+  return StatusOk;
+}
+
+void profiler::destroy()
+{
+  profiler::details::sGeneration.store( 0, std::memory_order_release );
+  delete sData;
+  sData = nullptr;
+}
+
+void profiler::details::recordNewThread( const char* name, u64 beginTicks, u64 endTicks ) noexcept
+{
+  u32 generation = sGeneration.load( std::memory_order_acquire );
+  if( !generation )
+    return;
+
+  getThreadRing( generation );
+  record( name, beginTicks, endTicks );
+}
+
+void profiler::setThreadName( const char* name )
+{
+  u32 generation = details::sGeneration.load( std::memory_order_acquire );
+  if( generation )
+    getThreadRing( generation )->name = name;
+}
+
+void profiler::frameEnd()
+{
+  calibrate();
+  u64 frameEndNs = getClockNs();
+
+  auto& frame   = sData->history[sData->frameIndex % sData->history.size()];
+  frame.index   = sData->frameIndex++;
+  frame.beginNs = sData->frameBeginNs;
+  frame.endNs   = frameEndNs;
+  frame.events.clear();
+  sData->frameBeginNs = frameEndNs;
+
+  u32 dropped = 0;
+  {
+    auto lock = std::lock_guard( sData->ringsMutex );
+    for( auto& ring: sData->rings )
+      collectRing( *ring, frame.events, dropped );
+  }
+
+  updateSummary( frame, dropped );
+
+  const auto& options = sData->options;
+  bool        isSlow  = options.slowFrameMs > 0 && sData->summary.frameMs > options.slowFrameMs;
+  bool        isReady = !sData->lastDumpFrame || frame.index - sData->lastDumpFrame >= options.slowFrameCooldown;
+  if( mCoreProfilerEnabled && isSlow && isReady && frame.index >= options.historyFrames )
+    dumpSlowFrame( frame );
+}
+
+const profiler::FrameSummary& profiler::getFrameSummary()
+{
+  return sData->summary;
+}
+
+void profiler::logFrameSummary( u32 maxScopes )
+{
+  const auto& summary = sData->summary;
+  mCoreLog( "frame " mFmtU64 ": %.2fms, " mFmtU32 " scopes, " mFmtU32 " dropped\n",
+            summary.frameIndex, static_cast<f64>( summary.frameMs ), summary.events, summary.dropped );
+
+  for( const auto& scope: summary.scopes | std::views::take( maxScopes ) )
+    mCoreLog( "  %-32s " mFmtU32 " calls, total %.3fms, max %.3fms\n",
+              scope.name, scope.calls, static_cast<f64>( scope.totalMs ), static_cast<f64>( scope.maxMs ) );
+}
+
+Status profiler::exportChromeTrace( const char* path )
+{
+  // history ring starts at oldest frame
+  auto frames = std::vector<const ProfileFrame*>();
+  for( u64 i = 0; i < sData->history.size(); ++i )
+  {
+    const auto& frame = sData->history[( sData->frameIndex + i ) % sData->history.size()];
+    if( frame.endNs )
+      frames.push_back( &frame );
+  }
+  if( frames.empty() )
+  {
+    core::setErrorDetails( "no frames in profiler history" );
+    return StatusNotFound;
+  }
+
+  // timestamps are microseconds from start of oldest frame
+  u64  originNs = frames.front()->beginNs;
+  auto toUs     = [originNs]( u64 ns ) { return static_cast<f64>( ns - std::min( ns, originNs ) ) / 1e3; };
+
+  auto out = std::string( "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n" );
+  {
+    auto lock = std::lock_guard( sData->ringsMutex );
+    for( const auto& ring: sData->rings )
+    {
+      const char* name       = ring->name.load();
+      auto        threadName = name ? std::string( name ) : "thread " + std::to_string( ring->index );
+      appendFormat( out, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" mFmtU32 ",\"args\":{\"name\":\"%s\"}},\n",
+                    ring->index, threadName.c_str() );
+    }
+  }
+  out += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":-1,\"args\":{\"name\":\"frames\"}},\n";
+
+  for( const auto* frame: frames )
+  {
+    // frames are on their own track, so slow one is easy to find
+    appendFormat( out, "{\"name\":\"frame " mFmtU64 "\",\"ph\":\"X\",\"pid\":0,\"tid\":-1,\"ts\":%.3f,\"dur\":%.3f},\n",
+                  frame->index, toUs( frame->beginNs ), toUs( frame->endNs ) - toUs( frame->beginNs ) );
+
+    for( const auto& event: frame->events )
+      appendFormat( out, "{\"name\":\"%s\",\"ph\":\"X\",\"pid\":0,\"tid\":" mFmtU32 ",\"ts\":%.3f,\"dur\":%.3f},\n",
+                    event.name, event.thread, toUs( event.beginNs ), toUs( event.endNs ) - toUs( event.beginNs ) );
+  }
+
+  out.resize( out.size() - 2 ); // trailing comma
+  out += "\n]}\n";
+  return fs::writeFile( path, std::span( reinterpret_cast<const byte*>( out.data() ), out.size() ) );
+}
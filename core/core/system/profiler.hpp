@@ -0,0 +1,139 @@
+#pragma once
+#include "core/common.hpp"
+#include <atomic>
+
+#if defined( _MSC_VER )
+#  include <intrin.h>
+#elif defined( __x86_64__ )
+#  include <x86intrin.h>
+#endif
+
+// set by cmake option VY_PROFILER. with 0 scopes compile to nothing, functions below still exist
+#ifndef mCoreProfilerEnabled
+#  define mCoreProfilerEnabled 1
+#endif
+
+namespace core::system::profiler
+{
+  struct ScopeSummary
+  {
+    const char* name;
+    u32         calls;
+    f32         totalMs; // summed over all threads
+    f32         maxMs;
+  };
+
+  struct FrameSummary
+  {
+    u64                       frameIndex = 0;
+    f32                       frameMs    = 0;
+    u32                       events     = 0;
+    u32                       dropped    = 0; // events overwritten in thread ring before frame end collected them
+    std::vector<ScopeSummary> scopes;       // sorted by total time
+  };
+
+  struct ProfilerOptions
+  {
+    u32 historyFrames     = 120;  // kept for export and slow frame dump
+    f32 slowFrameMs       = 50.f; // frame longer than this dumps history, 0 disables
+    u32 slowFrameCooldown = 600;  // frames between automatic dumps
+  };
+
+  Status init( ProfilerOptions options = {} );
+  void   destroy();
+
+  // main thread, once per frame: collects events of all threads into history
+  void frameEnd();
+
+  // scopes of calling thread are shown under this name in trace, pointer must stay valid
+  void setThreadName( const char* name );
+
+  const FrameSummary& getFrameSummary(); // of last finished frame
+  void                logFrameSummary( u32 maxScopes = 10 );
+
+  // chrome://tracing and ui.perfetto.dev format, all frames in history
+  Status exportChromeTrace( const char* path );
+
+  namespace details
+  {
+    inline constexpr u32 sThreadRingSize = 1u << 15; // events one thread may record between two frame ends
+
+    struct ProfileEvent
+    {
+      const char* name;
+      u64         beginTicks;
+      u64         endTicks;
+    };
+
+    // ring of calling thread, valid while its generation is the current one
+    struct ThreadCursor
+    {
+      ProfileEvent*     events     = nullptr;
+      std::atomic<u64>* head       = nullptr;
+      u32               generation = 0;
+    };
+
+    extern std::atomic<u32>                   sGeneration; // 0 while profiler is not initialized
+    extern thread_local constinit ThreadCursor tCursor;
+
+    void recordNewThread( const char* name, u64 beginTicks, u64 endTicks ) noexcept; // registers ring first
+  } // namespace details
+
+  // used by scope, thread safe. inlined: call and ring lookup would take what is left of
+  // scope budget after two timestamps
+  inline void record( const char* name, u64 beginTicks, u64 endTicks ) noexcept
+  {
+    u32   generation = details::sGeneration.load( std::memory_order_acquire );
+    auto& cursor     = details::tCursor;
+    if( cursor.generation != generation || !generation )
+    {
+      details::recordNewThread( name, beginTicks, endTicks );
+      return;
+    }
+
+    u64 head = cursor.head->load( std::memory_order_relaxed );
+    cursor.events[head & ( details::sThreadRingSize - 1 )] = details::ProfileEvent{ .name = name, .beginTicks = beginTicks, .endTicks = endTicks };
+    cursor.head->store( head + 1, std::memory_order_release );
+  }
+
+  // steady clock costs about as much as whole scope budget, so scopes take cpu timestamp counter.
+  // ticks are converted to nanoseconds when frame is collected
+  inline u64 getTicks() noexcept
+  {
+#if defined( _M_X64 ) || defined( __x86_64__ )
+    return __rdtsc();
+#else
+    auto sinceEpoch = std::chrono::steady_clock::now().time_since_epoch();
+    return static_cast<u64>( std::chrono::duration_cast<std::chrono::nanoseconds>( sinceEpoch ).count() );
+#endif
+  }
+
+
+  class Scope
+  {
+    const char* name_;
+    u64         beginTicks_;
+
+  public:
+    explicit Scope( const char* name ) noexcept
+        : name_( name )
+        , beginTicks_( getTicks() )
+    {}
+
+    ~Scope() { record( name_, beginTicks_, getTicks() ); }
+
+    Scope( const Scope& )            = delete;
+    Scope& operator=( const Scope& ) = delete;
+  };
+} // namespace core::system::profiler
+
+
+// name must be string literal or other string with static lifetime
+#if mCoreProfilerEnabled
+#  define mCoreProfileScope( name ) \
+    ::core::system::profiler::Scope mCoreConcat( profileScope, __LINE__ )( name )
+#else
+#  define mCoreProfileScope( name )
+#endif
+
+#define mCoreProfileFunction() mCoreProfileScope( __FUNCTION__ )
@@ -1,6 +1,5 @@
 #include "core/system/system.hpp"
 #include "core/common.hpp"
-#include <windows.h>
 #include <cstdlib>
 
 using namespace core;
@@ -14,20 +13,33 @@ using namespace core;
   va_end( args );
 
   mCoreLogError( "FATAL ERROR: %s", message.c_str() );
+#ifdef _WIN32
   MessageBoxA( nullptr, message.c_str(), "Fatal Error", MB_OK );
+#endif
   std::abort();
 }
 
 
 Status system::getExeDirectory( stdfs::path& out )
 {
+#ifdef _WIN32
   char exePathData[MAX_PATH];
   if( !GetModuleFileNameA( nullptr, exePathData, sizeof( exePathData ) ) )
   {
     core::setErrorDetails( "error getting process name" );
     return StatusSystemError;
   }
+  auto exePath = stdfs::path( exePathData );
+#else
+  auto error   = std::error_code();
+  auto exePath = stdfs::read_symlink( "/proc/self/exe", error );
+  if( error )
+  {
+    core::setErrorDetails( "error getting process name: %s", error.message().c_str() );
+    return StatusSystemError;
+  }
+#endif
 
-  out = stdfs::path( exePathData ).parent_path();
+  out = exePath.parent_path();
   return StatusOk;
 }
@@ -1,8 +1,13 @@
 #pragma once
 #include "core/common.hpp"
 #include "core/system/time.hpp"
+#include "core/system/profiler.hpp"
+#include "core/system/memory.hpp"
+#include "core/system/frame-allocator.hpp"
+#include "core/system/frame-report.hpp"
 #include "core/system/message-queue.hpp"
 #include "core/system/task.hpp"
+#include "core/system/init-graph.hpp"
 
 namespace core::system
 {
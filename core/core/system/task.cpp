@@ -11,7 +11,7 @@ namespace
   struct StaticData
   {
     system::MessageQueue<Task> defferedTasks;
-    BS::thread_pool            threadPool{ 1 };
+    BS::thread_pool            threadPool{ 1, []() { profiler::setThreadName( "worker" ); } };
     std::list<PeriodicalTask>  periodicalTasks;
   };
 
@@ -27,12 +27,17 @@ Status task::init()
 
 void task::destroy()
 {
+  // queued tasks are dropped, running ones still may add deffered tasks
   sData->threadPool.purge();
+  sData->threadPool.wait();
   delete sData;
 }
 
 void task::update()
 {
+  mCoreProfileScope( "task::update" );
+  mCoreMemoryScope( Task );
+
   // do deffered tasks
   {
     auto stopwatch      = core::system::Stopwatch();
@@ -48,7 +53,10 @@ void task::update()
         break;
       }
 
-      ( *message )();
+      {
+        mCoreProfileScope( "deffered task" );
+        ( *message )();
+      }
       tasksCompleted++;
 
       u64 timePassedMs = stopwatch.getMs();
@@ -91,7 +99,18 @@ void task::runPeriodical( PeriodicalTask task )
   sData->periodicalTasks.emplace_back( std::move( task ) );
 }
 
-void task::runAsync( Task task )
+void task::wait()
 {
-  ( void ) sData->threadPool.detach_task( std::move( task ) );
+  sData->threadPool.wait();
+}
+
+void task::runAsync( Task task, TaskPriority priority )
+{
+  auto poolPriority = priority == TaskPriorityLow ? BS::pr::low : BS::pr::normal;
+  task = [task = std::move( task )]() mutable {
+    mCoreProfileScope( "async task" );
+    mCoreMemoryScope( Task );
+    task();
+  };
+  ( void ) sData->threadPool.detach_task( std::move( task ), poolPriority );
 }
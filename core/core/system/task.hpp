@@ -14,19 +14,28 @@ namespace core::system::task
     PeriodicalStatusStop,
   };
 
+  enum TaskPriority
+  {
+    TaskPriorityNormal,
+    TaskPriorityLow, // background work like prefetching, runs when nothing else is queued
+  };
+
   using Task           = std::move_only_function<void()>;
   using PeriodicalTask = std::move_only_function<PeriodicalStatus()>;
 
   void runDeffered( Task task );
-  void runAsync( Task task );
+  void runAsync( Task task, TaskPriority priority = TaskPriorityNormal );
   void runPeriodical( PeriodicalTask task );
 
+  // main thread: blocks until async tasks, queued and running, are done. deffered tasks they add are not run
+  void wait();
+
 
   template<typename F>
-  auto ctiAsync( F&& f ) -> cti::continuable<typename std::invoke_result_t<F>::value_type>
+  auto ctiAsync( F&& f, TaskPriority priority = TaskPriorityNormal ) -> cti::continuable<typename std::invoke_result_t<F>::value_type>
   {
     using TResult = typename std::invoke_result_t<F>::value_type;
-    return cti::make_continuable<TResult>( [f = std::move( f )]( auto&& promise ) {
+    return cti::make_continuable<TResult>( [f = std::move( f ), priority]( auto&& promise ) {
       core::system::task::runAsync( [f       = std::move( f ),
                                      promise = std::forward<decltype( promise )>( promise )]() mutable {
         auto expected = f();
@@ -34,7 +43,8 @@ namespace core::system::task
           promise.set_value( std::move( expected ).value() );
         else
           promise.set_exception( expected.error() );
-      } );
+      },
+                                    priority );
     } );
   }
 
@@ -38,7 +38,12 @@ void DeltaTime::onLoopStart()
 
 void DeltaTime::onLoopEnd()
 {
-  us_  = sw_.getUs();
+  setUs( sw_.getUs() );
+}
+
+void DeltaTime::setUs( u64 us )
+{
+  us_  = us;
   msf_ = static_cast<f32>( us_ ) / 1000.f;
   ms_  = static_cast<u32>( ceilf( msf_ ) );
 }
@@ -31,6 +31,7 @@ namespace core::system
   public:
     void onLoopStart();
     void onLoopEnd();
+    void setUs( u64 us ); // replaces measured time, for replay
 
     u64 getUs() const { return us_; }   // microseconds
     u32 getMs() const { return ms_; }   // milliseconds
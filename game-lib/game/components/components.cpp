@@ -67,8 +67,7 @@ void FreeFlyCameraComponent::update( const core::system::DeltaTime& )
 
   core::math::Camera camera;
   camera.focalLength = 28.0f;
-  camera.aspectRatio = core::render::gapi::gDevice->viewport.fSize.x /
-                       core::render::gapi::gDevice->viewport.fSize.y;
+  camera.aspectRatio = core::render::getViewportSize().x / core::render::getViewportSize().y;
   camera.position  = transform->props.position;
   camera.direction = rotation.getForward();
 
@@ -106,15 +105,43 @@ void ScenePortalComponent::update( const core::system::DeltaTime& dt )
   {
     if( auto* camera = it->tryGetComponent<FreeFlyCameraComponent>() )
     {
-      if( bb.isInside( camera->transform->props.position ) )
+      f32 distance = bb.distanceTo( camera->transform->props.position );
+
+      if( distance <= 0.f )
       {
-        core::logic::sceneUnload( getEntity()->getScene()->getId() );
+        // load first: chunks shared with current scene are referenced before current scene releases them
         core::logic::sceneLoad( props.toSceneId );
+        core::logic::sceneUnload( getEntity()->getScene()->getId() );
+        prefetchRequested = false;
+      }
+      else if( distance < props.prefetchRadius )
+      {
+        // closer portal is more likely to be entered, its chunks go before ones of farther portals
+        auto priority = distance < props.prefetchRadius * 0.5f ? core::data::LoadPriority_VisibleSoon
+                                                               : core::data::LoadPriority_Prefetch;
+        if( !prefetchRequested || priority != prefetchPriority )
+        {
+          core::logic::scenePrefetch( props.toSceneId, priority );
+          prefetchRequested = true;
+          prefetchPriority  = priority;
+        }
+      }
+      else if( prefetchRequested && distance > props.prefetchRadius * 1.5f )
+      {
+        // hysteresis, so walking along the radius border doesn't restart prefetch each frame
+        core::logic::scenePrefetchCancel( props.toSceneId );
+        prefetchRequested = false;
       }
     }
   }
 }
 
+void ScenePortalComponent::shutdown()
+{
+  if( prefetchRequested )
+    core::logic::scenePrefetchCancel( props.toSceneId );
+}
+
 
 void game::registerComponents()
 {
@@ -31,16 +31,20 @@ namespace game
     struct Props
     {
       StringHash toSceneId;
+      f32        prefetchRadius = 8.f; // target scene is loaded in background when camera is closer than this
 
-      NLOHMANN_DEFINE_TYPE_INTRUSIVE( Props, toSceneId );
+      NLOHMANN_DEFINE_TYPE_INTRUSIVE_WITH_DEFAULT( Props, toSceneId, prefetchRadius );
     };
 
     mCoreComponent( ScenePortalComponent );
 
-    core::math::BoundingBox bb;
+    core::math::BoundingBox  bb;
+    bool                     prefetchRequested = false;
+    core::data::LoadPriority prefetchPriority  = core::data::LoadPriority_Prefetch;
 
     void init() override;
     void update( const core::system::DeltaTime& dt ) override;
+    void shutdown() override;
   };
 
 
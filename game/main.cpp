@@ -3,23 +3,130 @@
 #include "game/components/components.hpp"
 
 
-int main( int, char** )
+namespace
 {
-  if( auto s = core::initialize(); s != StatusOk )
+  struct GameOptions
+  {
+    const char* scene            = "maps/mall-real/mall-real-split/mref";
+    u64         frames           = 0; // run this many frames and quit, 0 runs until window is closed
+    bool        checkAllocations = false;
+    const char* record           = nullptr; // input and delta times are written here on exit
+    const char* replay           = nullptr; // played instead of live input, game quits when it ends
+    f32         fixedDtMs        = 0;       // for replay, 0 uses recorded delta times
+    const char* report           = nullptr; // frame time report in json, to compare runs
+  };
+
+  bool parseOptions( int argc, char** argv, GameOptions& options )
+  {
+    for( int i = 1; i < argc; ++i )
+    {
+      auto arg     = std::string_view( argv[i] );
+      bool hasNext = i + 1 < argc;
+
+      if( arg == "-check-allocations" )
+        options.checkAllocations = true;
+      else if( arg == "-scene" && hasNext )
+        options.scene = argv[++i];
+      else if( arg == "-frames" && hasNext )
+        options.frames = std::strtoull( argv[++i], nullptr, 10 );
+      else if( arg == "-record" && hasNext )
+        options.record = argv[++i];
+      else if( arg == "-replay" && hasNext )
+        options.replay = argv[++i];
+      else if( arg == "-fixed-dt-ms" && hasNext )
+        options.fixedDtMs = std::strtof( argv[++i], nullptr );
+      else if( arg == "-report" && hasNext )
+        options.report = argv[++i];
+      else
+      {
+        printf( "unknown option: %s\n", argv[i] );
+        printf( "usage: game [-scene scene-id] [-frames count] [-check-allocations]\n"
+                "            [-record file | -replay file [-fixed-dt-ms ms]] [-report file.json]\n" );
+        return false;
+      }
+    }
+    return true;
+  }
+
+
+  Status startInput( const GameOptions& options )
+  {
+    if( options.record )
+      return core::input::startRecording();
+    if( options.replay )
+    {
+      auto replayOptions = core::input::ReplayOptions{ .fixedDtUs = static_cast<u64>( options.fixedDtMs * 1000.f ) };
+      return core::input::startReplay( options.replay, replayOptions );
+    }
+    return StatusOk;
+  }
+} // namespace
+
+
+int main( int argc, char** argv )
+{
+  auto options = GameOptions();
+  if( !parseOptions( argc, argv, options ) )
+    return 1;
+
+  // scene files are read while render device is created
+  auto initOptions        = core::InitOptions();
+  initOptions.onDataReady = [&options]() {
+    game::registerComponents();
+    //core::logic::sceneLoad( "X0/MR1F-MFA/mr1f-pp" );
+    //core::logic::sceneLoad( "maps/mall-real/mall-real-split" );
+    core::logic::sceneLoad( StringId( options.scene ) );
+  };
+
+  if( auto s = core::initialize( std::move( initOptions ) ); s != StatusOk )
     core::system::fatalError( "Core initialization failed: %d %s", static_cast<int>( s ), core::getErrorDetails() );
 
-  game::registerComponents();
-  //core::logic::sceneLoad( "X0/MR1F-MFA/mr1f-pp" );
-  //core::logic::sceneLoad( "maps/mall-real/mall-real-split" );
-  core::logic::sceneLoad( "maps/mall-real/mall-real-split/mref"_sid );
+  // once scene is loaded, frames must not touch heap
+  if( options.checkAllocations )
+    core::system::memory::setAllocationCheck( true );
+
+  if( auto s = startInput( options ); s != StatusOk )
+    core::system::fatalError( "Input replay start failed: %d %s", static_cast<int>( s ), core::getErrorDetails() );
+
+  // report is made for runs which end by themselves, so they can be compared
+  bool collectReport = options.frames || options.replay || options.report;
+  auto report        = core::system::FrameReport();
+  report.reserve( static_cast<u32>( std::max<u64>( options.frames, core::input::getReplayFrameCount() ) ) );
 
-  for( ;; )
+  // headless build has no window to close, it is run with frame count or replay
+  for( u64 frame = 0; !options.frames || frame < options.frames; ++frame )
   {
+    if( options.replay && !core::input::isReplaying() )
+      break;
+
     if( auto loopStatus = core::loopStepBegin();
         loopStatus == core::LoopStatusQuitRequested )
       break;
 
     core::loopStepEnd();
+
+    if( collectReport )
+    {
+      report.addFrame( core::loopGetDeltaTime().getMsF(), core::logic::isLoading(), !core::logic::hasActiveScene() );
+      report.addScopes( core::system::profiler::getFrameSummary() );
+    }
+  }
+
+  if( options.record )
+  {
+    if( auto s = core::input::stopRecording( options.record ); s != StatusOk )
+      mCoreLogError( "error write input recording: %d %s\n", static_cast<int>( s ), core::getErrorDetails() );
+  }
+
+  if( collectReport )
+  {
+    report.setTimeToFirstFrame( core::getTimeToFirstFrameMs() );
+    report.log();
+    if( options.report )
+    {
+      if( auto s = report.writeJson( options.report ); s != StatusOk )
+        mCoreLogError( "error write frame report: %d %s\n", static_cast<int>( s ), core::getErrorDetails() );
+    }
   }
 
   core::destroy();
@@ -4,90 +4,557 @@
 #include "render-chunk/texture.hpp"
 #include "render-chunk/mesh.hpp"
 #include "scene/process-scene.hpp"
-#include <execution>
+#include "util/task-graph.hpp"
+#include "util/build-cache.hpp"
+#include "util/msgpack-stream.hpp"
+#include "util/dictionaries.hpp"
 
 
 namespace
 {
-  intermediate::ScenesInfo readSceneInput( const char* path )
+  constexpr int sSceneCompressionLevel = 19; // scene jsons are small
+
+
+  // input is read one object at a time, so only the object being parsed has its vertex data in memory
+  // until mesh task processes it. containers are reserved up front, so references stay valid while reading
+  void readSceneInput( const char* path, intermediate::ScenesInfo& scenesInfo,
+                       const std::function<void( intermediate::SceneInfo& )>& onScene,
+                       const std::function<void( intermediate::ObjectInfo& )>& onObject )
   {
-    auto objectHandle = msgpack::object_handle();
-    auto object       = msgpack::object();
-    mFailIf( core::fs::readFileMsgpack( path, object, objectHandle ) != StatusOk );
-    auto scenesInfo = intermediate::ScenesInfo();
-    object.convert( scenesInfo );
-    return scenesInfo;
+    auto reader = intermediate::MsgpackStreamReader( path );
+
+    for( u32 scenesInfoFields = reader.readMapHeader(); scenesInfoFields > 0; --scenesInfoFields )
+    {
+      if( reader.readString() != "scenes" )
+      {
+        reader.skip();
+        continue;
+      }
+
+      u32 sceneCount = reader.readArrayHeader();
+      scenesInfo.scenes.reserve( sceneCount );
+
+      for( u32 i = 0; i < sceneCount; ++i )
+      {
+        auto& sceneInfo = scenesInfo.scenes.emplace_back();
+        bool  announced = false;
+
+        for( u32 sceneFields = reader.readMapHeader(); sceneFields > 0; --sceneFields )
+        {
+          auto key = reader.readString();
+          if( key == "name" )
+          {
+            reader.read( sceneInfo.name );
+          }
+          else if( key == "objects" )
+          {
+            // exporter writes name first, objects are processed as part of named scene
+            mFailIf( sceneInfo.name.empty() );
+            onScene( sceneInfo );
+            announced = true;
+
+            u32 objectCount = reader.readArrayHeader();
+            sceneInfo.objects.reserve( objectCount );
+
+            for( u32 j = 0; j < objectCount; ++j )
+            {
+              auto& object = sceneInfo.objects.emplace_back();
+              reader.read( object );
+              onObject( object );
+            }
+          }
+          else
+          {
+            reader.skip();
+          }
+        }
+
+        // scene without objects still gets its chunk and json
+        if( !announced )
+        {
+          mFailIf( sceneInfo.name.empty() );
+          onScene( sceneInfo );
+        }
+      }
+    }
   }
 
 
-  void writeRenderChunk( const intermediate::SceneInfo&   sceneInfo,
-                         const core::data::schema::Chunk& renderChunk,
-                         bool                             useCompression )
+  // render chunk is packed and compressed straight to file by its write task
+  struct ChunkBuild
   {
-    auto outputPath = stdfs::path( core::data::getDataPath( sceneInfo.name + ".chunk" ) );
-    stdfs::create_directories( outputPath.parent_path() );
+    std::string                           name; // relative path, without extension
+    u64                                   key = 0; // build cache key, known after partition
+    std::vector<core::data::schema::Mesh> meshes;
+    std::vector<u64>                      textures; // only ids, textures are read from dds while writing
+  };
+
+  struct SceneBuild
+  {
+    ChunkBuild                                          chunk;    // textures are not shared ones, filled by partition
+    std::deque<u64>                                     meshKeys; // filled by mesh tasks
+    std::deque<std::optional<core::data::schema::Mesh>> meshes;   // only meshes which were not in cache
+  };
+
+  struct BuildContext
+  {
+    intermediate::TaskGraph                           graph;
+    intermediate::BuildCache                          cache{ core::data::getDataPath( ".build-cache" ) };
+    std::unique_ptr<intermediate::ITextureCollection> textures = intermediate::makeTextureCollection( cache );
+    intermediate::ScenesInfo                          scenesInfo;
+    std::deque<SceneBuild>                            sceneBuilds; // same order as scenesInfo.scenes
+    std::vector<intermediate::TaskId>                 partitionDependencies; // texture and mesh tasks, parse task
+    intermediate::Dictionaries                        dictionaries = intermediate::loadDictionaries();
+    intermediate::DictionarySamples*                  samples      = nullptr; // when set, only samples are collected
+    int                                               meshCompressionLevel    = 1;
+    int                                               textureCompressionLevel = 1;
+    int                                               sceneCompressionLevel   = sSceneCompressionLevel;
+    std::atomic<u64>                                  sharedChunksBytes       = 0;
+    std::atomic<u64>                                  sceneChunksBytes        = 0;
+    std::atomic<u64>                                  chunksWritten           = 0;
+    std::atomic<u64>                                  chunksUpToDate          = 0;
+    std::atomic<u64>                                  scenesWritten           = 0;
+    std::atomic<u64>                                  scenesUpToDate          = 0;
+    std::vector<std::unique_ptr<ChunkBuild>>          sharedChunkBuilds;
+    std::vector<std::vector<std::string>>             sharedChunkScenes; // same order as sharedChunkBuilds
+  };
 
-    auto memoryWriter = intermediate::VectorWriter();
-    printf( "serializing render chunk...\n" );
-    msgpack::pack( memoryWriter, renderChunk );
 
-    int compressionLevel = useCompression ? 3 : 1;
-    printf( "writing render chunk %s (compression: %d)...\n", outputPath.string().c_str(), compressionLevel );
-    mFailIf( core::fs::writeFileCompressed( outputPath.string(), memoryWriter.bytes, compressionLevel ) != StatusOk );
-    printf( "render chunk written\n" );
+  std::string getChunkPath( const std::string& name )
+  {
+    return core::data::getDataPath( name + ".chunk" );
   }
 
 
-  void writeScene( const intermediate::SceneInfo& intermediateSceneInfo,
+  // returns write task
+  intermediate::TaskId addRenderChunkWrite( BuildContext& context, ChunkBuild& build,
+                                            std::function<void()> assemble, std::span<const intermediate::TaskId> dependencies,
+                                            std::atomic<u64>& writtenBytes )
+  {
+    using namespace intermediate;
+
+    return context.graph.add( BuildStage_Write, build.name, [&build, &context, &writtenBytes, assemble = std::move( assemble )]() {
+      if( assemble )
+        assemble();
+
+      auto outputPath = stdfs::path( getChunkPath( build.name ) );
+      stdfs::create_directories( outputPath.parent_path() );
+      printf( "writing render chunk %s...\n", outputPath.string().c_str() );
+
+      u64 chunkBytes = 0;
+      {
+        // same layout as msgpack of core::data::schema::Chunk. meshes and textures are in separate zstd frames,
+        // so each of them is compressed with its own level and dictionary
+        auto writer = core::fs::CompressedFileWriter( outputPath.string().c_str(), context.meshCompressionLevel );
+        writer.setCompressionLevel( context.meshCompressionLevel, context.dictionaries.mesh );
+
+        auto packer = msgpack::packer<ChunkWriter>( writer );
+        packer.pack_array( 2 );
+        packer.pack( build.meshes );
+        build.meshes = {};
+
+        writer.setCompressionLevel( context.textureCompressionLevel );
+        context.textures->packTextures( build.textures, writer );
+        build.textures = {};
+
+        mFailIf( writer.finish() != StatusOk );
+        chunkBytes = writer.getWrittenBytes();
+      }
+
+      context.cache.markBuilt( outputPath, build.key );
+      writtenBytes += chunkBytes;
+      context.chunksWritten++;
+    },
+                              dependencies );
+  }
+
+
+  void writeScene( BuildContext& context, const intermediate::SceneInfo& intermediateSceneInfo,
                    const core::data::ShSceneInfo& outSceneInfo )
   {
-    auto outputPath = stdfs::path( core::data::getDataPath( intermediateSceneInfo.name + ".scene.json" ) );
+    auto json = Json();
+    mFailIf( core::data::toJson( outSceneInfo, json ) != StatusOk );
+    auto text  = json.dump( 2, ' ', false, Json::error_handler_t::strict );
+    auto bytes = std::span( reinterpret_cast<const byte*>( text.data() ), text.size() );
+
+    if( context.samples )
+    {
+      context.samples->addScene( bytes );
+      return;
+    }
+
+    auto key = intermediate::BuildCache::makeKey();
+    key.update( bytes );
+    key.updateValue( context.dictionaries.sceneId );
+    key.updateValue( core::data::ShBinarySceneHeader::sVersion );
+
+    // plain json is kept until there is dictionary for it. compressed one has its own extension,
+    // so file named .json is always readable by editors
+    bool isCompressed = !context.dictionaries.scene.empty();
+    auto plainPath    = stdfs::path( core::data::getDataPath( intermediateSceneInfo.name + ".scene.json" ) );
+    auto packedPath   = stdfs::path( core::data::getDataPath( intermediateSceneInfo.name + ".scene.json.zst" ) );
+    auto outputPath   = isCompressed ? packedPath : plainPath;
+    auto binaryPath   = stdfs::path( core::data::getDataPath( intermediateSceneInfo.name + ".scene.bin" ) );
+    if( context.cache.isUpToDate( outputPath, key.digest() ) && context.cache.isUpToDate( binaryPath, key.digest() ) )
+    {
+      context.scenesUpToDate++;
+      return;
+    }
+
     stdfs::create_directories( outputPath.parent_path() );
     printf( "writing scene info %s...\n", outputPath.string().c_str() );
-    mFailIf( core::data::writeJsonFile( outputPath.string(), outSceneInfo ) != StatusOk );
+    if( isCompressed )
+    {
+      auto compressed = std::vector<byte>();
+      mFailIf( core::fs::compress( bytes, compressed, context.sceneCompressionLevel, context.dictionaries.scene ) != StatusOk );
+      mFailIf( core::fs::writeFile( outputPath.string(), compressed ) != StatusOk );
+    }
+    else
+    {
+      mFailIf( core::fs::writeFile( outputPath.string(), bytes ) != StatusOk );
+    }
+
+    // variant of previous build would be picked up by runtime and manifest
+    stdfs::remove( isCompressed ? plainPath : packedPath );
+
+    // binary scene is what runtime loads, json stays as debug format
+    auto binary = std::vector<byte>();
+    mFailIf( core::data::toBinary( outSceneInfo, binary ) != StatusOk );
+    mFailIf( core::fs::writeFile( binaryPath.string(), binary ) != StatusOk );
+
+    context.cache.markBuilt( outputPath, key.digest() );
+    context.cache.markBuilt( binaryPath, key.digest() );
+    context.scenesWritten++;
     printf( "scene info written\n" );
   }
 
 
-  void runSceneTool( const char* path, bool useCompression )
+  u64 makeSceneChunkKey( const BuildContext& context, const intermediate::ITextureCollection& textures,
+                         const SceneBuild& sceneBuild )
   {
-    auto scenesInfo = readSceneInput( path );
-    printf( "mesh tool parsed input file...\n" );
+    auto key = intermediate::BuildCache::makeKey();
+    key.updateValue( context.meshCompressionLevel );
+    key.updateValue( context.textureCompressionLevel );
+    key.updateValue( context.dictionaries.meshId );
+    key.update( sceneBuild.chunk.name.data(), sceneBuild.chunk.name.size() );
+    for( u64 meshKey: sceneBuild.meshKeys )
+      key.updateValue( meshKey );
+    for( u64 id: sceneBuild.chunk.textures )
+    {
+      key.updateValue( id );
+      key.updateValue( textures.getContentHash( id ) );
+    }
+    return key.digest();
+  }
 
-    auto textures = intermediate::makeTextureCollection();
 
-    for( const auto& sceneInfo: scenesInfo.scenes )
-      for( const auto& obj: sceneInfo.objects )
-        if( obj.mesh )
-          textures->addTexture( obj.mesh->material_info.diffuse,
-                                obj.mesh->material_info.blend_mode );
+  u64 makeSharedChunkKey( const BuildContext& context, const intermediate::ITextureCollection& textures,
+                          const intermediate::SharedTextureChunk& shared )
+  {
+    auto key = intermediate::BuildCache::makeKey();
+    key.updateValue( context.meshCompressionLevel );
+    key.updateValue( context.textureCompressionLevel );
+    key.updateValue( context.dictionaries.meshId );
+    for( u64 id: shared.textures )
+    {
+      key.updateValue( id );
+      key.updateValue( textures.getContentHash( id ) );
+    }
+    return key.digest();
+  }
 
-    textures->process();
 
-    std::for_each(
-        std::execution::par, scenesInfo.scenes.begin(), scenesInfo.scenes.end(),
-        [&textures, useCompression]( const auto& sceneInfo ) {
-          // handle render chunk
-          {
-            auto chunk = core::data::schema::Chunk();
-            for( const auto& object: sceneInfo.objects )
+  core::data::schema::Mesh loadCachedMesh( const intermediate::BuildCache& cache, u64 key )
+  {
+    auto bytes = std::vector<byte>();
+    mFailIf( !cache.loadObject( key, bytes ) );
+
+    auto objectHandle = msgpack::unpack( reinterpret_cast<const char*>( bytes.data() ), bytes.size() );
+    auto mesh         = core::data::schema::Mesh();
+    objectHandle.get().convert( mesh );
+    return mesh;
+  }
+
+
+  void addMeshTask( BuildContext& context, SceneBuild& sceneBuild, intermediate::ObjectInfo& object )
+  {
+    using namespace intermediate;
+
+    // meshes don't depend on textures, so they run in parallel with input parsing and texture conversion.
+    // processed mesh is kept in cache by hash of its input, so untouched meshes are not processed again
+    auto task = [&object, &context, &key = sceneBuild.meshKeys.emplace_back(), &mesh = sceneBuild.meshes.emplace_back()]() {
+      auto& vertexData = object.mesh->vertex_data;
+
+      auto hasher = BuildCache::makeKey();
+      hasher.update( object.name.data(), object.name.size() );
+      hasher.update( vertexData.data(), vertexData.size() * sizeof( core::data::schema::VertexData ) );
+      key = hasher.digest();
+
+      if( !context.cache.hasObject( key ) )
+      {
+        mesh = processMesh( object.name, object.mesh.value() );
+
+        auto memoryWriter = intermediate::VectorWriter();
+        msgpack::pack( memoryWriter, *mesh );
+        context.cache.storeObject( key, memoryWriter.bytes );
+      }
+
+      if( context.samples )
+      {
+        auto bytes = std::vector<byte>();
+        mFailIf( !context.cache.loadObject( key, bytes ) );
+        context.samples->addMesh( bytes );
+      }
+
+      // rest of object is needed for scene, but its vertices are not
+      vertexData.clear();
+      vertexData.shrink_to_fit();
+    };
+
+    context.partitionDependencies.push_back( context.graph.add( BuildStage_Mesh, object.name, std::move( task ) ) );
+  }
+
+
+  // chunk contents are known only when all textures are converted and all meshes hashed.
+  // chunks which are up to date are skipped, others get write tasks added from here
+  void partitionRenderChunks( BuildContext& context )
+  {
+    using namespace intermediate;
+
+    auto& textures = context.textures;
+    textures->deduplicate();
+
+    for( auto& shared: textures->partition( context.scenesInfo ) )
+    {
+      auto& build = *context.sharedChunkBuilds.emplace_back( std::make_unique<ChunkBuild>( ChunkBuild{
+          .name = shared.name,
+          .key  = makeSharedChunkKey( context, *textures, shared ),
+      } ) );
+      context.sharedChunkScenes.emplace_back( std::move( shared.scenes ) );
+
+      if( context.samples )
+        continue;
+
+      if( context.cache.isUpToDate( getChunkPath( build.name ), build.key ) )
+      {
+        context.chunksUpToDate++;
+        continue;
+      }
+
+      build.textures = std::move( shared.textures );
+      addRenderChunkWrite( context, build, nullptr, {}, context.sharedChunksBytes );
+    }
+
+    for( size_t sceneIndex = 0; sceneIndex < context.sceneBuilds.size(); ++sceneIndex )
+    {
+      auto& sceneBuild          = context.sceneBuilds[sceneIndex];
+      sceneBuild.chunk.textures = textures->getPrivateTextures( context.scenesInfo.scenes[sceneIndex] );
+      sceneBuild.chunk.key      = makeSceneChunkKey( context, *textures, sceneBuild );
+
+      if( context.samples )
+        continue;
+
+      if( context.cache.isUpToDate( getChunkPath( sceneBuild.chunk.name ), sceneBuild.chunk.key ) )
+      {
+        context.chunksUpToDate++;
+        sceneBuild.meshes.clear();
+        continue;
+      }
+
+      addRenderChunkWrite(
+          context, sceneBuild.chunk,
+          [&sceneBuild, &context]() {
+            for( size_t i = 0; i < sceneBuild.meshes.size(); ++i )
             {
-              if( !object.mesh.has_value() )
-                continue;
-              auto& mesh = object.mesh.value();
-              intermediate::processMesh( object.name, mesh, chunk );
+              auto& mesh = sceneBuild.meshes[i];
+              sceneBuild.chunk.meshes.push_back(
+                  mesh ? std::move( *mesh ) : loadCachedMesh( context.cache, sceneBuild.meshKeys[i] ) );
             }
-            textures->resolve( sceneInfo, chunk );
-            writeRenderChunk( sceneInfo, chunk, useCompression );
-          }
+            sceneBuild.meshes.clear();
+          },
+          {}, context.sceneChunksBytes );
+    }
+  }
 
-          // handle scene
-          {
-            auto scene          = intermediate::processScene( sceneInfo );
-            scene.render_chunks = { StringId( sceneInfo.name + ".chunk" ) };
-            writeScene( sceneInfo, scene );
-          }
+
+  // parse task adds mesh tasks while reading, rest of the graph is added when whole input is read
+  void parseSceneInput( BuildContext& context, const char* path, intermediate::TaskId parse )
+  {
+    using namespace intermediate;
+
+    auto& textures = context.textures;
+
+    readSceneInput(
+        path, context.scenesInfo,
+        [&context]( SceneInfo& sceneInfo ) { context.sceneBuilds.emplace_back().chunk.name = sceneInfo.name; },
+        [&context, &textures]( ObjectInfo& object ) {
+          if( !object.mesh )
+            return;
+
+          textures->addTexture( object.mesh->material_info.diffuse, object.mesh->material_info.blend_mode );
+          addMeshTask( context, context.sceneBuilds.back(), object );
         } );
+    printf( "scene tool parsed input file...\n" );
+
+    // textures: decode -> convert, every texture on its own. up to date dds files are not decoded.
+    // blend mode of texture depends on all materials which use it, so they start after parsing
+    for( u64 id: textures->getTextureIds() )
+    {
+      const auto& name   = textures->getTexturePath( id );
+      auto        decode = context.graph.add( BuildStage_Decode, name, [&textures, id]() { textures->decode( id ); } );
+      context.partitionDependencies.push_back(
+          context.graph.add( BuildStage_DdsConvert, name, [&textures, id]() { textures->convert( id ); }, { decode } ) );
+    }
+
+    // this task is still running, so partition also waits for the end of parsing
+    context.partitionDependencies.push_back( parse );
+    auto partition = context.graph.add( BuildStage_Partition, "textures", [&context]() { partitionRenderChunks( context ); },
+                                        context.partitionDependencies );
+
+    for( const auto& sceneInfo: context.scenesInfo.scenes )
+    {
+      context.graph.add( BuildStage_Scene, sceneInfo.name, [&sceneInfo, &context]() {
+        auto scene = intermediate::processScene( sceneInfo, *context.textures );
+
+        for( size_t i = 0; i < context.sharedChunkScenes.size(); ++i )
+          if( std::ranges::contains( context.sharedChunkScenes[i], sceneInfo.name ) )
+            scene.render_chunks.push_back( StringId( context.sharedChunkBuilds[i]->name + ".chunk" ) );
+        scene.render_chunks.push_back( StringId( sceneInfo.name + ".chunk" ) );
+
+        writeScene( context, sceneInfo, scene );
+      },
+                         { partition } );
+    }
+  }
+
+
+  // runtime maps manifest instead of walking data directory, so it is written when all outputs are in place.
+  // manifest has ids, sizes and content hashes of all files, so its hash is key of everything in data directory.
+  // returns it
+  u64 writeManifest( BuildContext& context )
+  {
+    auto bytes    = std::vector<byte>();
+    auto hashFile = [&context]( const stdfs::path& path ) { return context.cache.hashFile( path ); };
+    mFailIf( core::data::buildManifest( core::data::getDataPath( "" ), bytes, hashFile ) != StatusOk );
+
+    auto key = intermediate::BuildCache::makeKey();
+    key.update( bytes );
+    u64 manifestKey = key.digest();
+
+    auto manifestPath = stdfs::path( core::data::getDataPath( core::data::sManifestName ) );
+    if( context.cache.isUpToDate( manifestPath, manifestKey ) )
+    {
+      printf( "data manifest is up to date\n" );
+      return manifestKey;
+    }
+
+    mFailIf( core::fs::writeFile( manifestPath.string(), bytes ) != StatusOk );
+    context.cache.markBuilt( manifestPath, manifestKey );
+    printf( "data manifest written (" mFmtSize " bytes)\n", bytes.size() );
+    return manifestKey;
+  }
+
+
+  // files go to pack in order of paths, so files of one scene directory are next to each other for readahead.
+  // pack is keyed by manifest, so it is rewritten only when some file in data directory changed
+  void writePack( BuildContext& context, u64 manifestKey )
+  {
+    auto packPath = stdfs::path( core::data::getDataPath( core::data::sPackName ) );
+    if( context.cache.isUpToDate( packPath, manifestKey ) )
+    {
+      printf( "data pack is up to date\n" );
+      return;
+    }
+
+    auto manifest = core::data::Manifest();
+    mFailIf( manifest.open( core::data::getDataPath( core::data::sManifestName ) ) != StatusOk );
+
+    auto sources = std::vector<core::fs::PackSource>();
+    sources.reserve( manifest.getEntryCount() );
+    for( const auto& entry: manifest.getEntries() )
+    {
+      auto name = std::string( manifest.getPath( entry ) );
+      sources.push_back( core::fs::PackSource{
+          .name = name,
+          .path = core::data::getDataPath( name ),
+      } );
+    }
+    std::ranges::sort( sources, {}, &core::fs::PackSource::name );
+
+    mFailIf( core::fs::writePack( packPath.string().c_str(), sources ) != StatusOk );
+    context.cache.markBuilt( packPath, manifestKey );
+    printf( "data pack written: " mFmtSize " files, " mFmtU64 " bytes\n", sources.size(),
+            static_cast<u64>( stdfs::file_size( packPath ) ) );
+  }
+
+
+  struct SceneToolOptions
+  {
+    // mesh data compresses well even on fast levels, textures are already block compressed
+    // and gain only from high levels, which are affordable with zstd workers
+    int  meshCompressionLevel    = 1;
+    int  textureCompressionLevel = 1;
+    bool trainDictionaries       = false;
+    bool writePack               = false;
+  };
+
+
+  // when samples are given, nothing is written, build only collects them
+  void buildScenes( const char* path, const SceneToolOptions& options, intermediate::DictionarySamples* samples )
+  {
+    using namespace intermediate;
+
+    auto context    = BuildContext();
+    context.samples = samples;
+
+    context.meshCompressionLevel    = options.meshCompressionLevel;
+    context.textureCompressionLevel = options.textureCompressionLevel;
+
+    TaskId parse = 0;
+    parse        = context.graph.add( BuildStage_Parse, path, [&context, path, &parse]() { parseSceneInput( context, path, parse ); } );
+
+    context.graph.run();
+    if( !samples )
+    {
+      u64 manifestKey = writeManifest( context );
+
+      // stale pack would shadow loose files which were just written. pack of the same files is kept
+      auto packPath = stdfs::path( core::data::getDataPath( core::data::sPackName ) );
+      if( options.writePack )
+        writePack( context, manifestKey );
+      else if( stdfs::exists( packPath ) && !context.cache.isUpToDate( packPath, manifestKey ) )
+        stdfs::remove( packPath );
+    }
+    context.cache.save();
+
+    if( samples )
+      return;
+
+    printf( "render chunks: " mFmtU64 " written, " mFmtU64 " up to date\n",
+            context.chunksWritten.load(), context.chunksUpToDate.load() );
+    printf( "scenes: " mFmtU64 " written, " mFmtU64 " up to date\n",
+            context.scenesWritten.load(), context.scenesUpToDate.load() );
+    printf( "render chunks written: " mFmtU64 " bytes total (shared: " mFmtU64 ", scenes: " mFmtU64 ")\n",
+            context.sharedChunksBytes + context.sceneChunksBytes,
+            context.sharedChunksBytes.load(), context.sceneChunksBytes.load() );
+    context.graph.printReport();
+  }
+
+
+  void runSceneTool( const char* path, const SceneToolOptions& options )
+  {
+    // dictionaries are part of build cache keys, so outputs are rebuilt with new ones by following build
+    if( options.trainDictionaries )
+    {
+      printf( "collecting dictionary samples...\n" );
+      auto samples = intermediate::DictionarySamples();
+      buildScenes( path, options, &samples );
+
+      intermediate::saveDictionaries(
+          intermediate::trainDictionaries( samples, options.meshCompressionLevel, sSceneCompressionLevel ) );
+    }
+
+    buildScenes( path, options, nullptr );
   }
 } // namespace
 
@@ -105,19 +572,38 @@ try
     return 1;
   }
 
-  if( argc != 2 && argc != 3 )
+  // scene-tool writes data, so it reads loose files only
+  core::fs::unmountPack();
+
+  if( argc < 2 )
   {
-    printf( "usage: scene-tool.exe [path-to-temp-scene]\n" );
+    printf( "usage: scene-tool.exe [path-to-temp-scene] [-compress] [-train-dicts] [-pack]\n" );
     return 1;
   }
 
-  bool useCompression = false;
-  if( argc == 3 && argv[2] == std::string_view( "-compress" ) )
-    useCompression = true;
+  auto options = SceneToolOptions();
+  for( int i = 2; i < argc; ++i )
+  {
+    if( argv[i] == std::string_view( "-compress" ) )
+    {
+      options.meshCompressionLevel    = 3;
+      options.textureCompressionLevel = 12;
+    }
+    else if( argv[i] == std::string_view( "-train-dicts" ) )
+      options.trainDictionaries = true;
+    else if( argv[i] == std::string_view( "-pack" ) )
+      options.writePack = true;
+    else
+    {
+      printf( "unknown option: %s\n", argv[i] );
+      return 1;
+    }
+  }
 
-  runSceneTool( argv[1], useCompression );
+  runSceneTool( argv[1], options );
 
   core::data::destroy();
+  core::system::memory::logReport();
   printf( "scene tool ended\n" );
   return 0;
 }
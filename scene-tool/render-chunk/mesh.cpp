@@ -27,9 +27,8 @@ namespace
 } // namespace
 
 
-void intermediate::processMesh( const std::string&            name,
-                                const intermediate::MeshInfo& meshInfo,
-                                core::data::schema::Chunk&    chunk )
+core::data::schema::Mesh intermediate::processMesh( const std::string&            name,
+                                                    const intermediate::MeshInfo& meshInfo )
 {
   auto id = StringId( name ); // TODO: incorrect if obj has more than 1 meshes
   printf( "processing mesh %s hash: " mFmtU64 "\n", name.c_str(), id.getHash() );
@@ -67,10 +66,9 @@ void intermediate::processMesh( const std::string&            name,
   meshopt_optimizeVertexCache( indices.data(), indices.data(),
                                indexCount, vertexCount );
 
-  auto outputMesh = core::data::schema::Mesh{
+  return core::data::schema::Mesh{
       .id           = id,
       .indexBuffer  = std::move( indices ),
       .vertexBuffer = std::move( vertices ),
   };
-  chunk.meshes.emplace_back( std::move( outputMesh ) );
 }
@@ -4,7 +4,6 @@
 
 namespace intermediate
 {
-  void processMesh( const std::string&            name,
-                    const intermediate::MeshInfo& meshInfo,
-                    core::data::schema::Chunk&    chunk );
+  core::data::schema::Mesh processMesh( const std::string&            name,
+                                        const intermediate::MeshInfo& meshInfo );
 }
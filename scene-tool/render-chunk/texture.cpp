@@ -1,6 +1,6 @@
 #include "render-chunk/texture.hpp"
 #include "scene-tool.hpp"
-#include "util/detect-changes.hpp"
+#include "util/build-cache.hpp"
 #include "core/core.hpp"
 #include <nvtt/nvtt.h>
 #include <DirectXTex.h>
@@ -14,10 +14,16 @@ namespace
   // all intermediate data stored here
   struct TmpTexture
   {
-    TextureInfo                 info;
-    core::render::BlendMode     blendMode;
-    std::string                 intermediatePath;
-    core::data::schema::Texture result;
+    TextureInfo                    info;
+    core::render::BlendMode        blendMode;
+    std::string                    intermediatePath;
+    u64                            ddsKey = 0; // source content and conversion options
+    std::unique_ptr<nvtt::Surface> image; // decoded source, only while it needs conversion
+    core::data::schema::Texture    result; // without mip data
+    u64                            contentHash = 0;
+    u64                            canonicalId = 0; // texture with same content, which goes to chunks
+    u64                            fileSize    = 0; // of intermediate dds
+    u64                            dataOffset  = 0; // of first mip in intermediate dds
   };
 
   bool operator==( const TextureInfo& a, const TextureInfo& b ) { return a.path == b.path; }
@@ -34,7 +40,7 @@ namespace
   }
 
 
-  void convertToDds( TmpTexture& texture )
+  void decodeImage( BuildCache& cache, TmpTexture& texture )
   {
     auto fullPath = getResourcePath( texture.info.path );
 
@@ -50,14 +56,29 @@ namespace
             fullPath.string().c_str(),
             texture.intermediatePath.c_str() );
 
-    auto changes = FileChanges( fullPath, texture.intermediatePath );
-    if( !changes.isChanged() )
+    auto key = BuildCache::makeKey();
+    key.updateValue( cache.hashFile( fullPath ) );
+    key.updateValue( texture.blendMode );
+    texture.ddsKey = key.digest();
+
+    if( cache.isUpToDate( texture.intermediatePath, texture.ddsKey ) )
+      return;
+
+    printf( "has changes, decoding...\n" );
+
+    texture.image = std::make_unique<nvtt::Surface>();
+    mFailIf( !texture.image->load( fullPath.string().c_str() ) );
+  }
+
+
+  void convertToDds( BuildCache& cache, TmpTexture& texture )
+  {
+    if( !texture.image )
       return;
 
-    printf( "has changes, converting...\n" );
+    printf( "converting %s...\n", texture.intermediatePath.c_str() );
 
-    nvtt::Surface image;
-    mFailIf( !image.load( fullPath.string().c_str() ) );
+    auto& image = *texture.image;
 
     const bool enableCuda         = true;
     auto       context            = nvtt::Context{ enableCuda };
@@ -139,7 +160,8 @@ namespace
       image.toSrgb();
     }
 
-    changes.markChanged();
+    cache.markBuilt( texture.intermediatePath, texture.ddsKey );
+    texture.image.reset();
   }
 
 
@@ -152,19 +174,19 @@ namespace
   }
 
 
-  void loadTexture( TmpTexture& texture )
-  {
-    printf( "loading texture %s...\n", texture.intermediatePath.c_str() );
+  constexpr u32 sDdsFourCcOffset   = 84; // magic, then DDS_HEADER::ddspf.dwFourCC
+  constexpr u32 sDdsDataOffset     = 128; // magic + DDS_HEADER
+  constexpr u32 sDdsDx10DataOffset = 148; // magic + DDS_HEADER + DDS_HEADER_DXT10
+  constexpr u32 sDdsFourCcDx10     = 0x30315844; // 'DX10'
 
-    auto bytes = std::vector<byte>();
-    if( core::fs::readFile( texture.intermediatePath.c_str(), bytes ) != StatusOk )
-    {
-      printf( "error: bad file: %s\n", texture.intermediatePath.c_str() );
-      abort();
-    }
+
+  // only metadata stays in memory, mip data is read from dds when chunk is serialized
+  void readTextureMetadata( TmpTexture& texture )
+  {
+    printf( "reading texture metadata %s...\n", texture.intermediatePath.c_str() );
 
     auto metaData = dx::TexMetadata();
-    mFailIfHr( dx::GetMetadataFromDDSMemory( bytes.data(), bytes.size(), dx::DDS_FLAGS_NONE, metaData ) );
+    mFailIfHr( dx::GetMetadataFromDDSFile( stdfs::path( texture.intermediatePath ).c_str(), dx::DDS_FLAGS_NONE, metaData ) );
 
     mNotImplementedIf( metaData.IsVolumemap() );
     mNotImplementedIf( metaData.IsCubemap() );
@@ -172,50 +194,93 @@ namespace
     mNotImplementedIf( metaData.dimension != DirectX::TEX_DIMENSION_TEXTURE2D );
     mNotImplementedIf( metaData.format == DXGI_FORMAT_UNKNOWN );
 
-    auto image = dx::ScratchImage();
-    mFailIfHr( dx::LoadFromDDSMemory( bytes.data(), bytes.size(), dx::DDS_FLAGS_NONE, &metaData, image ) );
+    auto file   = core::fs::File( texture.intermediatePath.c_str(), "rb" );
+    u32  fourCC = 0;
+    mFailIf( file.seek( core::fs::FileSeekDirectionBegin, sDdsFourCcOffset ) != StatusOk );
+    mFailIf( file.read( &fourCC, sizeof( fourCC ) ) != StatusOk );
 
+    texture.dataOffset  = fourCC == sDdsFourCcDx10 ? sDdsDx10DataOffset : sDdsDataOffset;
     texture.result.data = std::vector<core::data::schema::TextureData>( metaData.mipLevels * metaData.arraySize );
 
+    // subresources are stored one after another: every mip of first item, then next item
+    u64 dataSize = 0;
+    for( size_t item = 0; item < metaData.arraySize; ++item )
     {
-      const auto* srcImages = image.GetImages();
-      auto        numImages = image.GetImageCount();
-
-      size_t idx = 0;
-      for( size_t item = 0; item < metaData.arraySize; ++item )
+      for( size_t level = 0; level < metaData.mipLevels; ++level )
       {
-        for( size_t level = 0; level < metaData.mipLevels; ++level )
-        {
-          size_t index = metaData.ComputeIndex( level, item, 0 );
-          mFailIf( index >= numImages );
-
-          const auto& img = srcImages[index];
-
-          mFailIf( img.format != metaData.format );
-          mFailIf( !img.pixels );
-          mFailIf( idx >= ( metaData.mipLevels * metaData.arraySize ) );
-          mFailIf( !img.slicePitch );
-
-          texture.result.data[idx].mem           = { img.pixels, img.pixels + img.slicePitch };
-          texture.result.data[idx].memPitch      = static_cast<u32>( img.rowPitch );
-          texture.result.data[idx].memSlicePitch = static_cast<u32>( img.slicePitch );
-          ++idx;
-        }
+        size_t rowPitch   = 0;
+        size_t slicePitch = 0;
+        mFailIfHr( dx::ComputePitch( metaData.format,
+                                     std::max<size_t>( metaData.width >> level, 1 ),
+                                     std::max<size_t>( metaData.height >> level, 1 ),
+                                     rowPitch, slicePitch ) );
+
+        auto& data         = texture.result.data[metaData.ComputeIndex( level, item, 0 )];
+        data.memPitch      = static_cast<u32>( rowPitch );
+        data.memSlicePitch = static_cast<u32>( slicePitch );
+        dataSize += slicePitch;
       }
     }
 
+    // legacy formats are converted by DirectXTex on load, their bytes can't be copied as is
+    if( texture.dataOffset + dataSize != file.getSize() )
+    {
+      printf( "error: unexpected dds layout (legacy format?): %s\n", texture.intermediatePath.c_str() );
+      abort();
+    }
+
     texture.result.width     = static_cast<u32>( metaData.width );
     texture.result.height    = static_cast<u32>( metaData.height );
     texture.result.mipLevels = static_cast<u32>( metaData.mipLevels );
     texture.result.arraySize = static_cast<u32>( metaData.arraySize );
     texture.result.format    = static_cast<u32>( metaData.format );
   }
+
+
+  // same layout as msgpack of core::data::schema::Texture, but mip data goes from file straight to writer
+  void packTexture( const TmpTexture& texture, ChunkWriter& writer, std::vector<byte>& buffer )
+  {
+    printf( "packing texture %s...\n", texture.intermediatePath.c_str() );
+
+    const auto& result = texture.result;
+    auto        packer = msgpack::packer<ChunkWriter>( writer );
+    auto        file   = core::fs::File( texture.intermediatePath.c_str(), "rb" );
+    mFailIf( file.seek( core::fs::FileSeekDirectionBegin, static_cast<long>( texture.dataOffset ) ) != StatusOk );
+
+    packer.pack_array( 7 );
+    packer.pack( result.id );
+    packer.pack( result.width );
+    packer.pack( result.height );
+    packer.pack( result.mipLevels );
+    packer.pack( result.arraySize );
+    packer.pack( result.format );
+
+    packer.pack_array( static_cast<u32>( result.data.size() ) );
+    for( const auto& data: result.data )
+    {
+      packer.pack_array( 3 );
+      packer.pack( data.memPitch );
+      packer.pack( data.memSlicePitch );
+      packer.pack_bin( data.memSlicePitch );
+
+      buffer.resize( data.memSlicePitch );
+      mFailIf( file.read( buffer.data(), buffer.size() ) != StatusOk );
+      writer.write( buffer );
+    }
+  }
 } // namespace
 
 
 struct TextureCollection : public ITextureCollection
 {
+  BuildCache&               cache_;
   std::map<u64, TmpTexture> textures_;
+  std::set<u64>             sharedTextures_; // canonical ids
+
+  explicit TextureCollection( BuildCache& cache )
+      : cache_( cache )
+  {
+  }
 
   ~TextureCollection() override = default;
 
@@ -250,24 +315,142 @@ struct TextureCollection : public ITextureCollection
   }
 
 
-  void process() override
+  std::vector<u64> getTextureIds() const override
+  {
+    return textures_ | std::views::keys | std::ranges::to<std::vector>();
+  }
+
+
+  const std::string& getTexturePath( u64 id ) const override
+  {
+    return textures_.at( id ).info.path;
+  }
+
+
+  // nvtt
+  void decode( u64 id ) override { decodeImage( cache_, textures_.at( id ) ); }
+  // TODO: pass usage (check material settings)
+  void convert( u64 id ) override
+  {
+    auto& texture = textures_.at( id );
+    convertToDds( cache_, texture );
+    readTextureMetadata( texture );
+  }
+
+
+  void deduplicate() override
   {
-    // 1. convert textures (nvtt)
-    for( auto& [_, texture]: textures_ )
+    // same images under different paths are stored once, dds files are compared without loading them
+    auto contentToId = std::map<u64, u64>();
+    for( auto& [id, texture]: textures_ )
     {
-      // TODO: pass usage (check material settings)
-      convertToDds( texture );
+      texture.contentHash = cache_.hashFile( texture.intermediatePath );
+      texture.fileSize    = stdfs::file_size( texture.intermediatePath );
+
+      auto [it, inserted] = contentToId.emplace( texture.contentHash, id );
+      texture.canonicalId = it->second;
+
+      if( !inserted )
+        printf( "texture %s has same content as " mFmtU64 "\n", texture.info.path.c_str(), texture.canonicalId );
     }
+  }
 
-    // 2. load all textures in memory (DirectXTexSimpl)
-    for( auto& [_, texture]: textures_ )
+
+  std::vector<SharedTextureChunk> partition( const ScenesInfo& scenesInfo ) override
+  {
+    // canonical texture id -> indices of scenes which use it
+    auto usage = std::map<u64, std::vector<size_t>>();
+    for( size_t i = 0; i < scenesInfo.scenes.size(); ++i )
+      for( u64 id: getSceneTextures( scenesInfo.scenes[i] ) )
+        usage[id].push_back( i );
+
+    // textures used by the same scenes go to the same chunk
+    auto groups = std::map<std::vector<size_t>, std::vector<u64>>();
+    for( auto& [id, scenes]: usage )
+      if( scenes.size() > 1 )
+        groups[scenes].push_back( id );
+
+    auto result      = std::vector<SharedTextureChunk>();
+    u64  copiedBytes = 0; // as if every scene embeds its textures
+    u64  sharedBytes = 0;
+
+    for( auto& [id, scenes]: usage )
+      copiedBytes += textures_.at( id ).fileSize * scenes.size();
+
+    for( auto& [scenes, ids]: groups )
     {
-      loadTexture( texture );
+      auto hasher = core::Hasher64();
+      auto shared = SharedTextureChunk();
+
+      for( size_t sceneIndex: scenes )
+      {
+        const auto& sceneName = scenesInfo.scenes[sceneIndex].name;
+        hasher.update( sceneName.data(), sceneName.size() );
+        shared.scenes.push_back( sceneName );
+      }
+
+      char name[32];
+      snprintf( name, sizeof( name ), "shared-%016" PRIx64, hasher.digest() );
+      shared.name = ( stdfs::path( shared.scenes.front() ).parent_path() / name ).generic_string();
+
+      for( u64 id: ids )
+      {
+        sharedBytes += textures_.at( id ).fileSize;
+        shared.textures.push_back( id );
+        sharedTextures_.insert( id );
+      }
+
+      printf( "shared chunk %s: %zu textures, used by %zu scenes\n", shared.name.c_str(), ids.size(), scenes.size() );
+      result.emplace_back( std::move( shared ) );
     }
+
+    u64 dedupedBytes = 0;
+    for( auto& [id, scenes]: usage )
+      dedupedBytes += textures_.at( id ).fileSize * ( sharedTextures_.contains( id ) ? 1 : scenes.size() );
+
+    printf( "textures: " mFmtU64 " paths, " mFmtU64 " unique, " mFmtU64 " shared (" mFmtU64 " bytes)\n",
+            static_cast<u64>( textures_.size() ), static_cast<u64>( usage.size() ),
+            static_cast<u64>( sharedTextures_.size() ), sharedBytes );
+    printf( "texture bytes: " mFmtU64 " with per scene copies, " mFmtU64 " with shared chunks\n",
+            copiedBytes, dedupedBytes );
+
+    return result;
+  }
+
+
+  u64 getTextureId( const TextureInfo& textureInfo ) const override
+  {
+    return textures_.at( textureHash( textureInfo ) ).canonicalId;
+  }
+
+
+  u64 getContentHash( u64 id ) const override
+  {
+    return textures_.at( id ).contentHash;
   }
 
 
-  void resolve( const SceneInfo& sceneInfo, core::data::schema::Chunk& outputChunk ) const override
+  std::vector<u64> getPrivateTextures( const SceneInfo& sceneInfo ) const override
+  {
+    return getSceneTextures( sceneInfo ) |
+           std::ranges::views::filter( [this]( u64 id ) { return !sharedTextures_.contains( id ); } ) |
+           std::ranges::to<std::vector>();
+  }
+
+
+  void packTextures( std::span<const u64> ids, ChunkWriter& writer ) const override
+  {
+    auto packer = msgpack::packer<ChunkWriter>( writer );
+    packer.pack_array( static_cast<u32>( ids.size() ) );
+
+    auto buffer = std::vector<byte>(); // one mip at a time
+    for( u64 textureId: ids )
+      packTexture( textures_.at( textureId ), writer, buffer );
+  }
+
+
+  // canonical ids of textures used by scene materials
+  std::set<u64> getSceneTextures( const SceneInfo& sceneInfo ) const
   {
     auto materials = sceneInfo.objects |
                      std::ranges::views::filter( []( const ObjectInfo& o ) { return o.mesh.has_value(); } ) |
@@ -278,20 +461,14 @@ struct TextureCollection : public ITextureCollection
         materials, []( const MaterialInfo& a, const MaterialInfo& b ) { return a.name == b.name; } );
     materials.erase( eraseMaterials.begin(), eraseMaterials.end() );
 
-    auto diffuseTextures = materials |
-                           std::ranges::views::transform( []( const MaterialInfo& m ) { return textureHash( m.diffuse ); } ) |
-                           std::ranges::to<std::set>();
-
-    for( auto textureId: diffuseTextures )
-    {
-      printf( "add image to render chunk: " mFmtU64 "\n", textureId );
-      outputChunk.textures.push_back( textures_.at( textureId ).result );
-    }
+    return materials |
+           std::ranges::views::transform( [this]( const MaterialInfo& m ) { return getTextureId( m.diffuse ); } ) |
+           std::ranges::to<std::set>();
   }
 };
 
 
-std::unique_ptr<ITextureCollection> intermediate::makeTextureCollection()
+std::unique_ptr<ITextureCollection> intermediate::makeTextureCollection( BuildCache& cache )
 {
-  return std::make_unique<TextureCollection>();
+  return std::make_unique<TextureCollection>( cache );
 }
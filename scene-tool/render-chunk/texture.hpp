@@ -4,6 +4,8 @@
 
 namespace intermediate
 {
+  class BuildCache;
+
   inline u64 textureHash( const TextureInfo& textureInfo )
   {
     auto path = stdfs::path( textureInfo.path ).lexically_normal().replace_extension( "" ).generic_string();
@@ -12,17 +14,43 @@ namespace intermediate
     return hash;
   }
 
+  // textures which are used by the same set of scenes
+  struct SharedTextureChunk
+  {
+    std::string              name; // relative path, without extension
+    std::vector<std::string> scenes;
+    std::vector<u64>         textures;
+  };
+
   struct ITextureCollection
   {
     virtual ~ITextureCollection() = default;
 
-    // once per process
+    // once per process, before build tasks are started
     virtual void addTexture( const TextureInfo& textureInfo, const std::string& imageUsage ) = 0;
-    virtual void process()                                                                   = 0;
+    virtual auto getTextureIds() const -> std::vector<u64>                                   = 0;
+    virtual auto getTexturePath( u64 id ) const -> const std::string&                        = 0;
+
+    // per texture build stages, different textures can be processed in parallel
+    virtual void decode( u64 id )  = 0; // reads source image, if intermediate dds is outdated
+    virtual void convert( u64 id ) = 0; // compresses decoded image to intermediate dds, reads its metadata
+
+    // after all textures are converted
+    virtual void deduplicate() = 0;
+
+    // moves textures used by more than one scene out of scene chunks
+    virtual auto partition( const ScenesInfo& scenesInfo ) -> std::vector<SharedTextureChunk> = 0;
+
+    // textures with same content are written once, under id of one of them
+    virtual u64 getTextureId( const TextureInfo& textureInfo ) const = 0;
+    virtual u64 getContentHash( u64 id ) const                       = 0;
+
+    // per scene, only textures which are not shared
+    virtual auto getPrivateTextures( const SceneInfo& sceneInfo ) const -> std::vector<u64> = 0;
 
-    // per scene
-    virtual void resolve( const SceneInfo& sceneInfo, core::data::schema::Chunk& outputChunk ) const = 0;
+    // packs array of core::data::schema::Texture, mip data is read from dds files straight into writer
+    virtual void packTextures( std::span<const u64> ids, ChunkWriter& writer ) const = 0;
   };
 
-  std::unique_ptr<ITextureCollection> makeTextureCollection();
+  std::unique_ptr<ITextureCollection> makeTextureCollection( BuildCache& cache );
 } // namespace intermediate
@@ -12,10 +12,7 @@ namespace
   template<typename TComponent>
   core::data::ShComponent fromProps( typename TComponent::Props props = {} )
   {
-    return core::data::ShComponent{
-        .type = TComponent::getComponentId(),
-        .data = Json( props ),
-    };
+    return core::data::makeShComponent<TComponent>( props );
   }
 } // namespace
 
@@ -33,7 +30,7 @@ core::data::ShComponent automatic::material( Entity& entity )
 {
   auto& material = entity.objectInfo->mesh->material_info;
   return fromProps<core::logic::MaterialComponent>( {
-      .textureDiffuseId = textureHash( material.diffuse ),
+      .textureDiffuseId = entity.scene->textures->getTextureId( material.diffuse ),
       .blendMode        = parseBlendMode( material.blend_mode ),
   } );
 }
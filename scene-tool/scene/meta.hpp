@@ -4,6 +4,11 @@
 
 // NOTE: this is some kind of builder interface for entity components setup
 
+namespace intermediate
+{
+  struct ITextureCollection;
+}
+
 namespace intermediate::meta
 {
   struct Scene;
@@ -25,10 +30,7 @@ namespace intermediate::meta
     template<typename TComponent>
     Entity& addComponent( typename TComponent::Props props = {} )
     {
-      return addComponent( core::data::ShComponent{
-          .type = TComponent::getComponentId(),
-          .data = Json( props ),
-      } );
+      return addComponent( core::data::makeShComponent<TComponent>( props ) );
     }
 
     auto serialize() const -> core::data::ShObjectInfo;
@@ -36,7 +38,8 @@ namespace intermediate::meta
 
   struct Scene
   {
-    std::vector<Entity> entities;
+    std::vector<Entity>       entities;
+    const ITextureCollection* textures = nullptr;
 
     Entity& getEntity( std::string name );
     Entity& addEntity( const intermediate::ObjectInfo* objectInfo );
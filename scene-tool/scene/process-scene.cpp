@@ -78,9 +78,10 @@ namespace
 } // namespace
 
 
-core::data::ShSceneInfo intermediate::processScene( const SceneInfo& sceneInfo )
+core::data::ShSceneInfo intermediate::processScene( const SceneInfo& sceneInfo, const ITextureCollection& textures )
 {
-  auto scene = meta::Scene();
+  auto scene     = meta::Scene();
+  scene.textures = &textures;
 
   for( const auto& obj: sceneInfo.objects )
   {
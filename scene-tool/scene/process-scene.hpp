@@ -4,5 +4,7 @@
 
 namespace intermediate
 {
-  core::data::ShSceneInfo processScene( const SceneInfo& sceneInfo );
+  struct ITextureCollection;
+
+  core::data::ShSceneInfo processScene( const SceneInfo& sceneInfo, const ITextureCollection& textures );
 }
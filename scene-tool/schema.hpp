@@ -25,6 +25,7 @@ namespace intermediate
   };
 
   using MsgPackWriter = VectorWriter;
+  using ChunkWriter   = core::fs::CompressedFileWriter; // render chunks are packed straight to compressed file
 } // namespace intermediate
 
 
@@ -0,0 +1,216 @@
+#include "util/build-cache.hpp"
+#include "scene-tool.hpp"
+
+using namespace intermediate;
+
+
+namespace
+{
+  struct FileRecord
+  {
+    u64 size  = 0;
+    s64 mtime = 0;
+    u64 hash  = 0;
+
+    NLOHMANN_DEFINE_TYPE_INTRUSIVE( FileRecord, size, mtime, hash );
+  };
+
+  struct OutputRecord
+  {
+    u64 key   = 0;
+    u64 size  = 0;
+    s64 mtime = 0;
+
+    NLOHMANN_DEFINE_TYPE_INTRUSIVE( OutputRecord, key, size, mtime );
+  };
+
+  struct Fingerprint
+  {
+    u64 size  = 0;
+    s64 mtime = 0;
+  };
+
+
+  bool getFingerprint( const stdfs::path& path, Fingerprint& out )
+  {
+    auto ec   = std::error_code();
+    auto size = stdfs::file_size( path, ec );
+    if( ec )
+      return false;
+
+    auto time = stdfs::last_write_time( path, ec );
+    if( ec )
+      return false;
+
+    out.size  = static_cast<u64>( size );
+    out.mtime = static_cast<s64>( time.time_since_epoch().count() );
+    return true;
+  }
+
+  std::string getObjectName( u64 key )
+  {
+    char name[32];
+    snprintf( name, sizeof( name ), "%016" PRIx64, key );
+    return name;
+  }
+} // namespace
+
+
+namespace intermediate
+{
+  struct BuildCacheData
+  {
+    std::mutex                          mutex;
+    stdfs::path                         directory;
+    std::map<std::string, FileRecord>   files;
+    std::map<std::string, OutputRecord> outputs;
+    bool                                dirty = false;
+
+    // stats
+    std::atomic<u64> hashedBytes   = 0;
+    std::atomic<u32> hashedFiles   = 0;
+    std::atomic<u32> fastPathFiles = 0;
+    std::atomic<u32> upToDate      = 0;
+    std::atomic<u32> rebuilt       = 0;
+    std::atomic<u32> tmpCounter    = 0;
+
+    stdfs::path getIndexPath() const { return directory / "index.json"; }
+    stdfs::path getObjectPath( u64 key ) const { return directory / "objects" / getObjectName( key ); }
+  };
+} // namespace intermediate
+
+
+BuildCache::BuildCache( const stdfs::path& directory )
+    : data_( new BuildCacheData() )
+{
+  data_->directory = directory;
+  stdfs::create_directories( directory / "objects" );
+
+  auto indexPath = data_->getIndexPath().string();
+  if( !stdfs::exists( indexPath ) )
+  {
+    printf( "build cache: no index, everything will be rebuilt\n" );
+    return;
+  }
+
+  auto index = Json();
+  mFailIf( core::fs::readFileJson( indexPath, index ) != StatusOk );
+
+  if( index.value( "version", u64( 0 ) ) != sSceneToolVersion )
+  {
+    printf( "build cache: created by other version of tool, everything will be rebuilt\n" );
+    return;
+  }
+
+  index.at( "files" ).get_to( data_->files );
+  index.at( "outputs" ).get_to( data_->outputs );
+  printf( "build cache: " mFmtU64 " files, " mFmtU64 " outputs\n",
+          static_cast<u64>( data_->files.size() ), static_cast<u64>( data_->outputs.size() ) );
+}
+
+BuildCache::~BuildCache()
+{
+  delete data_;
+}
+
+u64 BuildCache::hashFile( const stdfs::path& path )
+{
+  auto fingerprint = Fingerprint();
+  mFailIf( !getFingerprint( path, fingerprint ) );
+
+  auto name = path.generic_string();
+  {
+    auto lock = std::lock_guard( data_->mutex );
+    if( auto it = data_->files.find( name );
+        it != data_->files.end() && it->second.size == fingerprint.size && it->second.mtime == fingerprint.mtime )
+    {
+      data_->fastPathFiles++;
+      return it->second.hash;
+    }
+  }
+
+  auto bytes = std::vector<byte>();
+  mFailIf( core::fs::readFile( name, bytes ) != StatusOk );
+  u64 hash = core::hash64( bytes );
+
+  data_->hashedFiles++;
+  data_->hashedBytes += bytes.size();
+
+  auto lock          = std::lock_guard( data_->mutex );
+  data_->files[name] = FileRecord{ .size = fingerprint.size, .mtime = fingerprint.mtime, .hash = hash };
+  data_->dirty       = true;
+  return hash;
+}
+
+bool BuildCache::isUpToDate( const stdfs::path& output, u64 key )
+{
+  auto fingerprint = Fingerprint();
+  if( !getFingerprint( output, fingerprint ) )
+    return false;
+
+  auto lock = std::lock_guard( data_->mutex );
+  auto it   = data_->outputs.find( output.generic_string() );
+
+  bool upToDate = it != data_->outputs.end() &&
+                  it->second.key == key &&
+                  it->second.size == fingerprint.size &&
+                  it->second.mtime == fingerprint.mtime;
+  if( upToDate )
+    data_->upToDate++;
+  return upToDate;
+}
+
+void BuildCache::markBuilt( const stdfs::path& output, u64 key )
+{
+  auto fingerprint = Fingerprint();
+  mFailIf( !getFingerprint( output, fingerprint ) );
+
+  auto lock   = std::lock_guard( data_->mutex );
+  auto record = OutputRecord{ .key = key, .size = fingerprint.size, .mtime = fingerprint.mtime };
+
+  data_->outputs[output.generic_string()] = record;
+  data_->dirty                            = true;
+  data_->rebuilt++;
+}
+
+bool BuildCache::hasObject( u64 key ) const
+{
+  return stdfs::exists( data_->getObjectPath( key ) );
+}
+
+bool BuildCache::loadObject( u64 key, std::vector<byte>& out ) const
+{
+  auto path = data_->getObjectPath( key ).string();
+  return stdfs::exists( path ) && core::fs::readFile( path, out ) == StatusOk;
+}
+
+void BuildCache::storeObject( u64 key, std::span<const byte> bytes )
+{
+  // write to temporary name first, so interrupted run doesn't leave broken object.
+  // same object can be stored from different tasks at once, so temporary names are unique
+  auto path    = data_->getObjectPath( key );
+  auto tmpPath = path;
+  tmpPath += "." + std::to_string( data_->tmpCounter++ ) + ".tmp";
+
+  mFailIf( core::fs::writeFile( tmpPath.string(), bytes ) != StatusOk );
+  stdfs::rename( tmpPath, path );
+}
+
+void BuildCache::save()
+{
+  printf( "build cache: hashed " mFmtU32 " files (" mFmtU64 " bytes), " mFmtU32 " unchanged by size and time, "
+          mFmtU32 " outputs up to date, " mFmtU32 " rebuilt\n",
+          data_->hashedFiles.load(), data_->hashedBytes.load(), data_->fastPathFiles.load(),
+          data_->upToDate.load(), data_->rebuilt.load() );
+
+  if( !data_->dirty )
+    return;
+
+  auto index = Json{
+      { "version", sSceneToolVersion },
+      { "files", data_->files },
+      { "outputs", data_->outputs },
+  };
+  mFailIf( core::fs::writeFileJson( data_->getIndexPath().string(), index ) != StatusOk );
+  data_->dirty = false;
+}
@@ -0,0 +1,40 @@
+#pragma once
+#include "core/core.hpp"
+
+namespace intermediate
+{
+  // bump when processing of any output changes, so everything cached is rebuilt
+  constexpr u64 sSceneToolVersion = 2;
+
+  // content addressed build cache, stored in data directory.
+  // files are identified by xxh64 of their content. hash is remembered together with size and
+  // modification time, so files which were not touched are not read again
+  class BuildCache
+  {
+    struct BuildCacheData* data_;
+
+  public:
+    explicit BuildCache( const stdfs::path& directory );
+    ~BuildCache();
+
+    BuildCache( const BuildCache& )            = delete;
+    BuildCache& operator=( const BuildCache& ) = delete;
+
+    // feed it with all inputs and options of output
+    static core::Hasher64 makeKey() { return core::Hasher64( sSceneToolVersion ); }
+
+    u64 hashFile( const stdfs::path& path );
+
+    // output exists, was not touched since markBuilt and was built with the same key
+    bool isUpToDate( const stdfs::path& output, u64 key );
+    void markBuilt( const stdfs::path& output, u64 key );
+
+    // blobs addressed by key, for intermediate results which have no file of their own
+    bool hasObject( u64 key ) const;
+    bool loadObject( u64 key, std::vector<byte>& out ) const;
+    void storeObject( u64 key, std::span<const byte> bytes );
+
+    // writes cache index only if something changed
+    void save();
+  };
+} // namespace intermediate
@@ -0,0 +1,193 @@
+#include "util/dictionaries.hpp"
+#include "scene-tool.hpp"
+#include "schema.hpp"
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdocumentation-unknown-command"
+#include <zstd.h>
+#include <zdict.h>
+#pragma GCC diagnostic pop
+
+using namespace intermediate;
+
+
+namespace
+{
+  constexpr size_t sDictionaryCapacity = 112 * 1024;
+  constexpr size_t sMaxSampleBytes     = 128 * 1024;       // only beginning of big blobs, dictionary matters for small ones
+  constexpr u64    sMaxSamplesBytes    = 64 * 1024 * 1024; // per class, training time grows with it
+
+  using Clock = std::chrono::steady_clock;
+
+
+  void addSample( std::vector<std::vector<byte>>& samples, u64& totalBytes, std::span<const byte> sample )
+  {
+    sample = sample.first( std::min( sample.size(), sMaxSampleBytes ) );
+    if( sample.empty() || totalBytes + sample.size() > sMaxSamplesBytes )
+      return;
+
+    samples.emplace_back( sample.begin(), sample.end() );
+    totalBytes += sample.size();
+  }
+
+
+  f64 getMs( Clock::time_point start )
+  {
+    return std::chrono::duration<f64, std::milli>( Clock::now() - start ).count();
+  }
+
+
+  // every sample is compressed on its own, as blobs are compressed in build
+  void reportDictionary( const char* name, const std::vector<std::vector<byte>>& samples,
+                         std::span<const byte> dictionary, int level )
+  {
+    auto* cctx  = ZSTD_createCCtx();
+    auto* dctx  = ZSTD_createDCtx();
+    auto* ddict = ZSTD_createDDict( dictionary.data(), dictionary.size() );
+
+    u64 sourceBytes = 0;
+    u64 plainBytes  = 0;
+    u64 dictBytes   = 0;
+    f64 plainMs     = 0;
+    f64 dictMs      = 0;
+
+    auto compressed = std::vector<byte>();
+    auto output     = std::vector<byte>();
+
+    for( const auto& sample: samples )
+    {
+      sourceBytes += sample.size();
+      compressed.resize( ZSTD_compressBound( sample.size() ) );
+      output.resize( sample.size() );
+
+      size_t plainSize = ZSTD_compressCCtx( cctx, compressed.data(), compressed.size(), sample.data(), sample.size(), level );
+      mFailIf( ZSTD_isError( plainSize ) );
+      plainBytes += plainSize;
+
+      auto start = Clock::now();
+      mFailIf( ZSTD_decompressDCtx( dctx, output.data(), output.size(), compressed.data(), plainSize ) != sample.size() );
+      plainMs += getMs( start );
+
+      size_t dictSize = ZSTD_compress_usingDict( cctx, compressed.data(), compressed.size(), sample.data(), sample.size(),
+                                                 dictionary.data(), dictionary.size(), level );
+      mFailIf( ZSTD_isError( dictSize ) );
+      dictBytes += dictSize;
+
+      start = Clock::now();
+      mFailIf( ZSTD_decompress_usingDDict( dctx, output.data(), output.size(), compressed.data(), dictSize, ddict ) != sample.size() );
+      dictMs += getMs( start );
+    }
+
+    auto megabytesPerSecond = [sourceBytes]( f64 ms ) {
+      return ms > 0 ? static_cast<f64>( sourceBytes ) / ( 1024.0 * 1024.0 ) / ( ms / 1000.0 ) : 0.0;
+    };
+
+    printf( "dictionary %s: " mFmtU64 " samples, " mFmtU64 " bytes, level %d\n",
+            name, static_cast<u64>( samples.size() ), sourceBytes, level );
+    printf( "  without dictionary: ratio %.2f, decompression %.0f MiB/s\n",
+            static_cast<f64>( sourceBytes ) / static_cast<f64>( std::max<u64>( plainBytes, 1 ) ), megabytesPerSecond( plainMs ) );
+    printf( "  with dictionary:    ratio %.2f, decompression %.0f MiB/s\n",
+            static_cast<f64>( sourceBytes ) / static_cast<f64>( std::max<u64>( dictBytes, 1 ) ), megabytesPerSecond( dictMs ) );
+
+    ZSTD_freeDDict( ddict );
+    ZSTD_freeDCtx( dctx );
+    ZSTD_freeCCtx( cctx );
+  }
+
+
+  std::vector<byte> train( const char* name, const std::vector<std::vector<byte>>& samples, int level )
+  {
+    auto buffer = std::vector<byte>();
+    auto sizes  = std::vector<size_t>();
+    for( const auto& sample: samples )
+    {
+      buffer.append_range( sample );
+      sizes.push_back( sample.size() );
+    }
+
+    auto   dictionary = std::vector<byte>( sDictionaryCapacity );
+    size_t size       = ZDICT_trainFromBuffer( dictionary.data(), dictionary.size(), buffer.data(), sizes.data(),
+                                               static_cast<unsigned>( sizes.size() ) );
+
+    // too few or too uniform samples, blobs of this class go without dictionary
+    if( ZDICT_isError( size ) )
+    {
+      printf( "dictionary %s is not trained: %s\n", name, ZDICT_getErrorName( size ) );
+      return {};
+    }
+
+    dictionary.resize( size );
+    reportDictionary( name, samples, dictionary, level );
+    return dictionary;
+  }
+
+
+  u32 getId( const std::vector<byte>& dictionary )
+  {
+    return dictionary.empty() ? 0 : ZDICT_getDictID( dictionary.data(), dictionary.size() );
+  }
+} // namespace
+
+
+void DictionarySamples::addMesh( std::span<const byte> sample )
+{
+  auto lock = std::lock_guard( mutex_ );
+  addSample( mesh_, meshBytes_, sample );
+}
+
+void DictionarySamples::addScene( std::span<const byte> sample )
+{
+  auto lock = std::lock_guard( mutex_ );
+  addSample( scene_, sceneBytes_, sample );
+}
+
+
+Dictionaries intermediate::loadDictionaries()
+{
+  auto path         = core::data::getDataPath( core::data::sCompressionDictionariesName );
+  auto dictionaries = Dictionaries();
+  if( !stdfs::exists( path ) )
+    return dictionaries;
+
+  auto object       = msgpack::object();
+  auto objectHandle = msgpack::object_handle();
+  mFailIf( core::fs::readFileMsgpack( path, object, objectHandle ) != StatusOk );
+
+  auto named = std::map<std::string, std::vector<byte>>();
+  object.convert( named );
+  dictionaries.mesh    = std::move( named["mesh"] );
+  dictionaries.scene   = std::move( named["scene"] );
+  dictionaries.meshId  = getId( dictionaries.mesh );
+  dictionaries.sceneId = getId( dictionaries.scene );
+
+  printf( "dictionaries: mesh %u, scene %u\n", dictionaries.meshId, dictionaries.sceneId );
+  return dictionaries;
+}
+
+
+void intermediate::saveDictionaries( const Dictionaries& dictionaries )
+{
+  auto named = std::map<std::string, std::vector<byte>>();
+  if( !dictionaries.mesh.empty() )
+    named["mesh"] = dictionaries.mesh;
+  if( !dictionaries.scene.empty() )
+    named["scene"] = dictionaries.scene;
+
+  auto memoryWriter = VectorWriter();
+  msgpack::pack( memoryWriter, named );
+
+  auto path = core::data::getDataPath( core::data::sCompressionDictionariesName );
+  printf( "writing dictionaries %s...\n", path.c_str() );
+  mFailIf( core::fs::writeFile( path, memoryWriter.bytes ) != StatusOk );
+}
+
+
+Dictionaries intermediate::trainDictionaries( const DictionarySamples& samples, int meshLevel, int sceneLevel )
+{
+  auto dictionaries    = Dictionaries();
+  dictionaries.mesh    = train( "mesh", samples.mesh_, meshLevel );
+  dictionaries.scene   = train( "scene", samples.scene_, sceneLevel );
+  dictionaries.meshId  = getId( dictionaries.mesh );
+  dictionaries.sceneId = getId( dictionaries.scene );
+  return dictionaries;
+}
@@ -0,0 +1,37 @@
+#pragma once
+#include "core/core.hpp"
+
+namespace intermediate
+{
+  // zstd dictionaries for classes of small blobs, trained over whole export.
+  // runtime loads them from the same file and decompresses with them by dictionary id
+  struct Dictionaries
+  {
+    std::vector<byte> mesh;  // for mesh frames of render chunks
+    std::vector<byte> scene; // for scene jsons
+    u32               meshId  = 0; // 0 if there is no dictionary
+    u32               sceneId = 0;
+  };
+
+  // gathered by build tasks, when dictionaries are being trained
+  class DictionarySamples
+  {
+    std::mutex                     mutex_;
+    std::vector<std::vector<byte>> mesh_;
+    std::vector<std::vector<byte>> scene_;
+    u64                            meshBytes_  = 0;
+    u64                            sceneBytes_ = 0;
+
+  public:
+    void addMesh( std::span<const byte> sample );
+    void addScene( std::span<const byte> sample );
+
+    friend Dictionaries trainDictionaries( const DictionarySamples& samples, int meshLevel, int sceneLevel );
+  };
+
+  Dictionaries loadDictionaries(); // empty if they were not trained
+  void         saveDictionaries( const Dictionaries& dictionaries );
+
+  // prints compression ratio and decompression speed of samples with and without dictionaries
+  Dictionaries trainDictionaries( const DictionarySamples& samples, int meshLevel, int sceneLevel );
+} // namespace intermediate
@@ -0,0 +1,96 @@
+#include "util/msgpack-stream.hpp"
+#include "scene-tool.hpp"
+
+using namespace intermediate;
+
+
+namespace
+{
+  constexpr size_t sReadChunkSize = 1024 * 1024;
+
+  u32 readBigEndian( const char* data, u32 size )
+  {
+    u32 value = 0;
+    for( u32 i = 0; i < size; ++i )
+      value = ( value << 8 ) | static_cast<u8>( data[i] );
+    return value;
+  }
+} // namespace
+
+
+MsgpackStreamReader::MsgpackStreamReader( const char* path )
+    : file_( path, "rb" )
+{
+  mFailIf( !file_.isOpen() );
+  remaining_ = file_.getSize();
+}
+
+bool MsgpackStreamReader::feed()
+{
+  if( !remaining_ )
+    return false;
+
+  size_t size = std::min( remaining_, sReadChunkSize );
+  unpacker_.reserve_buffer( size );
+  mFailIf( file_.read( unpacker_.buffer(), size ) != StatusOk );
+  unpacker_.buffer_consumed( size );
+  remaining_ -= size;
+  return true;
+}
+
+u32 MsgpackStreamReader::readContainerHeader( u8 fixMask, u8 fixTag, u8 tag16, u8 tag32 )
+{
+  // headers are at most 5 bytes. this is called only between objects, so unpacker has no partially parsed data
+  while( unpacker_.nonparsed_size() < 5 && feed() )
+    ;
+
+  mFailIf( unpacker_.nonparsed_size() == 0 );
+  const char* data = unpacker_.nonparsed_buffer();
+  u8          tag  = static_cast<u8>( data[0] );
+
+  u32 headerSize = 1;
+  u32 count      = 0;
+
+  if( ( tag & fixMask ) == fixTag )
+  {
+    count = tag & static_cast<u8>( ~fixMask );
+  }
+  else if( tag == tag16 )
+  {
+    mFailIf( unpacker_.nonparsed_size() < 3 );
+    headerSize = 3;
+    count      = readBigEndian( data + 1, 2 );
+  }
+  else if( tag == tag32 )
+  {
+    mFailIf( unpacker_.nonparsed_size() < 5 );
+    headerSize = 5;
+    count      = readBigEndian( data + 1, 4 );
+  }
+  else
+  {
+    printf( "msgpack stream: unexpected tag 0x%02x\n", tag );
+    abort();
+  }
+
+  unpacker_.skip_nonparsed_buffer( headerSize );
+  return count;
+}
+
+u32 MsgpackStreamReader::readMapHeader()
+{
+  return readContainerHeader( 0xf0, 0x80, 0xde, 0xdf );
+}
+
+u32 MsgpackStreamReader::readArrayHeader()
+{
+  return readContainerHeader( 0xf0, 0x90, 0xdc, 0xdd );
+}
+
+msgpack::object_handle MsgpackStreamReader::readObject()
+{
+  auto handle = msgpack::object_handle();
+  while( !unpacker_.next( handle ) )
+    mFailIf( !feed() );
+  return handle;
+}
@@ -0,0 +1,40 @@
+#pragma once
+#include "core/core.hpp"
+
+namespace intermediate
+{
+  // reads msgpack file piece by piece, so only one element of big containers is in memory at once.
+  // maps and arrays are entered by reading their headers, their elements are read with msgpack::unpacker
+  class MsgpackStreamReader
+  {
+    core::fs::File    file_;
+    msgpack::unpacker unpacker_;
+    size_t            remaining_; // not read from file yet
+
+    bool feed();
+    u32  readContainerHeader( u8 fixMask, u8 fixTag, u8 tag16, u8 tag32 );
+
+  public:
+    explicit MsgpackStreamReader( const char* path );
+
+    u32 readMapHeader();
+    u32 readArrayHeader();
+
+    msgpack::object_handle readObject();
+    void                   skip() { readObject(); }
+
+    template<typename T>
+    void read( T& out )
+    {
+      auto handle = readObject();
+      handle.get().convert( out );
+    }
+
+    std::string readString()
+    {
+      auto str = std::string();
+      read( str );
+      return str;
+    }
+  };
+} // namespace intermediate
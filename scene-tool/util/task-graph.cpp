@@ -0,0 +1,320 @@
+#include "util/task-graph.hpp"
+#include "scene-tool.hpp"
+
+using namespace intermediate;
+
+
+namespace
+{
+  using Clock = std::chrono::steady_clock;
+
+  struct TaskNode
+  {
+    TaskId                id;
+    BuildStage            stage;
+    std::string           name;
+    std::function<void()> func;
+    std::vector<TaskId>   dependencies;
+    std::vector<TaskId>   dependents;
+    u32                   pendingDependencies = 0;
+    bool                  done                = false;
+    f64                   startMs             = 0;
+    f64                   endMs               = 0;
+  };
+
+  struct WorkerQueue
+  {
+    std::mutex            mutex;
+    std::deque<TaskNode*> tasks; // owner takes from back, thieves from front
+  };
+
+  thread_local s32 sWorkerIndex = -1;
+} // namespace
+
+
+namespace intermediate
+{
+  struct TaskGraphData
+  {
+    std::mutex              mutex; // nodes and dependency bookkeeping
+    std::deque<TaskNode>    nodes; // deque: references are stable when tasks are added while running
+    std::condition_variable wakeUp;
+    std::condition_variable allDone;
+    u32                     unfinishedTasks = 0;
+    bool                    running         = false;
+    bool                    stopping        = false;
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+    std::vector<std::thread>                  threads;
+    std::atomic<u32>                          queuedTasks = 0;
+    std::atomic<u32>                          nextQueue   = 0;
+
+    Clock::time_point startTime;
+    f64               wallMs = 0;
+
+    f64 getMs() const
+    {
+      return std::chrono::duration<f64, std::milli>( Clock::now() - startTime ).count();
+    }
+
+    void schedule( TaskNode* node )
+    {
+      u32 queueIndex = sWorkerIndex >= 0
+                           ? static_cast<u32>( sWorkerIndex )
+                           : nextQueue++ % static_cast<u32>( queues.size() );
+      {
+        auto lock = std::lock_guard( queues[queueIndex]->mutex );
+        queues[queueIndex]->tasks.push_back( node );
+      }
+      queuedTasks++;
+
+      // lock is needed, so worker can't miss wake up between its check and wait
+      {
+        auto lock = std::lock_guard( mutex );
+      }
+      wakeUp.notify_one();
+    }
+
+    TaskNode* tryTake( u32 workerIndex )
+    {
+      // own queue first, newest task (its data is likely still in cache)
+      {
+        auto& queue = *queues[workerIndex];
+        auto  lock  = std::lock_guard( queue.mutex );
+        if( !queue.tasks.empty() )
+        {
+          auto* node = queue.tasks.back();
+          queue.tasks.pop_back();
+          queuedTasks--;
+          return node;
+        }
+      }
+
+      // steal oldest task from others
+      for( u32 i = 1; i < queues.size(); ++i )
+      {
+        auto& queue = *queues[( workerIndex + i ) % queues.size()];
+        auto  lock  = std::lock_guard( queue.mutex );
+        if( !queue.tasks.empty() )
+        {
+          auto* node = queue.tasks.front();
+          queue.tasks.pop_front();
+          queuedTasks--;
+          return node;
+        }
+      }
+
+      return nullptr;
+    }
+
+    void execute( TaskNode* node )
+    {
+      node->startMs = getMs();
+      node->func();
+      node->func  = nullptr; // release captured state
+      node->endMs = getMs();
+
+      auto ready = std::vector<TaskNode*>();
+      {
+        auto lock  = std::lock_guard( mutex );
+        node->done = true;
+
+        for( TaskId dependent: node->dependents )
+        {
+          auto& dependentNode = nodes[dependent];
+          if( --dependentNode.pendingDependencies == 0 )
+            ready.push_back( &dependentNode );
+        }
+
+        if( --unfinishedTasks == 0 )
+          allDone.notify_all();
+      }
+
+      for( auto* readyNode: ready )
+        schedule( readyNode );
+    }
+
+    void workerLoop( u32 workerIndex )
+    {
+      sWorkerIndex = static_cast<s32>( workerIndex );
+
+      for( ;; )
+      {
+        if( auto* node = tryTake( workerIndex ) )
+        {
+          execute( node );
+          continue;
+        }
+
+        auto lock = std::unique_lock( mutex );
+        wakeUp.wait( lock, [this] { return stopping || queuedTasks > 0; } );
+        if( stopping && queuedTasks == 0 )
+          return;
+      }
+    }
+  };
+} // namespace intermediate
+
+
+TaskGraph::TaskGraph( u32 threadCount )
+    : data_( new TaskGraphData() )
+{
+  threadCount = std::max( threadCount, 1u );
+  for( u32 i = 0; i < threadCount; ++i )
+    data_->queues.emplace_back( std::make_unique<WorkerQueue>() );
+}
+
+TaskGraph::~TaskGraph()
+{
+  delete data_;
+}
+
+TaskId TaskGraph::add( BuildStage stage, std::string name, std::function<void()> func,
+                       std::span<const TaskId> dependencies )
+{
+  TaskNode* ready = nullptr;
+  TaskId    id;
+
+  {
+    auto lock = std::lock_guard( data_->mutex );
+    id        = static_cast<TaskId>( data_->nodes.size() );
+
+    auto& node = data_->nodes.emplace_back( TaskNode{
+        .id           = id,
+        .stage        = stage,
+        .name         = std::move( name ),
+        .func         = std::move( func ),
+        .dependencies = { dependencies.begin(), dependencies.end() },
+    } );
+
+    for( TaskId dependency: dependencies )
+    {
+      mFailIf( dependency >= id );
+      auto& dependencyNode = data_->nodes[dependency];
+      if( !dependencyNode.done )
+      {
+        dependencyNode.dependents.push_back( id );
+        node.pendingDependencies++;
+      }
+    }
+
+    data_->unfinishedTasks++;
+    if( data_->running && node.pendingDependencies == 0 )
+      ready = &node;
+  }
+
+  if( ready )
+    data_->schedule( ready );
+
+  return id;
+}
+
+void TaskGraph::run()
+{
+  auto ready = std::vector<TaskNode*>();
+  {
+    auto lock        = std::lock_guard( data_->mutex );
+    data_->running   = true;
+    data_->stopping  = false;
+    data_->startTime = Clock::now();
+
+    for( auto& node: data_->nodes )
+      if( !node.done && node.pendingDependencies == 0 )
+        ready.push_back( &node );
+  }
+
+  printf( "task graph: running " mFmtU64 " tasks on " mFmtU64 " threads\n",
+          static_cast<u64>( data_->nodes.size() ), static_cast<u64>( data_->queues.size() ) );
+
+  for( u32 i = 0; i < data_->queues.size(); ++i )
+    data_->threads.emplace_back( [this, i] { data_->workerLoop( i ); } );
+
+  for( auto* node: ready )
+    data_->schedule( node );
+
+  {
+    auto lock = std::unique_lock( data_->mutex );
+    data_->allDone.wait( lock, [this] { return data_->unfinishedTasks == 0; } );
+    data_->stopping = true;
+    data_->running  = false;
+  }
+  data_->wakeUp.notify_all();
+
+  for( auto& thread: data_->threads )
+    thread.join();
+  data_->threads.clear();
+
+  data_->wallMs = data_->getMs();
+}
+
+void TaskGraph::printReport() const
+{
+  struct StageReport
+  {
+    u32 count   = 0;
+    f64 totalMs = 0;
+    f64 maxMs   = 0;
+    f64 startMs = std::numeric_limits<f64>::max();
+    f64 endMs   = 0;
+  };
+
+  auto stages   = std::array<StageReport, sBuildStageCount>();
+  f64  busyMs   = 0;
+  auto pathMs   = std::vector<f64>( data_->nodes.size(), 0 );
+  auto pathPrev = std::vector<s64>( data_->nodes.size(), -1 );
+  s64  pathEnd  = -1;
+
+  for( const auto& node: data_->nodes )
+  {
+    f64   durationMs = node.endMs - node.startMs;
+    auto& stage      = stages[node.stage];
+    stage.count++;
+    stage.totalMs += durationMs;
+    stage.maxMs   = std::max( stage.maxMs, durationMs );
+    stage.startMs = std::min( stage.startMs, node.startMs );
+    stage.endMs   = std::max( stage.endMs, node.endMs );
+    busyMs += durationMs;
+
+    // dependencies always have smaller ids, so they are already computed
+    for( TaskId dependency: node.dependencies )
+    {
+      if( pathMs[dependency] > pathMs[node.id] )
+      {
+        pathMs[node.id]   = pathMs[dependency];
+        pathPrev[node.id] = dependency;
+      }
+    }
+    pathMs[node.id] += durationMs;
+
+    if( pathEnd < 0 || pathMs[node.id] > pathMs[static_cast<size_t>( pathEnd )] )
+      pathEnd = node.id;
+  }
+
+  printf( "\nbuild report: wall %.1f ms, busy %.1f ms, %zu threads, parallel efficiency %.0f%%\n",
+          data_->wallMs, busyMs, data_->queues.size(),
+          data_->wallMs > 0 ? 100.0 * busyMs / ( data_->wallMs * static_cast<f64>( data_->queues.size() ) ) : 0.0 );
+
+  printf( "  %-12s %6s %12s %12s %12s\n", "stage", "tasks", "total ms", "max ms", "span ms" );
+  for( u32 i = 0; i < sBuildStageCount; ++i )
+  {
+    const auto& stage = stages[i];
+    if( !stage.count )
+      continue;
+    printf( "  %-12s %6u %12.1f %12.1f %12.1f\n", toString( static_cast<BuildStage>( i ) ),
+            stage.count, stage.totalMs, stage.maxMs, stage.endMs - stage.startMs );
+  }
+
+  if( pathEnd < 0 )
+    return;
+
+  auto path = std::vector<TaskId>();
+  for( s64 i = pathEnd; i >= 0; i = pathPrev[static_cast<size_t>( i )] )
+    path.push_back( static_cast<TaskId>( i ) );
+
+  printf( "critical path: %.1f ms, " mFmtU64 " tasks\n", pathMs[static_cast<size_t>( pathEnd )], static_cast<u64>( path.size() ) );
+  for( auto it = path.rbegin(); it != path.rend(); ++it )
+  {
+    const auto& node = data_->nodes[*it];
+    printf( "  %10.1f ms  %-12s %s\n", node.endMs - node.startMs, toString( node.stage ), node.name.c_str() );
+  }
+}
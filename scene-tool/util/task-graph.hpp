@@ -0,0 +1,48 @@
+#pragma once
+#include "core/core.hpp"
+
+namespace intermediate
+{
+#define xBuildStageEnum( X )  \
+  X( BuildStage, Parse )      \
+  X( BuildStage, Decode )     \
+  X( BuildStage, DdsConvert ) \
+  X( BuildStage, Mesh )       \
+  X( BuildStage, Partition )  \
+  X( BuildStage, Scene )      \
+  X( BuildStage, Write )
+
+  mCoreDeclareEnum( BuildStage, xBuildStageEnum );
+
+  constexpr u32 sBuildStageCount = BuildStage_Write + 1;
+
+  using TaskId = u32;
+
+  // build tasks with dependencies. task starts on work stealing pool as soon as all its dependencies are done.
+  // tasks can be added while graph is running (also from other tasks), but only with dependencies added before
+  class TaskGraph
+  {
+    struct TaskGraphData* data_;
+
+  public:
+    explicit TaskGraph( u32 threadCount = std::thread::hardware_concurrency() );
+    ~TaskGraph();
+
+    TaskGraph( const TaskGraph& )            = delete;
+    TaskGraph& operator=( const TaskGraph& ) = delete;
+
+    TaskId add( BuildStage stage, std::string name, std::function<void()> func,
+                std::span<const TaskId> dependencies = {} );
+    TaskId add( BuildStage stage, std::string name, std::function<void()> func,
+                std::initializer_list<TaskId> dependencies )
+    {
+      return add( stage, std::move( name ), std::move( func ), std::span( dependencies.begin(), dependencies.size() ) );
+    }
+
+    // blocks until all tasks are done
+    void run();
+
+    // per stage timings and longest dependency chain
+    void printReport() const;
+  };
+} // namespace intermediate
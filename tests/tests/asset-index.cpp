@@ -0,0 +1,67 @@
+#include "unit_test_framework/unit_test_framework.hpp"
+#include "core/data/asset-index.hpp"
+
+using namespace core;
+using namespace core::data;
+
+namespace
+{
+  constexpr u32 sAssetCount   = 2000;
+  constexpr u32 sBuilderCount = 4;
+} // namespace
+
+TEST( asset_index )
+{
+  ASSERT_EQUAL( initializeAssetIndex(), StatusOk );
+
+  auto meshes  = std::vector<core::render::Mesh>( sAssetCount );
+  auto chunkId = StringId( "chunk" );
+  auto chunk2  = StringId( "chunk2" );
+
+  // scene builders look assets up while main thread registers chunk
+  auto handles  = std::vector<std::vector<MeshHandle>>( sBuilderCount );
+  auto builders = std::vector<std::thread>();
+  for( u32 b = 0; b < sBuilderCount; ++b )
+  {
+    builders.emplace_back( [&handles, b]() {
+      for( u32 i = 0; i < sAssetCount; ++i )
+        handles[b].push_back( findMesh( StringId( "mesh-" + std::to_string( i ) ) ) );
+    } );
+  }
+  for( u32 i = 0; i < sAssetCount; ++i )
+    registerMesh( StringId( "mesh-" + std::to_string( i ) ), chunkId, &meshes[i] );
+  for( auto& builder: builders )
+    builder.join();
+
+  // every builder got the same slot, which sees registered asset
+  for( u32 i = 0; i < sAssetCount; ++i )
+  {
+    for( u32 b = 0; b < sBuilderCount; ++b )
+    {
+      ASSERT_EQUAL( handles[b][i].getId(), StringId( "mesh-" + std::to_string( i ) ) );
+      ASSERT_EQUAL( handles[b][i].get(), &meshes[i] );
+    }
+  }
+
+  // chunk which doesn't provide asset can't unregister it
+  unregisterMesh( StringId( "mesh-0" ), chunk2 );
+  ASSERT_TRUE( handles[0][0].isResident() );
+  unregisterMesh( StringId( "mesh-0" ), chunkId );
+  ASSERT_FALSE( handles[0][0].isResident() );
+  ASSERT_TRUE( handles[0][0].isValid() );
+
+  // asset of two chunks stays resident while any of them is, whichever is evicted first
+  auto otherMesh = core::render::Mesh();
+  registerMesh( StringId( "mesh-1" ), chunk2, &otherMesh );
+  ASSERT_EQUAL( handles[0][1].get(), &otherMesh );
+  unregisterMesh( StringId( "mesh-1" ), chunk2 );
+  ASSERT_EQUAL( handles[0][1].get(), &meshes[1] );
+
+  registerMesh( StringId( "mesh-2" ), chunk2, &otherMesh );
+  unregisterMesh( StringId( "mesh-2" ), chunkId );
+  ASSERT_EQUAL( handles[0][2].get(), &otherMesh );
+  unregisterMesh( StringId( "mesh-2" ), chunk2 );
+  ASSERT_FALSE( handles[0][2].isResident() );
+
+  destroyAssetIndex();
+}
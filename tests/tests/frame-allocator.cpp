@@ -0,0 +1,45 @@
+#include "unit_test_framework/unit_test_framework.hpp"
+#include "core/system/frame-allocator.hpp"
+#include "core/system/memory.hpp"
+
+using namespace core::system;
+
+TEST( frame_allocator )
+{
+  ASSERT_EQUAL( frame::init( 4096 ), StatusOk );
+
+  auto* first = frame::allocate( 100, 16 );
+  auto* next  = frame::allocate( 8, 64 );
+  ASSERT_EQUAL( reinterpret_cast<uintptr_t>( next ) % 64, 0u );
+  ASSERT_TRUE( static_cast<u8*>( next ) >= static_cast<u8*>( first ) + 100 );
+
+  // bigger than block gets block of its own
+  auto* big = frame::allocate( 10000, 16 );
+  ASSERT_TRUE( big != nullptr );
+  frame::frameEnd();
+  ASSERT_EQUAL( frame::getStats().blocks, 2u );
+
+  // memory of frame is reused when its arena comes around
+  for( u32 i = 1; i < frame::sFrameArenaCount; ++i )
+    frame::frameEnd();
+  ASSERT_EQUAL( frame::allocate( 100, 16 ), first );
+
+  // after warmup frames don't touch heap
+  for( u32 i = 0; i < frame::sFrameArenaCount; ++i )
+  {
+    auto vector = FrameVector<u32>( 500 );
+    frame::frameEnd();
+  }
+  auto allocations = memory::getAllocationCount();
+  for( u32 i = 0; i < 10; ++i )
+  {
+    auto vector = FrameVector<u32>();
+    for( u32 j = 0; j < 500; ++j )
+      vector.push_back( j );
+    ASSERT_EQUAL( vector[499], 499u );
+    frame::frameEnd();
+  }
+  ASSERT_EQUAL( memory::getAllocationCount(), allocations );
+
+  frame::destroy();
+}
@@ -0,0 +1,28 @@
+#include "unit_test_framework/unit_test_framework.hpp"
+#include "core/hash.hpp"
+
+namespace
+{
+  u64 hash( const char* str )
+  {
+    return core::hash64( std::span( reinterpret_cast<const byte*>( str ), strlen( str ) ) );
+  }
+} // namespace
+
+TEST( hash64 )
+{
+  ASSERT_EQUAL( hash( "" ), static_cast<u64>( 0xEF46DB3751D8E999u ) );
+  ASSERT_EQUAL( hash( "a" ), static_cast<u64>( 0xD24EC4F1A98C6E5Bu ) );
+  ASSERT_EQUAL( hash( "abc" ), static_cast<u64>( 0x44BC2CF5AD770999u ) );
+}
+
+TEST( hash64_streaming )
+{
+  const char* str = "Nobody inspects the spammish repetition, and the whole thing is long enough";
+
+  auto hasher = core::Hasher64();
+  for( size_t i = 0; i < strlen( str ); ++i )
+    hasher.update( str + i, 1 );
+
+  ASSERT_EQUAL( hasher.digest(), hash( str ) );
+}
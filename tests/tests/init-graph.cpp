@@ -0,0 +1,67 @@
+#include "unit_test_framework/unit_test_framework.hpp"
+#include "core/system/init-graph.hpp"
+#include "core/system/task.hpp"
+
+using namespace core;
+using namespace core::system;
+
+TEST( init_graph )
+{
+  ASSERT_EQUAL( task::init(), StatusOk );
+
+  auto mainThread = std::this_thread::get_id();
+  auto order      = std::vector<std::string>();
+  auto orderMutex = std::mutex();
+  auto done       = [&order, &orderMutex]( const char* name ) {
+    auto lock = std::lock_guard( orderMutex );
+    order.push_back( name );
+    return StatusOk;
+  };
+
+  // main thread stage can only finish while worker stage runs
+  auto workerStarted = std::atomic<bool>( false );
+  auto mainFinished  = std::atomic<bool>( false );
+  auto overlapped    = false;
+
+  auto graph = InitGraph();
+  graph.add( "window", {}, InitThreadMain, [&]() {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds( 5 );
+    while( !workerStarted.load() && std::chrono::steady_clock::now() < deadline )
+      std::this_thread::yield();
+    overlapped  = workerStarted.load();
+    auto status = done( "window" );
+    mainFinished.store( true );
+    return status;
+  } );
+  graph.add( "data", {}, InitThreadAny, [&]() {
+    workerStarted.store( true );
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds( 5 );
+    while( !mainFinished.load() && std::chrono::steady_clock::now() < deadline )
+      std::this_thread::yield();
+    return done( "data" );
+  } );
+  graph.add( "render", { "window", "data" }, InitThreadMain, [&]() {
+    ASSERT_TRUE( std::this_thread::get_id() == mainThread );
+    return done( "render" );
+  } );
+  graph.add( "scene", { "data" }, InitThreadAny, [&]() { return done( "scene" ); } );
+
+  ASSERT_EQUAL( graph.run(), StatusOk );
+  ASSERT_TRUE( overlapped );
+  ASSERT_EQUAL( order.size(), 4u );
+  ASSERT_EQUAL( order[0], "window" );
+  ASSERT_EQUAL( order[1], "data" );
+  ASSERT_TRUE( std::ranges::find( order, "render" ) != order.end() );
+  ASSERT_TRUE( graph.getStageUs( "window" ) <= graph.getTotalUs() );
+
+  // stages which depend on failed one are not started, its status comes out
+  order.clear();
+  auto failing = InitGraph();
+  failing.add( "data", {}, InitThreadAny, []() { return StatusNotFound; } );
+  failing.add( "input", {}, InitThreadMain, [&]() { return done( "input" ); } );
+  failing.add( "render", { "data" }, InitThreadMain, [&]() { return done( "render" ); } );
+  ASSERT_EQUAL( failing.run(), StatusNotFound );
+  ASSERT_EQUAL( failing.getStageUs( "render" ), 0u );
+
+  task::destroy();
+}
@@ -0,0 +1,68 @@
+#include "unit_test_framework/unit_test_framework.hpp"
+#include "core/data/load-scheduler.hpp"
+#include "core/system/frame-allocator.hpp"
+
+using namespace core::data;
+
+namespace
+{
+  // job which only records when it is started or dropped, test finishes it by hand
+  LoadJob makeJob( const LoadToken& token, std::string name, std::vector<std::string>& log )
+  {
+    return LoadJob{
+        .token    = token,
+        .start    = [name, &log]() { log.push_back( "start " + name ); },
+        .onCancel = [name, &log]() { log.push_back( "cancel " + name ); },
+    };
+  }
+} // namespace
+
+TEST( load_scheduler )
+{
+  ASSERT_EQUAL( core::system::frame::init(), StatusOk );
+  ASSERT_EQUAL( initializeLoadScheduler(), StatusOk );
+  setLoadQueueDepth( 1 );
+
+  auto log      = std::vector<std::string>();
+  auto prefetch = LoadToken( LoadPriority_Prefetch );
+  auto visible  = LoadToken( LoadPriority_VisibleSoon );
+  auto dropped  = LoadToken( LoadPriority_Prefetch );
+  auto blocking = LoadToken( LoadPriority_Blocking );
+
+  scheduleLoad( makeJob( prefetch, "prefetch", log ) );
+  scheduleLoad( makeJob( dropped, "dropped", log ) );
+  scheduleLoad( makeJob( visible, "visible", log ) );
+  ASSERT_TRUE( log.empty() );
+  ASSERT_EQUAL( getLoadSchedulerStats().queued, 3u );
+
+  // more important job goes first, even when it was scheduled later
+  dropped.cancel();
+  updateLoadScheduler();
+  ASSERT_SEQUENCE_EQUAL( log, ( std::vector<std::string>{ "cancel dropped", "start visible" } ) );
+  ASSERT_EQUAL( getLoadSchedulerStats().inFlight, 1u );
+
+  // blocking job doesn't wait for queue depth
+  scheduleLoad( makeJob( blocking, "blocking", log ) );
+  ASSERT_EQUAL( log.back(), "start blocking" );
+  ASSERT_EQUAL( getLoadSchedulerStats().inFlight, 2u );
+
+  // raised priority is seen on next update
+  finishLoad( blocking, StatusOk );
+  finishLoad( visible, StatusOk );
+  prefetch.setPriority( LoadPriority_Blocking );
+  updateLoadScheduler();
+  ASSERT_EQUAL( log.back(), "start prefetch" );
+  finishLoad( prefetch, StatusBadFile );
+
+  const auto& stats = getLoadSchedulerStats();
+  ASSERT_EQUAL( stats.queued, 0u );
+  ASSERT_EQUAL( stats.inFlight, 0u );
+  ASSERT_EQUAL( stats.maxQueued, 3u );
+  ASSERT_EQUAL( stats.classes[LoadPriority_Blocking].completed, 1u );
+  ASSERT_EQUAL( stats.classes[LoadPriority_Blocking].failed, 1u );
+  ASSERT_EQUAL( stats.classes[LoadPriority_VisibleSoon].completed, 1u );
+  ASSERT_EQUAL( stats.classes[LoadPriority_Prefetch].cancelled, 1u );
+
+  destroyLoadScheduler();
+  core::system::frame::destroy();
+}
@@ -0,0 +1,46 @@
+#include "unit_test_framework/unit_test_framework.hpp"
+#include "core/data/manifest.hpp"
+
+namespace
+{
+  void writeText( const stdfs::path& path, std::string_view text )
+  {
+    stdfs::create_directories( path.parent_path() );
+    auto status = core::fs::writeFile( path.string(), std::span( reinterpret_cast<const byte*>( text.data() ), text.size() ) );
+    assert( status == StatusOk );
+    ( void ) status;
+  }
+} // namespace
+
+TEST( manifest )
+{
+  auto directory = stdfs::temp_directory_path() / "core-tests-manifest";
+  stdfs::remove_all( directory );
+  writeText( directory / "maps" / "a.chunk", "chunk" );
+  writeText( directory / "maps" / "a.scene.bin", "scene" );
+  writeText( directory / "shaders" / "mesh.hlsl", "hlsl" );
+  writeText( directory / ".build-cache" / "index.json", "{}" );
+  writeText( directory / ".manifest-old", "hidden" );
+
+  auto bytes = std::vector<byte>();
+  ASSERT_EQUAL( core::data::buildManifest( directory, bytes, []( const stdfs::path& ) -> u64 { return 42; } ), StatusOk );
+  auto manifestPath = ( directory / core::data::sManifestName ).string();
+  ASSERT_EQUAL( core::fs::writeFile( manifestPath, bytes ), StatusOk );
+
+  auto manifest = core::data::Manifest();
+  ASSERT_EQUAL( manifest.open( manifestPath ), StatusOk );
+  ASSERT_EQUAL( manifest.getEntryCount(), static_cast<size_t>( 3 ) );
+
+  const auto* entry = manifest.find( StringId( "maps/a.scene.bin" ) );
+  ASSERT_TRUE( entry );
+  ASSERT_EQUAL( manifest.getPath( *entry ), std::string_view( "maps/a.scene.bin" ) );
+  ASSERT_EQUAL( entry->size, static_cast<u64>( 5 ) );
+  ASSERT_EQUAL( entry->contentHash, static_cast<u64>( 42 ) );
+
+  ASSERT_TRUE( manifest.find( StringId( "shaders/mesh.hlsl" ) ) );
+  ASSERT_FALSE( manifest.find( StringId( ".build-cache/index.json" ) ) );
+  ASSERT_FALSE( manifest.find( StringId( "maps/b.chunk" ) ) );
+
+  manifest = core::data::Manifest();
+  stdfs::remove_all( directory );
+}
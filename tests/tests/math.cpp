@@ -25,3 +25,17 @@ TEST( math_bb )
   ASSERT_FALSE( bb.isInside( Vec3( 0.5f, 0.5f, 0.5f ) ) );
   ASSERT_FALSE( bb.isInside( Vec3( 2.5f, 2.5f, 2.5f ) ) );
 }
+
+TEST( math_bb_distance )
+{
+  auto bb   = core::math::BoundingBox();
+  bb.center = Vec3( 1, 1, 1 );
+  bb.bx     = Vec3( 2, 0, 0 );
+  bb.by     = Vec3( 0, 2, 0 );
+  bb.bz     = Vec3( 0, 0, 2 );
+
+  ASSERT_EQUAL( bb.distanceTo( Vec3( 2, 2, 2 ) ), 0.f );
+  ASSERT_EQUAL( bb.distanceTo( Vec3( 0, 2, 2 ) ), 1.f );
+  ASSERT_EQUAL( bb.distanceTo( Vec3( 2, 5, 2 ) ), 2.f );
+  ASSERT_EQUAL( bb.distanceTo( Vec3( 6, 7, 2 ) ), 5.f );
+}
@@ -0,0 +1,38 @@
+#include "unit_test_framework/unit_test_framework.hpp"
+#include "core/system/memory.hpp"
+
+using namespace core::system;
+
+TEST( memory_tags )
+{
+  auto before           = memory::getTagStats( memory::MemoryTag_Data );
+  auto allocationsBefore = memory::getAllocationCount();
+
+  {
+    auto bytes = std::vector<u8>();
+    {
+      mCoreMemoryScope( Data );
+      bytes.resize( 1000 );
+    }
+
+    // freed outside of scope, but still released to tag it was allocated with
+    auto during = memory::getTagStats( memory::MemoryTag_Data );
+    ASSERT_EQUAL( during.liveBytes, before.liveBytes + 1000 );
+    ASSERT_EQUAL( during.allocations, before.allocations + 1 );
+    ASSERT_TRUE( during.peakBytes >= during.liveBytes );
+  }
+
+  ASSERT_EQUAL( memory::getTagStats( memory::MemoryTag_Data ).liveBytes, before.liveBytes );
+  ASSERT_EQUAL( memory::getAllocationCount(), allocationsBefore + 1 );
+
+  // aligned new goes through the same header
+  struct alignas( 64 ) Aligned
+  {
+    u8 data[64];
+  };
+  {
+    mCoreMemoryScope( Render );
+    auto aligned = std::make_unique<Aligned>();
+    ASSERT_EQUAL( reinterpret_cast<uintptr_t>( aligned.get() ) % 64, 0u );
+  }
+}
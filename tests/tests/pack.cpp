@@ -0,0 +1,66 @@
+#include "unit_test_framework/unit_test_framework.hpp"
+#include "core/fs/fs.hpp"
+
+namespace
+{
+  void writeText( const stdfs::path& path, std::string_view text )
+  {
+    stdfs::create_directories( path.parent_path() );
+    auto status = core::fs::writeFile( path.string(), std::span( reinterpret_cast<const byte*>( text.data() ), text.size() ) );
+    assert( status == StatusOk );
+    ( void ) status;
+  }
+
+  std::string_view asText( std::span<const byte> bytes )
+  {
+    return { reinterpret_cast<const char*>( bytes.data() ), bytes.size() };
+  }
+} // namespace
+
+TEST( pack )
+{
+  auto directory = stdfs::temp_directory_path() / "core-tests-pack";
+  stdfs::remove_all( directory );
+  writeText( directory / "maps" / "a.chunk", "chunk" );
+  writeText( directory / "maps" / "a.scene.bin", "scene" );
+  writeText( directory / "shaders" / "empty.hlsl", "" );
+
+  auto sources = std::vector<core::fs::PackSource>{
+      { .name = "maps/a.chunk", .path = directory / "maps" / "a.chunk" },
+      { .name = "maps/a.scene.bin", .path = directory / "maps" / "a.scene.bin" },
+      { .name = "shaders/empty.hlsl", .path = directory / "shaders" / "empty.hlsl" },
+  };
+  auto packPath = ( directory / ".data.pack" ).string();
+  ASSERT_EQUAL( core::fs::writePack( packPath.c_str(), sources ), StatusOk );
+
+  // loose files are changed, so it is seen where bytes come from
+  writeText( directory / "maps" / "a.chunk", "loose" );
+  writeText( directory / "maps" / "b.chunk", "only loose" );
+  ASSERT_EQUAL( core::fs::mountPack( packPath.c_str(), directory ), StatusOk );
+
+  auto packed = std::span<const byte>();
+  ASSERT_TRUE( core::fs::findPackedFile( ( directory / "maps/a.scene.bin" ).string(), packed ) );
+  ASSERT_EQUAL( asText( packed ), std::string_view( "scene" ) );
+  ASSERT_EQUAL( reinterpret_cast<uintptr_t>( packed.data() ) % 64, static_cast<uintptr_t>( 0 ) );
+
+  auto view = core::fs::FileView();
+  ASSERT_EQUAL( view.open( ( directory / "maps" / "a.chunk" ).string().c_str() ), StatusOk );
+  ASSERT_EQUAL( asText( view.getBytes() ), std::string_view( "chunk" ) );
+  ASSERT_EQUAL( view.open( ( directory / "shaders" / "empty.hlsl" ).string().c_str() ), StatusOk );
+  ASSERT_TRUE( view.getBytes().empty() );
+  ASSERT_EQUAL( view.open( ( directory / "maps" / "b.chunk" ).string().c_str() ), StatusOk );
+  ASSERT_EQUAL( asText( view.getBytes() ), std::string_view( "only loose" ) );
+  ASSERT_EQUAL( view.open( ( directory / "maps" / "c.chunk" ).string().c_str() ), StatusNotFound );
+
+  auto bytes = std::vector<byte>();
+  ASSERT_EQUAL( core::fs::readFile( ( directory / "maps" / "a.chunk" ).string(), bytes ), StatusOk );
+  ASSERT_EQUAL( asText( bytes ), std::string_view( "chunk" ) );
+
+  view = core::fs::FileView();
+  core::fs::unmountPack();
+  ASSERT_FALSE( core::fs::findPackedFile( ( directory / "maps" / "a.chunk" ).string(), packed ) );
+  ASSERT_EQUAL( core::fs::readFile( ( directory / "maps" / "a.chunk" ).string(), bytes ), StatusOk );
+  ASSERT_EQUAL( asText( bytes ), std::string_view( "loose" ) );
+
+  stdfs::remove_all( directory );
+}
@@ -0,0 +1,54 @@
+#include "unit_test_framework/unit_test_framework.hpp"
+#include "core/system/profiler.hpp"
+
+using namespace core::system;
+
+namespace
+{
+  const profiler::ScopeSummary* findScope( const char* name )
+  {
+    auto it = std::ranges::find_if( profiler::getFrameSummary().scopes, [name]( const auto& scope ) {
+      return std::string_view( scope.name ) == name;
+    } );
+    return it != profiler::getFrameSummary().scopes.end() ? &*it : nullptr;
+  }
+} // namespace
+
+// scope objects are used instead of macros, so test doesn't depend on VY_PROFILER
+TEST( cpu_profiler )
+{
+  ASSERT_EQUAL( profiler::init( { .historyFrames = 4, .slowFrameMs = 0, .slowFrameCooldown = 0 } ), StatusOk );
+
+  {
+    auto outer = profiler::Scope( "outer" );
+    for( int i = 0; i < 3; ++i )
+    {
+      auto inner = profiler::Scope( "inner" );
+    }
+
+    auto thread = std::thread( []() {
+      profiler::setThreadName( "test worker" );
+      auto scope = profiler::Scope( "thread" );
+    } );
+    thread.join();
+  }
+  profiler::frameEnd();
+
+  ASSERT_EQUAL( profiler::getFrameSummary().events, 5u );
+  ASSERT_EQUAL( profiler::getFrameSummary().dropped, 0u );
+  ASSERT_EQUAL( findScope( "outer" )->calls, 1u );
+  ASSERT_EQUAL( findScope( "inner" )->calls, 3u );
+  ASSERT_EQUAL( findScope( "thread" )->calls, 1u );
+  ASSERT_TRUE( findScope( "outer" )->totalMs >= findScope( "inner" )->totalMs );
+
+  // next frame starts empty
+  profiler::frameEnd();
+  ASSERT_EQUAL( profiler::getFrameSummary().events, 0u );
+
+  auto path = ( stdfs::temp_directory_path() / "core-tests-profile.json" ).string();
+  ASSERT_EQUAL( profiler::exportChromeTrace( path.c_str() ), StatusOk );
+  ASSERT_TRUE( stdfs::file_size( path ) > 0 );
+
+  stdfs::remove( path );
+  profiler::destroy();
+}
@@ -0,0 +1,99 @@
+#include "unit_test_framework/unit_test_framework.hpp"
+#include "core/data/render-chunk.hpp"
+#include "core/system/frame-allocator.hpp"
+
+using namespace core;
+using namespace core::data;
+
+namespace
+{
+  // blocking load of empty chunk completes right in request, nothing goes to gpu
+  RenderChunk loadChunk( const char* id )
+  {
+    auto chunk = RenderChunk();
+    chunk.load( StringId( id ), LoadToken( LoadPriority_Blocking ) );
+    return chunk;
+  }
+
+  u64 countReads( const std::vector<StringId>& reads, const char* id )
+  {
+    return static_cast<u64>( std::ranges::count( reads, StringId( id ) ) );
+  }
+} // namespace
+
+TEST( render_chunk )
+{
+  ASSERT_EQUAL( system::frame::init(), StatusOk );
+  ASSERT_EQUAL( system::task::init(), StatusOk );
+  ASSERT_EQUAL( initializeLoadScheduler(), StatusOk );
+  ASSERT_EQUAL( initializeRenderChunk(), StatusOk );
+
+  auto reads = std::vector<StringId>();
+  setRenderChunkReader( [&reads]( StringId id, LoadToken ) -> cti::continuable<schema::Chunk> {
+    reads.push_back( id );
+    if( id == StringId( "failing" ) )
+      return cti::make_exceptional_continuable<schema::Chunk>( StatusBadFile );
+    return cti::make_ready_continuable<schema::Chunk>( schema::Chunk() );
+  } );
+
+  // released chunk stays resident, next request gets it without reading
+  ASSERT_TRUE( loadChunk( "a" ).isLoaded() );
+  updateRenderChunk();
+  ASSERT_EQUAL( getRenderChunkStats().cachedChunks, 1u );
+
+  auto a = loadChunk( "a" );
+  ASSERT_TRUE( a.isLoaded() );
+  ASSERT_EQUAL( countReads( reads, "a" ), 1u );
+  ASSERT_EQUAL( getRenderChunkStats().hits, 1u );
+  ASSERT_EQUAL( getRenderChunkStats().misses, 1u );
+
+  // room for three chunks: a is used, b and c are cached, b is released after c
+  u64 chunkBytes = getRenderChunkStats().residentCpuBytes;
+  setRenderChunkBudget( { .cpuBytes = chunkBytes * 3 } );
+
+  loadChunk( "b" );
+  updateRenderChunk();
+  loadChunk( "c" );
+  updateRenderChunk();
+  {
+    auto b = loadChunk( "b" );
+    updateRenderChunk();
+  }
+  updateRenderChunk();
+  ASSERT_EQUAL( getRenderChunkStats().residentChunks, 3u );
+  ASSERT_EQUAL( getRenderChunkStats().evictions, 0u );
+
+  // over budget least recently released chunk goes first
+  loadChunk( "d" );
+  updateRenderChunk();
+  ASSERT_EQUAL( getRenderChunkStats().evictions, 1u );
+  ASSERT_EQUAL( getRenderChunkStats().residentChunks, 3u );
+
+  loadChunk( "b" );
+  loadChunk( "c" );
+  ASSERT_EQUAL( countReads( reads, "b" ), 1u );
+  ASSERT_EQUAL( countReads( reads, "c" ), 2u );
+  ASSERT_TRUE( a.isLoaded() );
+
+  // failed chunk is not loaded for its holder and is not cached: next request reads it again
+  auto failing = loadChunk( "failing" );
+  system::task::update(); // read failure comes to main thread as deferred task
+  ASSERT_FALSE( failing.isLoaded() );
+
+  auto failedStatus = StatusOk;
+  RenderChunk::loadCti( StringId( "failing" ), LoadToken( LoadPriority_Blocking ) ).fail( [&failedStatus]( Status s ) {
+    failedStatus = s;
+  } );
+  system::task::update();
+  ASSERT_EQUAL( failedStatus, StatusBadFile );
+  ASSERT_EQUAL( countReads( reads, "failing" ), 2u );
+
+  a       = RenderChunk();
+  failing = RenderChunk();
+  updateRenderChunk();
+
+  destroyRenderChunk();
+  destroyLoadScheduler();
+  system::task::destroy();
+  system::frame::destroy();
+}
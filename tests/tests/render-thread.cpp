@@ -0,0 +1,145 @@
+#include "unit_test_framework/unit_test_framework.hpp"
+#include "core/data/load-scheduler.hpp"
+#include "core/render/render-thread.hpp"
+#include "core/system/frame-allocator.hpp"
+#include "core/system/task.hpp"
+
+using namespace core;
+using namespace core::render;
+
+namespace
+{
+  constexpr u32 sFrameCount = 50;
+
+  // released by destroyDeferred, logs on which step it happened
+  struct Resource
+  {
+    u32                       frame;
+    std::vector<std::string>* log;
+
+    ~Resource() { log->push_back( "destroy " + std::to_string( frame ) ); }
+  };
+
+  // gpu object made by upload, remembers thread which released it
+  struct Upload
+  {
+    std::atomic<std::thread::id>* releasedOn;
+
+    ~Upload() { releasedOn->store( std::this_thread::get_id() ); }
+  };
+} // namespace
+
+TEST( render_thread )
+{
+  ASSERT_EQUAL( system::frame::init(), StatusOk );
+  ASSERT_EQUAL( initRenderThread(), StatusOk );
+
+  auto log        = std::vector<std::string>(); // written by render thread until it is stopped
+  auto building   = std::atomic<u32>( 0 );      // frame main thread builds now
+  u32  overlapped = 0;
+
+  auto status = startRenderThread( [&log, &building, &overlapped]( RenderList& list ) {
+    auto frame = static_cast<u32>( list.viewPosition.x );
+    log.push_back( "submit " + std::to_string( frame ) + " lines " + std::to_string( list.lines.size() ) );
+
+    // main thread must go on with next frame while this one is submitted
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds( 5 );
+    while( building.load() <= frame && std::chrono::steady_clock::now() < deadline )
+      std::this_thread::yield();
+    overlapped += building.load() > frame ? 1 : 0;
+  } );
+  ASSERT_EQUAL( status, StatusOk );
+
+  auto expected = std::vector<std::string>();
+  for( u32 frame = 0; frame < sFrameCount; ++frame )
+  {
+    // list comes back cleared after render thread is done with it
+    auto& list = getBuildingRenderList();
+    ASSERT_TRUE( list.lines.empty() );
+    list.viewPosition = Vec3( static_cast<f32>( frame ), 0, 0 );
+    for( u32 i = 0; i < frame % 4; ++i )
+    {
+      list.lines.push_back( RenderList::Point{} );
+      list.lines.push_back( RenderList::Point{} );
+    }
+
+    runOnRenderThread( [&log, frame]() { log.push_back( "command " + std::to_string( frame ) ); } );
+    destroyDeferred( std::unique_ptr<Resource>( new Resource{ .frame = frame, .log = &log } ) );
+    publishRenderList();
+    building.store( frame + 1 );
+    system::frame::frameEnd();
+
+    // command goes before list which was built with it, resource outlives it
+    expected.push_back( "command " + std::to_string( frame ) );
+    expected.push_back( "submit " + std::to_string( frame ) + " lines " + std::to_string( frame % 4 * 2 ) );
+    expected.push_back( "destroy " + std::to_string( frame ) );
+  }
+
+  stopRenderThread();
+  ASSERT_SEQUENCE_EQUAL( log, expected );
+  ASSERT_EQUAL( overlapped, sFrameCount );
+
+  // without render thread nothing would run command, so resource is released right away
+  destroyDeferred( std::unique_ptr<Resource>( new Resource{ .frame = sFrameCount, .log = &log } ) );
+  ASSERT_EQUAL( log.back(), "destroy " + std::to_string( sFrameCount ) );
+
+  system::frame::destroy();
+}
+
+
+// upload of chunk load: made on render thread, main thread takes it. if load was cancelled meanwhile,
+// upload goes back to render thread to be released, device context is not touched from main thread
+TEST( render_thread_cancelled_upload )
+{
+  ASSERT_EQUAL( system::frame::init(), StatusOk );
+  ASSERT_EQUAL( system::task::init(), StatusOk );
+  ASSERT_EQUAL( initRenderThread(), StatusOk );
+  ASSERT_EQUAL( startRenderThread( []( RenderList& ) {} ), StatusOk );
+
+  auto renderThread = std::atomic<std::thread::id>();
+  auto releasedOn   = std::atomic<std::thread::id>();
+  auto uploaded     = std::atomic<bool>( false );
+  auto status       = StatusOk;
+  auto token        = data::LoadToken( data::LoadPriority_Blocking );
+
+  ctiRenderThread( [&renderThread, &releasedOn, &uploaded]() -> std::expected<std::unique_ptr<Upload>, Status> {
+    renderThread.store( std::this_thread::get_id() );
+    auto upload = std::unique_ptr<Upload>( new Upload{ .releasedOn = &releasedOn } );
+
+    // load is cancelled while upload is in flight
+    uploaded.store( true );
+    return upload;
+  } )
+      .then( [token]( std::unique_ptr<Upload> upload ) {
+        return system::task::ctiDeffered( [upload = std::move( upload ), token]() mutable -> std::expected<None, Status> {
+          if( token.isCancelled() )
+          {
+            destroyDeferred( std::move( upload ) );
+            return std::unexpected( StatusCancelled );
+          }
+          return None();
+        } );
+      } )
+      .fail( [&status]( Status s ) { status = s; } );
+
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds( 5 );
+  while( !uploaded.load() && std::chrono::steady_clock::now() < deadline )
+    std::this_thread::yield();
+  token.cancel();
+
+  while( status == StatusOk && std::chrono::steady_clock::now() < deadline )
+  {
+    system::task::update();
+    std::this_thread::yield();
+  }
+  ASSERT_EQUAL( status, StatusCancelled );
+
+  publishRenderList();
+  system::frame::frameEnd();
+  stopRenderThread();
+  ASSERT_TRUE( releasedOn.load() == renderThread.load() );
+  ASSERT_FALSE( releasedOn.load() == std::this_thread::get_id() );
+
+  system::task::destroy();
+  system::frame::destroy();
+}
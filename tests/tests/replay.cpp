@@ -0,0 +1,70 @@
+#include "unit_test_framework/unit_test_framework.hpp"
+#include "core/input/input.hpp"
+#include "core/input/replay.hpp"
+#include "core/system/frame-report.hpp"
+
+using namespace core;
+
+namespace
+{
+  SDL_Event makeKeyEvent( Uint32 type, SDL_Keycode key )
+  {
+    auto e           = SDL_Event{};
+    e.type           = type;
+    e.key.keysym.sym = key;
+    return e;
+  }
+} // namespace
+
+TEST( frame_percentiles )
+{
+  auto values = std::vector<f32>();
+  for( u32 i = 100; i > 0; --i )
+    values.push_back( static_cast<f32>( i ) );
+
+  auto percentiles = system::computePercentiles( values );
+  ASSERT_EQUAL( percentiles.p50, 50.f );
+  ASSERT_EQUAL( percentiles.p95, 95.f );
+  ASSERT_EQUAL( percentiles.p99, 99.f );
+  ASSERT_EQUAL( percentiles.max, 100.f );
+  ASSERT_EQUAL( system::computePercentiles( {} ).max, 0.f );
+}
+
+TEST( input_replay )
+{
+  auto path = ( stdfs::temp_directory_path() / "core-tests-input.replay" ).string();
+  ASSERT_EQUAL( input::init(), StatusOk );
+
+  // frame 0: w pressed with 20ms delta time, frame 1: nothing with 30ms
+  auto dt = system::DeltaTime();
+  ASSERT_EQUAL( input::startRecording(), StatusOk );
+  auto keyDown = makeKeyEvent( SDL_KEYDOWN, SDLK_w );
+  input::handle( keyDown );
+  dt.setUs( 20'000 );
+  input::replayFrameBegin( dt );
+  dt.setUs( 30'000 );
+  input::replayFrameBegin( dt );
+  ASSERT_EQUAL( input::stopRecording( path.c_str() ), StatusOk );
+
+  input::destroy();
+  ASSERT_EQUAL( input::init(), StatusOk );
+  ASSERT_EQUAL( input::startReplay( path.c_str() ), StatusOk );
+  ASSERT_EQUAL( input::getReplayFrameCount(), 2u );
+
+  // live input doesn't get through while replay plays
+  auto keyUp = makeKeyEvent( SDL_KEYUP, SDLK_w );
+  input::preUpdate();
+  input::handle( keyUp );
+  input::replayFrameBegin( dt );
+  ASSERT_TRUE( input::isKeyDown( input::KeyW ) );
+  ASSERT_EQUAL( dt.getUs(), 20'000u );
+
+  input::preUpdate();
+  input::replayFrameBegin( dt );
+  ASSERT_TRUE( input::isKeyPressed( input::KeyW ) );
+  ASSERT_EQUAL( dt.getUs(), 30'000u );
+  ASSERT_TRUE( !input::isReplaying() );
+
+  input::destroy();
+  stdfs::remove( path );
+}